@@ -1,5 +1,5 @@
-
 #include <rxcpp/rx-lite.hpp>
+#include <rxcpp/operators/rx-observe_on.hpp>
 #include <rxcpp/operators/rx-take.hpp>
 
 #include <rxcpp/rx-coroutine.hpp>
@@ -8,51 +8,63 @@ using namespace rxcpp;
 using namespace rxcpp::sources;
 using namespace rxcpp::operators;
 using namespace rxcpp::util;
+using namespace rxcpp::coroutine;
 
 using namespace std;
 using namespace std::chrono;
 
-future<void> intervals(){
+task<int> intervals(){
 
     {
         printf("early exit from interval on thread\n");
-        for co_await (auto c : interval(seconds(1), observe_on_event_loop())) {
-            printf("%d\n", c);
-            break;
-        }
+        auto values = coroutine::values(interval(seconds(1), observe_on_event_loop()));
+        auto c = co_await values.next();
+        printf("%d\n", static_cast<int>(c.get()));
     }
 
     {
         printf("interval on thread\n");
-        for co_await (auto c : interval(seconds(1), observe_on_event_loop()) | take(3)) {
-            printf("%d\n", c);
+        auto values = coroutine::values(interval(seconds(1), observe_on_event_loop()) | take(3));
+        for (auto c = co_await values.next(); !c.empty(); c = co_await values.next()) {
+            printf("%d\n", static_cast<int>(c.get()));
         }
     }
 
     {
         printf("current thread\n");
-        int last = 0;
-        for co_await (auto c : range(1, 100000)) {
-            last = c;
+        auto last = co_await completion(range(1, 100000));
+        printf("reached %d\n", last.get());
+    }
+
+    {
+        printf("generator on a worker\n");
+        auto worker = rxsc::make_new_thread().create_worker();
+        auto squares = from_generator([=]() -> generator<int> {
+            co_await worker;
+            for (int i = 1; i != 4; ++i) {
+                co_yield i * i;
+            }
+        });
+        auto values = coroutine::values(squares);
+        for (auto c = co_await values.next(); !c.empty(); c = co_await values.next()) {
+            printf("%d\n", c.get());
         }
-        printf("reached %d\n", last);
     }
 
     try {
         printf("error in observable\n");
-        for co_await (auto c : error<long>(runtime_error("stopped by error"))) {
-            printf("%d\n", c);
-        }
+        co_await completion(error<long>(runtime_error("stopped by error")));
         printf("not reachable\n");
         terminate();
     }
     catch(const exception& e) {
         printf("%s\n", e.what());
     }
+    co_return 0;
 }
 
 int main()
 {
-    intervals().get();
+    from_task(intervals).as_blocking().subscribe();
     return 0;
 }
@@ -13,3 +13,13 @@ SCENARIO("distinct sample"){
     printf("//! [distinct sample]\n");
 }
 
+
+SCENARIO("distinct capacity sample"){
+    printf("//! [distinct capacity sample]\n");
+    auto values = rxcpp::observable<>::from(1, 2, 1, 3, 2, 1, 4, 3).distinct(2);
+    values.
+        subscribe(
+            [](int v){printf("OnNext: %d\n", v);},
+            [](){printf("OnCompleted\n");});
+    printf("//! [distinct capacity sample]\n");
+}
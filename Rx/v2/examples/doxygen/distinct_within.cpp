@@ -0,0 +1,19 @@
+#include "rxcpp/rx.hpp"
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("distinct_within sample"){
+    printf("//! [distinct_within sample]\n");
+    using namespace std::chrono;
+    auto values = rxcpp::observable<>::interval(milliseconds(10)).
+        map([](long v){ return v % 3; }).
+        take(9).
+        distinct_within(milliseconds(45));
+    values.
+        as_blocking().
+        subscribe(
+            [](long v){printf("OnNext: %ld\n", v);},
+            [](){printf("OnCompleted\n");});
+    printf("//! [distinct_within sample]\n");
+}
@@ -0,0 +1,36 @@
+#include "rxcpp/rx.hpp"
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+#if defined(RXCPP_ON_LINUX)
+
+SCENARIO("from_fd sample"){
+    printf("//! [from_fd sample]\n");
+    int fds[2];
+    if (::pipe(fds) != 0) {
+        return;
+    }
+    std::thread writer([&](){
+        const char text[] = "one two three";
+        if (::write(fds[1], text, sizeof(text) - 1) < 0) {
+            printf("write failed\n");
+        }
+        ::close(fds[1]);
+    });
+    auto reactor = rxcpp::schedulers::make_epoll_reactor();
+    auto values = rxcpp::sources::from_fd(fds[0], 8, reactor).
+        map([](const rxcpp::util::pooled_buffer<std::uint8_t>& b){
+            return std::string(b.begin(), b.end());
+        });
+    values.
+        as_blocking().
+        subscribe(
+            [](const std::string& s){printf("OnNext: '%s'\n", s.c_str());},
+            [](){printf("OnCompleted\n");});
+    writer.join();
+    ::close(fds[0]);
+    printf("//! [from_fd sample]\n");
+}
+
+#endif
@@ -0,0 +1,20 @@
+#include "rxcpp/rx.hpp"
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("join sample"){
+    printf("//! [join sample]\n");
+    using namespace std::chrono;
+    auto orders = rxcpp::observable<>::from(1, 2, 3);
+    auto fills = rxcpp::observable<>::from(21, 32, 11, 22);
+    auto values = orders.join(fills,
+        [](int order){ return order; },
+        [](int fill){ return fill / 10; },
+        seconds(1));
+    values.
+        subscribe(
+            [](std::tuple<int, int> v){printf("OnNext: %d, %d\n", std::get<0>(v), std::get<1>(v));},
+            [](){printf("OnCompleted\n");});
+    printf("//! [join sample]\n");
+}
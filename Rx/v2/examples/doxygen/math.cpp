@@ -135,6 +135,16 @@ SCENARIO("sum error sample"){
     printf("//! [sum error sample]\n");
 }
 
+SCENARIO("sum_all sample"){
+    printf("//! [sum_all sample]\n");
+    auto values = rxcpp::observable<>::range(1, 10).buffer(4).sum_all();
+    values.
+        subscribe(
+            [](int v){printf("OnNext: %d\n", v);},
+            [](){printf("OnCompleted\n");});
+    printf("//! [sum_all sample]\n");
+}
+
 SCENARIO("average sample"){
     printf("//! [average sample]\n");
     auto values = rxcpp::observable<>::range(1, 4).average();
@@ -0,0 +1,31 @@
+#include "rxcpp/rx.hpp"
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+#if defined(RXCPP_ON_LINUX)
+
+SCENARIO("mmap_file sample"){
+    printf("//! [mmap_file sample]\n");
+    char path[] = "/tmp/mmap_file-sample-XXXXXX";
+    int fd = ::mkstemp(path);
+    const char text[] = "first\nsecond\nthird\n";
+    if (fd < 0 || ::write(fd, text, sizeof(text) - 1) < 0) {
+        return;
+    }
+    ::close(fd);
+    auto values = rxcpp::sources::mmap_file(path, 8);
+    values.
+        subscribe(
+            [](const rxcpp::util::shared_view& v){printf("OnNext: %d bytes\n", static_cast<int>(v.size()));},
+            [](){printf("OnCompleted\n");});
+    values.
+        split_lines().
+        subscribe(
+            [](const rxcpp::util::shared_view& v){printf("OnNext: '%s'\n", v.str().c_str());},
+            [](){printf("OnCompleted\n");});
+    ::unlink(path);
+    printf("//! [mmap_file sample]\n");
+}
+
+#endif
@@ -0,0 +1,17 @@
+#include "rxcpp/rx.hpp"
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("ordered_merge sample"){
+    printf("//! [ordered_merge sample]\n");
+    auto o1 = rxcpp::observable<>::from(1, 4, 7);
+    auto o2 = rxcpp::observable<>::from(2, 5, 8);
+    auto o3 = rxcpp::observable<>::from(3, 6, 9);
+    auto values = o1.ordered_merge([](int v){return v;}, std::less<int>(), o2, o3);
+    values.
+        subscribe(
+            [](int v){printf("OnNext: %d\n", v);},
+            [](){printf("OnCompleted\n");});
+    printf("//! [ordered_merge sample]\n");
+}
@@ -0,0 +1,25 @@
+#include "rxcpp/rx.hpp"
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("parallel_reduce sample"){
+    printf("//! [parallel_reduce sample]\n");
+    auto values = rxcpp::observable<>::range(1, 10000).
+        parallel_reduce(
+            0LL,
+            [](long long sum, int v){
+                return sum + v;
+            },
+            [](long long a, long long b){
+                return a + b;
+            },
+            rxcpp::observe_on_event_loop(),
+            1000);
+    values.
+        as_blocking().
+        subscribe(
+            [](long long v){printf("OnNext: %lld\n", v);},
+            [](){printf("OnCompleted\n");});
+    printf("//! [parallel_reduce sample]\n");
+}
@@ -0,0 +1,16 @@
+#include "rxcpp/rx.hpp"
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("parallel_scan sample"){
+    printf("//! [parallel_scan sample]\n");
+    auto values = rxcpp::observable<>::range(1, 7).
+        parallel_scan(0, std::plus<int>(), std::plus<int>(), rxcpp::observe_on_event_loop(), 3);
+    values.
+        as_blocking().
+        subscribe(
+            [](int v){printf("OnNext: %d\n", v);},
+            [](){printf("OnCompleted\n");});
+    printf("//! [parallel_scan sample]\n");
+}
@@ -0,0 +1,20 @@
+#include "rxcpp/rx.hpp"
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("partition sample"){
+    printf("//! [partition sample]\n");
+    auto values = rxcpp::observable<>::range(1, 6).
+        partition(2, [](int v){ return v; }).
+        map([](rxcpp::grouped_observable<std::size_t, int> shard){
+            auto key = shard.get_key();
+            return shard.sum().map([key](int sum){ return std::make_tuple(key, sum); });
+        }).
+        merge_partitions();
+    values.
+        subscribe(
+            [](std::tuple<std::size_t, int> v){printf("OnNext: shard %d, sum %d\n", static_cast<int>(std::get<0>(v)), std::get<1>(v));},
+            [](){printf("OnCompleted\n");});
+    printf("//! [partition sample]\n");
+}
@@ -0,0 +1,24 @@
+#include "rxcpp/rx.hpp"
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("sliding_aggregate count sample"){
+    printf("//! [sliding_aggregate count sample]\n");
+    auto values = rxcpp::observable<>::range(1, 6).sliding_aggregate(3, 1, rxcpp::sum_monoid<int>());
+    values.
+        subscribe(
+            [](int v){printf("OnNext: %d\n", v);},
+            [](){printf("OnCompleted\n");});
+    printf("//! [sliding_aggregate count sample]\n");
+}
+
+SCENARIO("sliding_aggregate min sample"){
+    printf("//! [sliding_aggregate min sample]\n");
+    auto values = rxcpp::observable<>::from(5, 3, 8, 1, 7, 6).sliding_aggregate(4, 2, rxcpp::min_monoid<int>());
+    values.
+        subscribe(
+            [](int v){printf("OnNext: %d\n", v);},
+            [](){printf("OnCompleted\n");});
+    printf("//! [sliding_aggregate min sample]\n");
+}
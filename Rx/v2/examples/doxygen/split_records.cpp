@@ -0,0 +1,26 @@
+#include "rxcpp/rx.hpp"
+
+#include "rxcpp/rx-test.hpp"
+#include "catch.hpp"
+
+SCENARIO("split_records sample"){
+    printf("//! [split_records sample]\n");
+    auto values = rxcpp::observable<>::from<std::string>("a,b", "c,", "d").
+        split_records(',');
+    values.
+        subscribe(
+            [](const rxcpp::util::shared_view& v){printf("OnNext: '%s'\n", v.str().c_str());},
+            [](){printf("OnCompleted\n");});
+    printf("//! [split_records sample]\n");
+}
+
+SCENARIO("split_lines sample"){
+    printf("//! [split_lines sample]\n");
+    auto values = rxcpp::observable<>::from<std::string>("one\r\ntw", "o\nthree").
+        split_lines();
+    values.
+        subscribe(
+            [](const rxcpp::util::shared_view& v){printf("OnNext: '%s'\n", v.str().c_str());},
+            [](){printf("OnCompleted\n");});
+    printf("//! [split_lines sample]\n");
+}
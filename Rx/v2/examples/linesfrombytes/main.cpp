@@ -22,6 +22,7 @@ using namespace rxcpp::util;
 }
 using namespace Rx;
 
+#include <iterator>
 #include <regex>
 #include <random>
 using namespace std;
@@ -122,7 +122,7 @@ struct amb
         auto coordinator = initial.coordination.create_coordinator(scbr.get_subscription());
 
         // take a copy of the values for each subscription
-        auto state = std::make_shared<amb_state_type>(initial, std::move(coordinator), std::move(scbr));
+        auto state = rxu::make_shared_state<amb_state_type>(initial, std::move(coordinator), std::move(scbr));
 
         composite_subscription outercs;
 
@@ -209,7 +209,7 @@ struct member_overload<contains_tag>
         class Value = rxu::value_type_t<Any>>
     static auto member(Observable&& o, T&& value)
     -> decltype(o.template lift<Value>(Any(nullptr))) {
-        auto valueAsShared = std::make_shared<rxu::decay_t<T>>(std::forward<T>(value));
+        auto valueAsShared = rxu::make_shared_state<rxu::decay_t<T>>(std::forward<T>(value));
         return  o.template lift<Value>(Any([valueAsShared](const rxu::decay_t<T>& n) { return n == *valueAsShared; }));
     }
 
@@ -20,6 +20,10 @@
     \sample
     \snippet buffer.cpp buffer count+skip sample
     \snippet output.txt buffer count+skip sample
+
+    buffer_pooled takes the same arguments and emits rxu::pooled_buffer<T> instead of std::vector<T>.
+    The storage of each pooled_buffer is returned to a pool owned by the subscription when the
+    pooled_buffer is destroyed, so a steady stream of buffers does not allocate.
 */
 
 #if !defined(RXCPP_OPERATORS_RX_BUFFER_COUNT_HPP)
@@ -43,11 +47,46 @@ struct buffer_count_invalid : public rxo::operator_base<buffer_count_invalid_arg
 template<class... AN>
 using buffer_count_invalid_t = typename buffer_count_invalid<AN...>::type;
 
+// makes each new buffer with the capacity for count items
+template<class T>
+struct buffer_count_vectors
+{
+    using value_type = std::vector<T>;
+
+    explicit buffer_count_vectors(int count)
+        : count(count)
+    {
+    }
+    value_type make() const {
+        value_type result;
+        result.reserve(count);
+        return result;
+    }
+    int count;
+};
+
+// takes each new buffer from a pool that recycles the storage of released buffers
 template<class T>
+struct buffer_count_pooled
+{
+    using value_type = rxu::pooled_buffer<T>;
+
+    explicit buffer_count_pooled(int count)
+        : pool(rxu::make_shared_state<rxu::buffer_pool<T>>(count))
+    {
+    }
+    value_type make() const {
+        return value_type(pool);
+    }
+    std::shared_ptr<rxu::buffer_pool<T>> pool;
+};
+
+template<class T, class Buffers = buffer_count_vectors<rxu::decay_t<T>>>
 struct buffer_count
 {
     using source_value_type = rxu::decay_t<T>;
-    using value_type = std::vector<source_value_type>;
+    using buffers_type = Buffers;
+    using value_type = typename buffers_type::value_type;
 
     struct buffer_count_values
     {
@@ -71,28 +110,71 @@ struct buffer_count
     struct buffer_count_observer : public buffer_count_values
     {
         using this_type = buffer_count_observer<Subscriber>;
-        using value_type = std::vector<T>;
+        using value_type = typename buffers_type::value_type;
         using dest_type = rxu::decay_t<Subscriber>;
         using observer_type = observer<value_type, this_type>;
         dest_type dest;
+        buffers_type buffers;
         mutable int cursor;
+        // the open buffer when skip == count
+        mutable rxu::maybe<value_type> chunk;
+        // the open buffers when skip != count
         mutable std::deque<value_type> chunks;
 
         buffer_count_observer(dest_type d, buffer_count_values v)
             : buffer_count_values(v)
             , dest(std::move(d))
+            , buffers(v.count)
             , cursor(0)
         {
         }
 
         void on_next(const T& v) const {
+            if (this->skip == this->count) {
+                if (chunk.empty()) {
+                    chunk.reset(buffers.make());
+                }
+                chunk->push_back(v);
+                emit_full_chunk();
+                return;
+            }
             if (cursor++ % this->skip == 0) {
-                chunks.emplace_back();
-                chunks.back().reserve(this->count);
+                chunks.emplace_back(buffers.make());
             }
             for(auto& chunk : chunks) {
                 chunk.push_back(v);
             }
+            emit_full_chunks();
+        }
+        // the last open chunk gets the value moved into it
+        void on_next(T&& v) const {
+            if (this->skip == this->count) {
+                if (chunk.empty()) {
+                    chunk.reset(buffers.make());
+                }
+                chunk->push_back(std::move(v));
+                emit_full_chunk();
+                return;
+            }
+            if (cursor++ % this->skip == 0) {
+                chunks.emplace_back(buffers.make());
+            }
+            if (!chunks.empty()) {
+                auto last = chunks.end() - 1;
+                for (auto it = chunks.begin(); it != last; ++it) {
+                    it->push_back(static_cast<const T&>(v));
+                }
+                last->push_back(std::move(v));
+            }
+            emit_full_chunks();
+        }
+        void emit_full_chunk() const {
+            if (int(chunk->size()) == this->count) {
+                dest.on_next(std::move(*chunk));
+                chunk.reset();
+            }
+        }
+        void emit_full_chunks() const {
             while (!chunks.empty() && int(chunks.front().size()) == this->count) {
                 dest.on_next(std::move(chunks.front()));
                 chunks.pop_front();
@@ -104,6 +186,10 @@ struct buffer_count
         void on_completed() const {
             auto done = on_exception(
                 [&](){
+                    if (!chunk.empty()) {
+                        dest.on_next(std::move(*chunk));
+                        chunk.reset();
+                    }
                     while (!chunks.empty()) {
                         dest.on_next(std::move(chunks.front()));
                         chunks.pop_front();
@@ -140,6 +226,14 @@ auto buffer(AN&&... an)
      return operator_factory<buffer_count_tag, AN...>(std::make_tuple(std::forward<AN>(an)...));
 }
 
+/*! @copydoc rx-buffer_count.hpp
+*/
+template<class... AN>
+auto buffer_pooled(AN&&... an)
+    ->      operator_factory<buffer_pooled_tag, AN...> {
+     return operator_factory<buffer_pooled_tag, AN...>(std::make_tuple(std::forward<AN>(an)...));
+}
+
 }
 
 template<>
@@ -175,6 +269,39 @@ struct member_overload<buffer_count_tag>
     }
 };
 
+template<>
+struct member_overload<buffer_pooled_tag>
+{
+    template<class Observable,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class BufferCount = rxo::detail::buffer_count<SourceValue, rxo::detail::buffer_count_pooled<SourceValue>>,
+        class Value = rxu::value_type_t<BufferCount>>
+    static auto member(Observable&& o, int count, int skip)
+        -> decltype(o.template lift<Value>(BufferCount(count, skip))) {
+        return      o.template lift<Value>(BufferCount(count, skip));
+    }
+
+    template<class Observable,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class BufferCount = rxo::detail::buffer_count<SourceValue, rxo::detail::buffer_count_pooled<SourceValue>>,
+        class Value = rxu::value_type_t<BufferCount>>
+    static auto member(Observable&& o, int count)
+        -> decltype(o.template lift<Value>(BufferCount(count, count))) {
+        return      o.template lift<Value>(BufferCount(count, count));
+    }
+
+    template<class... AN>
+    static operators::detail::buffer_count_invalid_t<AN...> member(AN...) {
+        std::terminate();
+        return {};
+        static_assert(sizeof...(AN) == 10000, "buffer_pooled takes (Count, optional Skip)");
+    }
+};
+
 }
 
 #endif
@@ -120,7 +120,7 @@ struct buffer_with_time
         std::shared_ptr<buffer_with_time_subscriber_values> state;
 
         buffer_with_time_observer(composite_subscription cs, dest_type d, buffer_with_time_values v, coordinator_type c)
-            : state(std::make_shared<buffer_with_time_subscriber_values>(buffer_with_time_subscriber_values(std::move(cs), std::move(d), v, std::move(c))))
+            : state(rxu::make_shared_state<buffer_with_time_subscriber_values>(buffer_with_time_subscriber_values(std::move(cs), std::move(d), v, std::move(c))))
         {
             auto localState = state;
 
@@ -182,20 +182,26 @@ struct buffer_with_time
                     localState->worker.schedule(selectedCreate.get());
                 });
         }
-        void on_next(const T& v) const {
+        void on_next(T v) const {
             auto localState = state;
-            auto work = [v, localState](const rxsc::schedulable&){
-                for(auto& chunk : localState->chunks) {
-                    chunk.push_back(v);
+            auto work = [v = std::move(v), localState](const rxsc::schedulable&) mutable {
+                if (localState->chunks.empty()) {
+                    return;
                 }
+                // copy into all but the newest chunk, which takes the value
+                auto last = std::prev(localState->chunks.end());
+                for(auto chunk = localState->chunks.begin(); chunk != last; ++chunk) {
+                    chunk->push_back(v);
+                }
+                last->push_back(std::move(v));
             };
             auto selectedWork = on_exception(
-                [&](){return localState->coordinator.act(work);},
+                [&](){return localState->coordinator.act(std::move(work));},
                 localState->dest);
             if (selectedWork.empty()) {
                 return;
             }
-            localState->worker.schedule(selectedWork.get());
+            localState->worker.schedule(std::move(selectedWork.get()));
         }
         void on_error(rxu::error_ptr e) const {
             auto localState = state;
@@ -81,6 +81,9 @@ struct buffer_with_time_or_count
         using dest_type = rxu::decay_t<Subscriber>;
         using observer_type = observer<value_type, this_type>;
 
+        // the most items reserved when a buffer is started
+        static const int max_reserve = 1024;
+
         struct buffer_with_time_or_count_subscriber_values : public buffer_with_time_or_count_values
         {
             buffer_with_time_or_count_subscriber_values(composite_subscription cs, dest_type d, buffer_with_time_or_count_values v, coordinator_type c)
@@ -104,7 +107,7 @@ struct buffer_with_time_or_count
         state_type state;
 
         buffer_with_time_or_count_observer(composite_subscription cs, dest_type d, buffer_with_time_or_count_values v, coordinator_type c)
-            : state(std::make_shared<buffer_with_time_or_count_subscriber_values>(buffer_with_time_or_count_subscriber_values(std::move(cs), std::move(d), std::move(v), std::move(c))))
+            : state(rxu::make_shared_state<buffer_with_time_or_count_subscriber_values>(buffer_with_time_or_count_subscriber_values(std::move(cs), std::move(d), std::move(v), std::move(c))))
         {
             auto new_id = state->chunk_id;
             auto produce_time = state->worker.now() + state->period;
@@ -145,8 +148,10 @@ struct buffer_with_time_or_count
                 if (id != state->chunk_id)
                     return;
 
-                state->dest.on_next(state->chunk);
-                state->chunk.resize(0);
+                // the emitted buffer is moved out, the next one is
+                // allocated by its first item
+                state->dest.on_next(std::move(state->chunk));
+                state->chunk = value_type();
                 auto new_id = ++state->chunk_id;
                 auto produce_time = expected + state->period;
                 state->worker.schedule(produce_time, [new_id, produce_time, state](const rxsc::schedulable&){
@@ -164,21 +169,25 @@ struct buffer_with_time_or_count
             return std::function<void(const rxsc::schedulable&)>(selectedProduce.get());
         }
 
-        void on_next(const T& v) const {
+        void on_next(T v) const {
             auto localState = state;
-            auto work = [v, localState](const rxsc::schedulable& self){
-                localState->chunk.push_back(v);
+            auto work = [v = std::move(v), localState](const rxsc::schedulable& self) mutable {
+                if (localState->chunk.capacity() == 0) {
+                    // count may be a large cap that is rarely reached
+                    localState->chunk.reserve(std::min(localState->count, int(max_reserve)));
+                }
+                localState->chunk.push_back(std::move(v));
                 if (int(localState->chunk.size()) == localState->count) {
                     produce_buffer(localState->chunk_id, localState->worker.now(), localState)(self);
                 }
             };
             auto selectedWork = on_exception(
-                [&](){return localState->coordinator.act(work);},
+                [&](){return localState->coordinator.act(std::move(work));},
                 localState->dest);
             if (selectedWork.empty()) {
                 return;
             }
-            localState->worker.schedule(selectedWork.get());
+            localState->worker.schedule(std::move(selectedWork.get()));
         }
         void on_error(rxu::error_ptr e) const {
             auto localState = state;
@@ -196,7 +205,7 @@ struct buffer_with_time_or_count
         void on_completed() const {
             auto localState = state;
             auto work = [localState](const rxsc::schedulable&){
-                localState->dest.on_next(localState->chunk);
+                localState->dest.on_next(std::move(localState->chunk));
                 localState->dest.on_completed();
             };
             auto selectedWork = on_exception(
@@ -16,6 +16,14 @@
 
     If aggregation function is omitted, the resulting observable returns tuples of emitted items.
 
+    The aggregation function is passed a copy of each latest value. Wrap it in rxu::by_reference()
+    to pass const references to the latest values instead. No lock is taken when the coordination
+    is identity_current_thread or identity_same_worker.
+
+    combine_latest_changed passes the index of the source that emitted as the first argument
+    to the aggregation function, or as the first element of the tuple when it is omitted.
+    The latest values are passed by const reference.
+
     \sample
 
     Neither scheduler nor aggregation function are present:
@@ -71,6 +79,21 @@ struct is_combine_latest_selector_check {
     static const bool value = !std::is_same_v<type, tag_not_valid>;
 };
 
+template<class Selector, class... ObservableN>
+struct is_combine_latest_changed_selector_check {
+    using selector_type = rxu::decay_t<Selector>;
+
+    struct tag_not_valid;
+    template<class CS, class... CON>
+    static auto check(int) -> decltype(std::declval<CS>()(std::declval<std::size_t>(), (std::declval<const typename CON::value_type&>())...));
+    template<class CS, class... CON>
+    static tag_not_valid check(...);
+
+    using type = decltype(check<selector_type, rxu::decay_t<ObservableN>...>(0));
+
+    static const bool value = !std::is_same_v<type, tag_not_valid>;
+};
+
 template<class Selector, class... ObservableN>
 struct invalid_combine_latest_selector {
     static const bool value = false;
@@ -83,9 +106,48 @@ struct is_combine_latest_selector : public std::conditional_t<
     invalid_combine_latest_selector<Selector, ObservableN...>> {
 };
 
+template<class Selector, class... ObservableN>
+struct is_combine_latest_changed_selector : public std::conditional_t<
+    is_combine_latest_changed_selector_check<Selector, ObservableN...>::value,
+    is_combine_latest_changed_selector_check<Selector, ObservableN...>,
+    invalid_combine_latest_selector<Selector, ObservableN...>> {
+};
+
 template<class Selector, class... ON>
 using result_combine_latest_selector_t = typename is_combine_latest_selector<Selector, ON...>::type;
 
+// marks a selector that takes the index of the source that emitted
+template<class Selector>
+struct combine_latest_changed_selector
+{
+    explicit combine_latest_changed_selector(Selector s)
+        : selector(std::move(s))
+    {
+    }
+    Selector selector;
+};
+
+template<class Selector, class... ObservableN>
+struct combine_latest_selector_result : public is_combine_latest_selector<Selector, ObservableN...> {
+};
+
+template<class Selector, class... ObservableN>
+struct combine_latest_selector_result<combine_latest_changed_selector<Selector>, ObservableN...> : public is_combine_latest_changed_selector<Selector, ObservableN...> {
+};
+
+template<class Selector, class Latest>
+auto select_latest(std::size_t, Selector& selector, const Latest& latest) {
+    return rxu::apply_latest(latest, selector);
+}
+
+template<class Selector, class Latest>
+auto select_latest(std::size_t changed, combine_latest_changed_selector<Selector>& changedSelector, const Latest& latest) {
+    auto report = [&](const auto&... vn) {
+        return changedSelector.selector(changed, vn...);
+    };
+    return rxu::apply_surely(latest, report);
+}
+
 template<class Coordination, class Selector, class... ObservableN>
 struct combine_latest_traits {
 
@@ -95,7 +157,7 @@ struct combine_latest_traits {
     using selector_type = rxu::decay_t<Selector>;
     using coordination_type = rxu::decay_t<Coordination>;
 
-    using value_type = typename is_combine_latest_selector<selector_type, ObservableN...>::type;
+    using value_type = typename combine_latest_selector_result<selector_type, ObservableN...>::type;
 };
 
 template<class Coordination, class Selector, class... ObservableN>
@@ -167,8 +229,7 @@ struct combine_latest : public operator_base<rxu::value_type_t<combine_latest_tr
                 value.reset(std::forward<decltype(st)>(st));
 
                 if (state->valuesSet == sizeof... (ObservableN)) {
-                    auto values = rxu::surely(state->latest);
-                    state->out.on_next(rxu::apply(std::move(values), state->selector));
+                    state->out.on_next(select_latest(Index, state->selector, state->latest));
                 }
             },
         // on_error
@@ -227,7 +288,7 @@ struct combine_latest : public operator_base<rxu::value_type_t<combine_latest_tr
         auto coordinator = initial.coordination.create_coordinator(scbr.get_subscription());
 
         // take a copy of the values for each subscription
-        auto state = std::make_shared<combine_latest_state_type>(initial, std::move(coordinator), std::move(scbr));
+        auto state = rxu::make_shared_state<combine_latest_state_type>(initial, std::move(coordinator), std::move(scbr));
 
         subscribe_all(state, typename rxu::values_from<int, sizeof...(ObservableN)>::type());
     }
@@ -243,6 +304,14 @@ auto combine_latest(AN&&... an)
     return operator_factory<combine_latest_tag, AN...>(std::make_tuple(std::forward<AN>(an)...));
 }
 
+/*! @copydoc rx-combine_latest.hpp
+*/
+template<class... AN>
+auto combine_latest_changed(AN&&... an)
+    ->     operator_factory<combine_latest_changed_tag, AN...> {
+    return operator_factory<combine_latest_changed_tag, AN...>(std::make_tuple(std::forward<AN>(an)...));
+}
+
 }
 
 template<> 
@@ -306,6 +375,67 @@ struct member_overload<combine_latest_tag>
     } 
 };
 
+template<>
+struct member_overload<combine_latest_changed_tag>
+{
+    template<class Observable, class... ObservableN, 
+        class Enabled = rxu::enable_if_all_true_type_t<
+            all_observables<Observable, ObservableN...>>,
+        class combine_latest = rxo::detail::combine_latest<identity_one_worker, rxo::detail::combine_latest_changed_selector<rxu::detail::pack>, rxu::decay_t<Observable>, rxu::decay_t<ObservableN>...>,
+        class Value = rxu::value_type_t<combine_latest>,
+        class Result = observable<Value, combine_latest>>
+    static Result member(Observable&& o, ObservableN&&... on)
+    {
+        return Result(combine_latest(identity_current_thread(), rxo::detail::combine_latest_changed_selector<rxu::detail::pack>(rxu::pack()), std::make_tuple(std::forward<Observable>(o), std::forward<ObservableN>(on)...)));
+    }
+
+    template<class Observable, class Selector, class... ObservableN,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            operators::detail::is_combine_latest_changed_selector<Selector, Observable, ObservableN...>,
+            all_observables<Observable, ObservableN...>>,
+        class ResolvedSelector = rxu::decay_t<Selector>,
+        class combine_latest = rxo::detail::combine_latest<identity_one_worker, rxo::detail::combine_latest_changed_selector<ResolvedSelector>, rxu::decay_t<Observable>, rxu::decay_t<ObservableN>...>,
+        class Value = rxu::value_type_t<combine_latest>,
+        class Result = observable<Value, combine_latest>>
+    static Result member(Observable&& o, Selector&& s, ObservableN&&... on)
+    {
+        return Result(combine_latest(identity_current_thread(), rxo::detail::combine_latest_changed_selector<ResolvedSelector>(std::forward<Selector>(s)), std::make_tuple(std::forward<Observable>(o), std::forward<ObservableN>(on)...)));
+    }
+
+    template<class Coordination, class Observable, class... ObservableN, 
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_coordination<Coordination>,
+            all_observables<Observable, ObservableN...>>,
+        class combine_latest = rxo::detail::combine_latest<Coordination, rxo::detail::combine_latest_changed_selector<rxu::detail::pack>, rxu::decay_t<Observable>, rxu::decay_t<ObservableN>...>,
+        class Value = rxu::value_type_t<combine_latest>,
+        class Result = observable<Value, combine_latest>>
+    static Result member(Observable&& o, Coordination&& cn, ObservableN&&... on)
+    {
+        return Result(combine_latest(std::forward<Coordination>(cn), rxo::detail::combine_latest_changed_selector<rxu::detail::pack>(rxu::pack()), std::make_tuple(std::forward<Observable>(o), std::forward<ObservableN>(on)...)));
+    }
+
+    template<class Coordination, class Selector, class Observable, class... ObservableN,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_coordination<Coordination>,
+            operators::detail::is_combine_latest_changed_selector<Selector, Observable, ObservableN...>,
+            all_observables<Observable, ObservableN...>>,
+        class ResolvedSelector = rxu::decay_t<Selector>,
+        class combine_latest = rxo::detail::combine_latest<Coordination, rxo::detail::combine_latest_changed_selector<ResolvedSelector>, rxu::decay_t<Observable>, rxu::decay_t<ObservableN>...>,
+        class Value = rxu::value_type_t<combine_latest>,
+        class Result = observable<Value, combine_latest>>
+    static Result member(Observable&& o, Coordination&& cn, Selector&& s, ObservableN&&... on)
+    {
+        return Result(combine_latest(std::forward<Coordination>(cn), rxo::detail::combine_latest_changed_selector<ResolvedSelector>(std::forward<Selector>(s)), std::make_tuple(std::forward<Observable>(o), std::forward<ObservableN>(on)...)));
+    }
+
+    template<class... AN>
+    static operators::detail::combine_latest_invalid_t<AN...> member(const AN&...) {
+        std::terminate();
+        return {};
+        static_assert(sizeof...(AN) == 10000, "combine_latest_changed takes (optional Coordination, optional Selector, required Observable, optional Observable...), Selector takes (std::size_t, Observable::value_type...)");
+    } 
+};
+
 }
 
 #endif
@@ -177,7 +177,7 @@ struct concat
         auto coordinator = initial.coordination.create_coordinator(scbr.get_subscription());
 
         // take a copy of the values for each subscription
-        auto state = std::make_shared<concat_state_type>(initial, std::move(coordinator), std::move(scbr));
+        auto state = rxu::make_shared_state<concat_state_type>(initial, std::move(coordinator), std::move(scbr));
 
         state->sourceLifetime = composite_subscription();
 
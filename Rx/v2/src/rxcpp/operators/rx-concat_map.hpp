@@ -146,12 +146,12 @@ struct concat_map
 
             void subscribe_to(const source_value_type& st)
             {
-                subscribe_to(std::make_shared<source_value_type>(st));
+                subscribe_to(rxu::make_shared_state<source_value_type>(st));
             }
 
             void subscribe_to(source_value_type&& st)
             {
-                subscribe_to(std::make_shared<source_value_type>(std::move(st)));
+                subscribe_to(rxu::make_shared_state<source_value_type>(std::move(st)));
             }
 
             void subscribe_to(std::shared_ptr<source_value_type>&& st)
@@ -226,7 +226,7 @@ struct concat_map
         auto coordinator = initial.coordination.create_coordinator(scbr.get_subscription());
 
         // take a copy of the values for each subscription
-        auto state = std::make_shared<concat_map_state_type>(initial, std::move(coordinator), std::move(scbr));
+        auto state = rxu::make_shared_state<concat_map_state_type>(initial, std::move(coordinator), std::move(scbr));
 
         state->sourceLifetime = composite_subscription();
 
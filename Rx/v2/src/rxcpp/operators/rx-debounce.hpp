@@ -82,7 +82,6 @@ struct debounce
                 , dest(std::move(d))
                 , coordinator(std::move(c))
                 , worker(coordinator.get_worker())
-                , index(0)
             {
             }
 
@@ -90,7 +89,7 @@ struct debounce
             dest_type dest;
             coordinator_type coordinator;
             rxsc::worker worker;
-            mutable std::size_t index;
+            rxsc::deadline_timer timer;
             mutable rxu::maybe<value_type> value;
         };
 
@@ -98,10 +97,16 @@ struct debounce
         state_type state;
 
         debounce_observer(composite_subscription cs, dest_type d, debounce_values v, coordinator_type c)
-            : state(std::make_shared<debounce_subscriber_values>(debounce_subscriber_values(std::move(cs), std::move(d), v, std::move(c))))
+            : state(rxu::make_shared_state<debounce_subscriber_values>(debounce_subscriber_values(std::move(cs), std::move(d), v, std::move(c))))
         {
             auto localState = state;
 
+            auto selectedProduce = produce_item(localState);
+            if (!selectedProduce) {
+                return;
+            }
+            localState->timer = rxsc::make_deadline_timer(localState->worker, std::move(selectedProduce));
+
             auto disposer = [=](const rxsc::schedulable&){
                 localState->cs.unsubscribe();
                 localState->dest.unsubscribe();
@@ -122,9 +127,12 @@ struct debounce
             });
         }
 
-        static std::function<void(const rxsc::schedulable&)> produce_item(std::size_t id, state_type state) {
-            auto produce = [id, state](const rxsc::schedulable&) {
-                if(id != state->index)
+        static std::function<void(const rxsc::schedulable&)> produce_item(state_type state) {
+            // the timer is owned by the state, do not keep the state alive from the timer
+            std::weak_ptr<debounce_subscriber_values> weakState = state;
+            auto produce = [weakState](const rxsc::schedulable&) {
+                auto state = weakState.lock();
+                if (!state || state->value.empty())
                     return;
 
                 state->dest.on_next(std::move(*state->value));
@@ -143,14 +151,11 @@ struct debounce
 
         template<typename U>
         void on_next(U&& v) const {
-            auto vAsShared = std::make_shared<T>(std::forward<U>(v));
+            auto vAsShared = rxu::make_shared_state<T>(std::forward<U>(v));
             auto localState = state;
             auto work = [vAsShared, localState](const rxsc::schedulable&) {
-                auto new_id = ++localState->index;
-                auto produce_time = localState->worker.now() + localState->period;
-
                 localState->value.reset(std::move(*vAsShared));
-                localState->worker.schedule(produce_time, produce_item(new_id, localState));
+                localState->timer.arm(localState->period);
             };
             auto selectedWork = on_exception(
                 [&](){return localState->coordinator.act(work);},
@@ -164,6 +169,7 @@ struct debounce
         void on_error(rxu::error_ptr e) const {
             auto localState = state;
             auto work = [e, localState](const rxsc::schedulable&) {
+                localState->timer.cancel();
                 localState->dest.on_error(e);
                 localState->value.reset();
             };
@@ -179,6 +185,7 @@ struct debounce
         void on_completed() const {
             auto localState = state;
             auto work = [localState](const rxsc::schedulable&) {
+                localState->timer.cancel();
                 if(!localState->value.empty()) {
                     localState->dest.on_next(*localState->value);
                 }
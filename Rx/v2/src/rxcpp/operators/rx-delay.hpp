@@ -72,6 +72,25 @@ struct delay
         using value_type = rxu::decay_t<T>;
         using dest_type = rxu::decay_t<Subscriber>;
         using observer_type = observer<T, this_type>;
+        using time_point_type = rxsc::scheduler::clock_type::time_point;
+
+        // the period is constant, so due times are in the order that
+        // items arrive. an empty value is the on_completed notification.
+        struct delayed_item
+        {
+            explicit delayed_item(time_point_type w)
+                : when(w)
+            {
+            }
+            template<class U>
+            delayed_item(time_point_type w, U&& v)
+                : when(w)
+            {
+                value.reset(std::forward<U>(v));
+            }
+            time_point_type when;
+            rxu::maybe<value_type> value;
+        };
 
         struct delay_subscriber_values : public delay_values
         {
@@ -81,19 +100,23 @@ struct delay
                 , dest(std::move(d))
                 , coordinator(std::move(c))
                 , worker(coordinator.get_worker())
-                , expected(worker.now())
+                , armed(false)
             {
             }
             composite_subscription cs;
             dest_type dest;
             coordinator_type coordinator;
             rxsc::worker worker;
-            rxsc::scheduler::clock_type::time_point expected;
+            rxsc::schedulable drainer;
+            mutable std::mutex lock;
+            mutable std::deque<delayed_item> queue;
+            mutable bool armed;
         };
-        std::shared_ptr<delay_subscriber_values> state;
+        using state_type = std::shared_ptr<delay_subscriber_values>;
+        state_type state;
 
         delay_observer(composite_subscription cs, dest_type d, delay_values v, coordinator_type c)
-            : state(std::make_shared<delay_subscriber_values>(delay_subscriber_values(std::move(cs), std::move(d), v, std::move(c))))
+            : state(rxu::make_shared_state<delay_subscriber_values>(std::move(cs), std::move(d), v, std::move(c)))
         {
             auto localState = state;
 
@@ -115,22 +138,71 @@ struct delay
             localState->cs.add([=](){
                 localState->worker.schedule(localState->worker.now() + localState->period, selectedDisposer.get());
             });
-        }
 
-        template<typename U>
-        void on_next(U&& v) const {
-            auto localState = state;
-            auto vAsShared  = std::make_shared<T>(std::forward<U>(v));
-            auto work = [vAsShared, localState](const rxsc::schedulable&){
-                localState->dest.on_next(std::move(*vAsShared));
+            // the queue holds the delayed items and this one
+            // action drains it, so at most one timed action
+            // is scheduled at a time.
+            std::weak_ptr<delay_subscriber_values> weakState = localState;
+            auto drain = [weakState](const rxsc::schedulable& self){
+                auto localState = weakState.lock();
+                if (!localState) {
+                    return;
+                }
+                for (;;) {
+                    delayed_item* front = nullptr;
+                    {
+                        std::unique_lock<std::mutex> guard(localState->lock);
+                        if (localState->queue.empty()) {
+                            localState->armed = false;
+                            return;
+                        }
+                        front = std::addressof(localState->queue.front());
+                        if (front->when > localState->worker.now()) {
+                            auto next = front->when;
+                            guard.unlock();
+                            self.schedule(next);
+                            return;
+                        }
+                    }
+                    // only this action pops and deque::emplace_back does
+                    // not invalidate references, so front is stable while
+                    // it is emitted outside the lock.
+                    if (front->value.empty()) {
+                        localState->dest.on_completed();
+                        return;
+                    }
+                    localState->dest.on_next(std::move(*front->value));
+                    std::unique_lock<std::mutex> guard(localState->lock);
+                    localState->queue.pop_front();
+                }
             };
-            auto selectedWork = on_exception(
-                [&](){return localState->coordinator.act(work);},
+            auto selectedDrain = on_exception(
+                [&](){return localState->coordinator.act(drain);},
                 localState->dest);
-            if (selectedWork.empty()) {
+            if (selectedDrain.empty()) {
                 return;
             }
-            localState->worker.schedule(localState->worker.now() + localState->period, selectedWork.get());
+            localState->drainer = rxsc::make_schedulable(localState->worker, selectedDrain.get());
+        }
+
+        template<class... VN>
+        static void push(const state_type& localState, VN&&... vn) {
+            auto when = localState->worker.now() + localState->period;
+            bool arm = false;
+            {
+                std::unique_lock<std::mutex> guard(localState->lock);
+                localState->queue.emplace_back(when, std::forward<VN>(vn)...);
+                arm = !localState->armed;
+                localState->armed = true;
+            }
+            if (arm) {
+                localState->worker.schedule(when, localState->drainer);
+            }
+        }
+
+        template<typename U>
+        void on_next(U&& v) const {
+            push(state, std::forward<U>(v));
         }
 
         void on_error(rxu::error_ptr e) const {
@@ -148,17 +220,7 @@ struct delay
         }
 
         void on_completed() const {
-            auto localState = state;
-            auto work = [localState](const rxsc::schedulable&){
-                localState->dest.on_completed();
-            };
-            auto selectedWork = on_exception(
-                [&](){return localState->coordinator.act(work);},
-                localState->dest);
-            if (selectedWork.empty()) {
-                return;
-            }
-            localState->worker.schedule(localState->worker.now() + localState->period, selectedWork.get());
+            push(state);
         }
 
         static subscriber<T, observer_type> make(dest_type d, delay_values v) {
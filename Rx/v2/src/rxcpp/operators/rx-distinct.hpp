@@ -6,13 +6,23 @@
 
     \brief For each item from this observable, filter out repeated values and emit only items that have not already been emitted.
 
+    \tparam Count  the type of the number of values to remember (optional).
+
+    \param capacity  the number of values to remember (optional). When it is given, the values that were seen least recently are forgotten and can be emitted again.
+
     \return Observable that emits those items from the source observable that are distinct.
 
-    \note istinct keeps an unordered_set<T> of past values. Due to an issue in multiple implementations of std::hash<T>, rxcpp maintains a whitelist of hashable types. new types can be added by specializing rxcpp::filtered_hash<T>
+    \note distinct keeps an unordered_set<T> of past values. Due to an issue in multiple implementations of std::hash<T>, rxcpp maintains a whitelist of hashable types. new types can be added by specializing rxcpp::filtered_hash<T>
+
+    \note without a capacity the set of past values grows for as long as the source emits new values. see also rxcpp::operators::distinct_within and rxcpp::operators::distinct_bloom.
 
     \sample
     \snippet distinct.cpp distinct sample
     \snippet output.txt distinct sample
+
+    \sample
+    \snippet distinct.cpp distinct capacity sample
+    \snippet output.txt distinct capacity sample
 */
 
 #if !defined(RXCPP_OPERATORS_RX_DISTINCT_HPP)
@@ -81,6 +91,92 @@ struct distinct
     }
 };
 
+// remembers the last 'capacity' values that were seen. a repeated value becomes
+// the most recent again, so it is forgotten only after 'capacity' other values.
+template<class T>
+struct distinct_lru
+{
+    using source_value_type = rxu::decay_t<T>;
+
+    std::size_t capacity;
+
+    explicit distinct_lru(std::size_t c)
+        : capacity((std::max)(std::size_t(1), c))
+    {
+    }
+
+    template<class Subscriber>
+    struct distinct_lru_observer
+    {
+        using this_type = distinct_lru_observer<Subscriber>;
+        using value_type = source_value_type;
+        using dest_type = rxu::decay_t<Subscriber>;
+        using observer_type = observer<value_type, this_type>;
+        // the most recently seen value is first
+        using list_type = std::list<source_value_type>;
+        using map_type = std::unordered_map<source_value_type, typename list_type::iterator, rxcpp::filtered_hash<source_value_type>>;
+
+        struct distinct_lru_state
+        {
+            explicit distinct_lru_state(std::size_t c)
+                : capacity(c)
+            {
+                // the set never holds more than capacity values, so it never rehashes
+                remembered.reserve(capacity);
+            }
+            std::size_t capacity;
+            list_type recent;
+            map_type remembered;
+        };
+
+        dest_type dest;
+        std::shared_ptr<distinct_lru_state> state;
+
+        distinct_lru_observer(dest_type d, std::size_t capacity)
+            : dest(std::move(d))
+            , state(rxu::make_shared_state<distinct_lru_state>(capacity))
+        {
+        }
+        template<typename U>
+        void on_next(U&& v) const {
+            auto& recent = state->recent;
+            auto& remembered = state->remembered;
+            auto found = remembered.find(v);
+            if (found != remembered.end()) {
+                recent.splice(recent.begin(), recent, found->second);
+                return;
+            }
+            if (remembered.size() == state->capacity) {
+                // reuse the node of the least recently seen value
+                remembered.erase(recent.back());
+                recent.splice(recent.begin(), recent, std::prev(recent.end()));
+                recent.front() = v;
+            } else {
+                recent.push_front(v);
+            }
+            remembered.emplace(recent.front(), recent.begin());
+            dest.on_next(std::forward<U>(v));
+        }
+        void on_error(rxu::error_ptr e) const {
+            dest.on_error(e);
+        }
+        void on_completed() const {
+            dest.on_completed();
+        }
+
+        static subscriber<value_type, observer<value_type, this_type>> make(dest_type d, std::size_t capacity) {
+            auto cs = d.get_subscription();
+            return make_subscriber<value_type>(std::move(cs), this_type(std::move(d), capacity));
+        }
+    };
+
+    template<class Subscriber>
+    auto operator()(Subscriber dest) const
+    -> decltype(distinct_lru_observer<Subscriber>::make(std::move(dest), capacity)) {
+        return      distinct_lru_observer<Subscriber>::make(std::move(dest), capacity);
+    }
+};
+
 }
 
 /*! @copydoc rx-distinct.hpp
@@ -107,11 +203,23 @@ struct member_overload<distinct_tag>
         return  o.template lift<SourceValue>(Distinct());
     }
 
+    template<class Observable, class Count,
+            class SourceValue = rxu::value_type_t<Observable>,
+            class Enabled = rxu::enable_if_all_true_type_t<
+                is_observable<Observable>,
+                is_hashable<SourceValue>,
+                std::is_integral<rxu::decay_t<Count>>>,
+            class Distinct = rxo::detail::distinct_lru<SourceValue>>
+    static auto member(Observable&& o, Count&& c)
+    -> decltype(o.template lift<SourceValue>(Distinct(c))) {
+        return  o.template lift<SourceValue>(Distinct(c));
+    }
+
     template<class... AN>
     static operators::detail::distinct_invalid_t<AN...> member(AN...) {
         std::terminate();
         return {};
-        static_assert(sizeof...(AN) == 10000, "distinct takes no arguments");
+        static_assert(sizeof...(AN) == 10000, "distinct takes (optional Capacity)");
     }
 };
 
@@ -0,0 +1,201 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+/*! \file rx-distinct_bloom.hpp
+
+    \brief For each item from this observable, filter out values that have probably been emitted already, using a fixed amount of memory.
+
+    \param expected_n  the number of distinct values that the source is expected to emit.
+    \param fp_rate     the chance that a new value is filtered out after expected_n distinct values, such as 0.01.
+
+    \return  Observable that emits those items from the source observable that have not been emitted before, except for some that are filtered out by mistake.
+
+    The values are remembered in a bloom filter that is sized when the observable is subscribed and never grows.
+    A repeated value is never emitted, but a new value is filtered out at about fp_rate once expected_n distinct values
+    have been seen, and more often after that.
+
+    \note like distinct, distinct_bloom requires that rxcpp::filtered_hash<T> is specialized for T.
+
+    \sample
+    \snippet distinct_bloom.cpp distinct_bloom sample
+    \snippet output.txt distinct_bloom sample
+*/
+
+#if !defined(RXCPP_OPERATORS_RX_DISTINCT_BLOOM_HPP)
+#define RXCPP_OPERATORS_RX_DISTINCT_BLOOM_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+namespace detail {
+
+template<class... AN>
+struct distinct_bloom_invalid_arguments {};
+
+template<class... AN>
+struct distinct_bloom_invalid : public rxo::operator_base<distinct_bloom_invalid_arguments<AN...>> {
+    using type = observable<distinct_bloom_invalid_arguments<AN...>, distinct_bloom_invalid<AN...>>;
+};
+template<class... AN>
+using distinct_bloom_invalid_t = typename distinct_bloom_invalid<AN...>::type;
+
+// a set of hashes that answers 'maybe present' or 'not present'.
+// each hash sets k of m bits, chosen by double hashing.
+class bloom_filter
+{
+    std::vector<std::uint64_t> bits;
+    std::uint64_t size;
+    int hashes;
+
+    // spreads the bits of a hash. std::hash is the identity for integers on some platforms.
+    static std::uint64_t mix(std::uint64_t x) {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ull;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebull;
+        x ^= x >> 31;
+        return x;
+    }
+
+public:
+    bloom_filter(std::size_t expected_n, double fp_rate)
+    {
+        const double ln2 = std::log(2.0);
+        double n = static_cast<double>((std::max)(std::size_t(1), expected_n));
+        double p = (std::min)((std::max)(fp_rate, 1e-12), 0.5);
+        double m = std::ceil(-n * std::log(p) / (ln2 * ln2));
+        bits.resize(static_cast<std::size_t>(m / 64) + 1);
+        size = bits.size() * 64;
+        hashes = (std::max)(1, static_cast<int>(std::round(m / n * ln2)));
+    }
+
+    /// returns false when the hash was probably inserted already
+    bool insert(std::size_t hash) {
+        std::uint64_t h1 = mix(hash);
+        std::uint64_t h2 = mix(h1) | 1;
+        bool inserted = false;
+        for (int i = 0; i != hashes; ++i) {
+            std::uint64_t bit = (h1 + i * h2) % size;
+            std::uint64_t mask = std::uint64_t(1) << (bit % 64);
+            auto& word = bits[static_cast<std::size_t>(bit / 64)];
+            inserted = inserted || (word & mask) == 0;
+            word |= mask;
+        }
+        return inserted;
+    }
+
+    std::size_t bit_count() const {
+        return static_cast<std::size_t>(size);
+    }
+    int hash_count() const {
+        return hashes;
+    }
+};
+
+template<class T>
+struct distinct_bloom
+{
+    using source_value_type = rxu::decay_t<T>;
+
+    struct distinct_bloom_values
+    {
+        distinct_bloom_values(std::size_t n, double p)
+            : expected_n(n)
+            , fp_rate(p)
+        {
+        }
+        std::size_t expected_n;
+        double fp_rate;
+    };
+    distinct_bloom_values initial;
+
+    distinct_bloom(std::size_t expected_n, double fp_rate)
+        : initial(expected_n, fp_rate)
+    {
+    }
+
+    template<class Subscriber>
+    struct distinct_bloom_observer
+    {
+        using this_type = distinct_bloom_observer<Subscriber>;
+        using value_type = source_value_type;
+        using dest_type = rxu::decay_t<Subscriber>;
+        using observer_type = observer<value_type, this_type>;
+
+        dest_type dest;
+        std::shared_ptr<bloom_filter> remembered;
+
+        distinct_bloom_observer(dest_type d, distinct_bloom_values v)
+            : dest(std::move(d))
+            , remembered(rxu::make_shared_state<bloom_filter>(v.expected_n, v.fp_rate))
+        {
+        }
+        template<typename U>
+        void on_next(U&& v) const {
+            if (remembered->insert(rxcpp::filtered_hash<source_value_type>()(v))) {
+                dest.on_next(std::forward<U>(v));
+            }
+        }
+        void on_error(rxu::error_ptr e) const {
+            dest.on_error(e);
+        }
+        void on_completed() const {
+            dest.on_completed();
+        }
+
+        static subscriber<value_type, observer_type> make(dest_type d, distinct_bloom_values v) {
+            auto cs = d.get_subscription();
+            return make_subscriber<value_type>(std::move(cs), this_type(std::move(d), std::move(v)));
+        }
+    };
+
+    template<class Subscriber>
+    auto operator()(Subscriber dest) const
+        -> decltype(distinct_bloom_observer<Subscriber>::make(std::move(dest), initial)) {
+        return      distinct_bloom_observer<Subscriber>::make(std::move(dest), initial);
+    }
+};
+
+}
+
+/*! @copydoc rx-distinct_bloom.hpp
+*/
+template<class... AN>
+auto distinct_bloom(AN&&... an)
+    ->      operator_factory<distinct_bloom_tag, AN...> {
+     return operator_factory<distinct_bloom_tag, AN...>(std::make_tuple(std::forward<AN>(an)...));
+}
+
+}
+
+template<>
+struct member_overload<distinct_bloom_tag>
+{
+    template<class Observable, class Count, class Rate,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            is_hashable<SourceValue>,
+            std::is_integral<rxu::decay_t<Count>>,
+            std::is_floating_point<rxu::decay_t<Rate>>>,
+        class DistinctBloom = rxo::detail::distinct_bloom<SourceValue>>
+    static auto member(Observable&& o, Count&& n, Rate&& p)
+        -> decltype(o.template lift<SourceValue>(DistinctBloom(n, p))) {
+        return      o.template lift<SourceValue>(DistinctBloom(n, p));
+    }
+
+    template<class... AN>
+    static operators::detail::distinct_bloom_invalid_t<AN...> member(AN...) {
+        std::terminate();
+        return {};
+        static_assert(sizeof...(AN) == 10000, "distinct_bloom takes (ExpectedCount, FalsePositiveRate)");
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,184 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+/*! \file rx-distinct_within.hpp
+
+    \brief For each item from this observable, filter out the values that were already emitted within the given period.
+
+    \tparam Duration      the type of the period.
+    \tparam Coordination  the type of the scheduler that provides the time (optional).
+
+    \param period        the time that an emitted value is remembered.
+    \param coordination  the scheduler that provides the time (optional).
+
+    \return  Observable that emits those items from the source observable that were not emitted in the last period.
+
+    A value is remembered from the time that it is emitted, repeats of the value do not extend the period.
+    Values are forgotten when the next item arrives after their period, so only the values emitted in the last period are kept.
+
+    \note like distinct, distinct_within requires that rxcpp::filtered_hash<T> is specialized for T.
+
+    \sample
+    \snippet distinct_within.cpp distinct_within sample
+    \snippet output.txt distinct_within sample
+*/
+
+#if !defined(RXCPP_OPERATORS_RX_DISTINCT_WITHIN_HPP)
+#define RXCPP_OPERATORS_RX_DISTINCT_WITHIN_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+namespace detail {
+
+template<class... AN>
+struct distinct_within_invalid_arguments {};
+
+template<class... AN>
+struct distinct_within_invalid : public rxo::operator_base<distinct_within_invalid_arguments<AN...>> {
+    using type = observable<distinct_within_invalid_arguments<AN...>, distinct_within_invalid<AN...>>;
+};
+template<class... AN>
+using distinct_within_invalid_t = typename distinct_within_invalid<AN...>::type;
+
+template<class T, class Duration, class Coordination>
+struct distinct_within
+{
+    using source_value_type = rxu::decay_t<T>;
+    using duration_type = rxu::decay_t<Duration>;
+    using coordination_type = rxu::decay_t<Coordination>;
+
+    struct distinct_within_values
+    {
+        distinct_within_values(duration_type p, coordination_type c)
+            : period(p)
+            , coordination(c)
+        {
+        }
+        duration_type period;
+        coordination_type coordination;
+    };
+    distinct_within_values initial;
+
+    distinct_within(duration_type period, coordination_type coordination)
+        : initial(period, coordination)
+    {
+    }
+
+    template<class Subscriber>
+    struct distinct_within_observer
+    {
+        using this_type = distinct_within_observer<Subscriber>;
+        using value_type = source_value_type;
+        using dest_type = rxu::decay_t<Subscriber>;
+        using observer_type = observer<value_type, this_type>;
+        using time_point = rxsc::scheduler::clock_type::time_point;
+
+        struct distinct_within_state : public distinct_within_values
+        {
+            explicit distinct_within_state(distinct_within_values v)
+                : distinct_within_values(std::move(v))
+            {
+            }
+            std::unordered_set<source_value_type, rxcpp::filtered_hash<source_value_type>> remembered;
+            // the values in remembered, in the order that they were emitted
+            std::deque<std::pair<time_point, source_value_type>> emitted;
+        };
+
+        dest_type dest;
+        std::shared_ptr<distinct_within_state> state;
+
+        distinct_within_observer(dest_type d, distinct_within_values v)
+            : dest(std::move(d))
+            , state(rxu::make_shared_state<distinct_within_state>(std::move(v)))
+        {
+        }
+        template<typename U>
+        void on_next(U&& v) const {
+            auto now = state->coordination.now();
+            auto& emitted = state->emitted;
+            while (!emitted.empty() && emitted.front().first + state->period <= now) {
+                state->remembered.erase(emitted.front().second);
+                emitted.pop_front();
+            }
+            if (!state->remembered.insert(v).second) {
+                return;
+            }
+            emitted.emplace_back(now, v);
+            dest.on_next(std::forward<U>(v));
+        }
+        void on_error(rxu::error_ptr e) const {
+            dest.on_error(e);
+        }
+        void on_completed() const {
+            dest.on_completed();
+        }
+
+        static subscriber<value_type, observer_type> make(dest_type d, distinct_within_values v) {
+            auto cs = d.get_subscription();
+            return make_subscriber<value_type>(std::move(cs), this_type(std::move(d), std::move(v)));
+        }
+    };
+
+    template<class Subscriber>
+    auto operator()(Subscriber dest) const
+        -> decltype(distinct_within_observer<Subscriber>::make(std::move(dest), initial)) {
+        return      distinct_within_observer<Subscriber>::make(std::move(dest), initial);
+    }
+};
+
+}
+
+/*! @copydoc rx-distinct_within.hpp
+*/
+template<class... AN>
+auto distinct_within(AN&&... an)
+    ->      operator_factory<distinct_within_tag, AN...> {
+     return operator_factory<distinct_within_tag, AN...>(std::make_tuple(std::forward<AN>(an)...));
+}
+
+}
+
+template<>
+struct member_overload<distinct_within_tag>
+{
+    template<class Observable, class Duration,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            is_hashable<SourceValue>,
+            rxu::is_duration<Duration>>,
+        class DistinctWithin = rxo::detail::distinct_within<SourceValue, rxu::decay_t<Duration>, identity_one_worker>>
+    static auto member(Observable&& o, Duration&& d)
+        -> decltype(o.template lift<SourceValue>(DistinctWithin(std::forward<Duration>(d), identity_current_thread()))) {
+        return      o.template lift<SourceValue>(DistinctWithin(std::forward<Duration>(d), identity_current_thread()));
+    }
+
+    template<class Observable, class Duration, class Coordination,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            is_hashable<SourceValue>,
+            rxu::is_duration<Duration>,
+            is_coordination<Coordination>>,
+        class DistinctWithin = rxo::detail::distinct_within<SourceValue, rxu::decay_t<Duration>, rxu::decay_t<Coordination>>>
+    static auto member(Observable&& o, Duration&& d, Coordination&& cn)
+        -> decltype(o.template lift<SourceValue>(DistinctWithin(std::forward<Duration>(d), std::forward<Coordination>(cn)))) {
+        return      o.template lift<SourceValue>(DistinctWithin(std::forward<Duration>(d), std::forward<Coordination>(cn)));
+    }
+
+    template<class... AN>
+    static operators::detail::distinct_within_invalid_t<AN...> member(AN...) {
+        std::terminate();
+        return {};
+        static_assert(sizeof...(AN) == 10000, "distinct_within takes (Duration, optional Coordination)");
+    }
+};
+
+}
+
+#endif
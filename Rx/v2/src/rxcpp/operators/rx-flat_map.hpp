@@ -148,7 +148,7 @@ struct flat_map
         auto coordinator = initial.coordination.create_coordinator(scbr.get_subscription());
 
         // take a copy of the values for each subscription
-        auto state = std::make_shared<state_type>(initial, std::move(coordinator), std::move(scbr));
+        auto state = rxu::make_shared_state<state_type>(initial, std::move(coordinator), std::move(scbr));
 
         composite_subscription outercs;
 
@@ -183,7 +183,7 @@ struct flat_map
                     state->out.remove(innercstoken);
                 }));
 
-                auto stAsShared         = std::make_shared<source_value_type>(std::forward<decltype(st)>(st));
+                auto stAsShared         = rxu::make_shared_state<source_value_type>(std::forward<decltype(st)>(st));
                 auto selectedCollection = state->selectCollection(*stAsShared);
                 auto selectedSource = state->coordinator.in(selectedCollection);
 
@@ -192,7 +192,7 @@ struct group_by
         group_by_observer(composite_subscription l, dest_type d, group_by_values v)
             : group_by_values(v)
             , dest(std::move(d))
-            , state(std::make_shared<group_by_state_type>(l, group_by_values::predicate))
+            , state(rxu::make_shared_state<group_by_state_type>(l, group_by_values::predicate))
         {
             group_by::stopsource(dest, state);
         }
@@ -0,0 +1,426 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+/*! \file rx-join.hpp
+
+    \brief For each item from either observable, combine it with each item from the other observable that has the same key and arrived within the window.
+
+    \tparam RightObservable  the type of the other observable.
+    \tparam LeftKeySelector  the type of the function that extracts the key from an item of this observable.
+    \tparam RightKeySelector the type of the function that extracts the key from an item of the other observable.
+    \tparam Duration         the type of the window.
+    \tparam ResultSelector   the type of the function that combines a matched pair (optional).
+    \tparam Coordination     the type of the scheduler that provides the time and serializes the sources (optional).
+
+    \param right         the other observable.
+    \param left_key      the function that extracts the key from an item of this observable.
+    \param right_key     the function that extracts the key from an item of the other observable.
+    \param window        how long an item stays available for matching after it arrives.
+    \param selector      the function that is called with (left, right) for each matched pair (optional).
+    \param coordination  the scheduler that provides the time and serializes the sources (optional).
+
+    \return  Observable that emits the result of the selector, or a tuple of the pair, for each match.
+
+    Each side keeps a hash index of the items that arrived within the window. An arriving item
+    is looked up by key in the index of the other side and then added to the index of its own side.
+    Items leave the indexes in arrival order once they are older than the window, so the cost
+    of expiry is constant for each item.
+
+    The result completes when both observables have completed.
+
+    If coordination is omitted, identity_current_thread is used. When the observables emit on
+    different threads, pass a coordination that serializes, such as serialize_one_worker.
+
+    \note join requires that rxcpp::filtered_hash<K> is specialized for the key type K.
+
+    \sample
+    \snippet join.cpp join sample
+    \snippet output.txt join sample
+*/
+
+#if !defined(RXCPP_OPERATORS_RX_JOIN_HPP)
+#define RXCPP_OPERATORS_RX_JOIN_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+namespace detail {
+
+template<class... AN>
+struct join_invalid_arguments {};
+
+template<class... AN>
+struct join_invalid : public rxo::operator_base<join_invalid_arguments<AN...>> {
+    using type = observable<join_invalid_arguments<AN...>, join_invalid<AN...>>;
+};
+template<class... AN>
+using join_invalid_t = typename join_invalid<AN...>::type;
+
+template<class LeftValue, class RightValue, class LeftKeySelector, class RightKeySelector, class Selector>
+struct is_join_selectors_check {
+    struct tag_not_valid;
+
+    template<class LV, class RV, class LKS, class RKS, class S,
+        class LK = rxu::decay_t<decltype((*(LKS*)nullptr)(*(const LV*)nullptr))>,
+        class RK = rxu::decay_t<decltype((*(RKS*)nullptr)(*(const RV*)nullptr))>,
+        class Enabled = std::enable_if_t<std::is_same<LK, RK>::value>>
+    static auto check(int) -> decltype((*(S*)nullptr)(*(const LV*)nullptr, *(const RV*)nullptr));
+    template<class LV, class RV, class LKS, class RKS, class S>
+    static tag_not_valid check(...);
+
+    using type = decltype(check<LeftValue, RightValue, LeftKeySelector, RightKeySelector, Selector>(0));
+    static const bool value = !std::is_same<type, tag_not_valid>::value;
+};
+
+template<class LeftValue, class RightValue, class LeftKeySelector, class RightKeySelector, class Selector>
+struct is_join_selectors : public std::integral_constant<bool,
+    is_join_selectors_check<rxu::decay_t<LeftValue>, rxu::decay_t<RightValue>,
+        rxu::decay_t<LeftKeySelector>, rxu::decay_t<RightKeySelector>, rxu::decay_t<Selector>>::value>
+{
+};
+
+template<class LeftObservable, class RightObservable, class LeftKeySelector, class RightKeySelector, class Duration, class Selector, class Coordination>
+struct join_traits {
+    using left_source_type = rxu::decay_t<LeftObservable>;
+    using right_source_type = rxu::decay_t<RightObservable>;
+    using left_value_type = rxu::value_type_t<left_source_type>;
+    using right_value_type = rxu::value_type_t<right_source_type>;
+    using left_key_selector_type = rxu::decay_t<LeftKeySelector>;
+    using right_key_selector_type = rxu::decay_t<RightKeySelector>;
+    using duration_type = rxu::decay_t<Duration>;
+    using selector_type = rxu::decay_t<Selector>;
+    using coordination_type = rxu::decay_t<Coordination>;
+
+    using key_type = rxu::decay_t<decltype((*(left_key_selector_type*)nullptr)(*(const left_value_type*)nullptr))>;
+    using value_type = typename is_join_selectors_check<left_value_type, right_value_type,
+        left_key_selector_type, right_key_selector_type, selector_type>::type;
+};
+
+// the items of one side that arrived within the window, indexed by key.
+// the items are stored once, in arrival order, and the items with the same
+// key are chained together so that a probe visits only the matches.
+template<class Key, class Value>
+class join_index
+{
+public:
+    using key_type = Key;
+    using value_type = Value;
+    using time_point = rxsc::scheduler::clock_type::time_point;
+
+private:
+    struct arrival
+    {
+        time_point at;
+        key_type key;
+        value_type value;
+        // the sequence number of the next arrival with the same key
+        std::size_t next;
+    };
+    // the sequence numbers of the oldest and newest arrivals with a key
+    struct chain
+    {
+        std::size_t first;
+        std::size_t last;
+    };
+
+    std::deque<arrival> arrived;
+    // the sequence number of arrived.front()
+    std::size_t expired = 0;
+    std::unordered_map<key_type, chain, rxcpp::filtered_hash<key_type>> live;
+
+public:
+    template<class Duration>
+    void expire(time_point now, Duration window) {
+        while (!arrived.empty() && arrived.front().at + window <= now) {
+            auto& oldest = arrived.front();
+            auto found = live.find(oldest.key);
+            // items with the same key arrive in order, so the oldest is first in its chain
+            if (found->second.last == expired) {
+                live.erase(found);
+            } else {
+                found->second.first = oldest.next;
+            }
+            arrived.pop_front();
+            ++expired;
+        }
+    }
+
+    /// calls f with each live item that has the key, oldest first, until f returns false
+    template<class F>
+    void for_each(const key_type& key, F&& f) const {
+        auto found = live.find(key);
+        if (found == live.end()) {
+            return;
+        }
+        for (auto seq = found->second.first;;) {
+            auto& a = arrived[seq - expired];
+            if (!f(a.value) || seq == found->second.last) {
+                break;
+            }
+            seq = a.next;
+        }
+    }
+
+    template<class U>
+    void insert(time_point now, key_type key, U&& value) {
+        auto seq = expired + arrived.size();
+        auto found = live.find(key);
+        if (found == live.end()) {
+            live.emplace(key, chain{seq, seq});
+        } else {
+            arrived[found->second.last - expired].next = seq;
+            found->second.last = seq;
+        }
+        arrived.push_back(arrival{now, std::move(key), std::forward<U>(value), seq});
+    }
+};
+
+template<class LeftObservable, class RightObservable, class LeftKeySelector, class RightKeySelector, class Duration, class Selector, class Coordination>
+struct join : public operator_base<rxu::value_type_t<join_traits<LeftObservable, RightObservable, LeftKeySelector, RightKeySelector, Duration, Selector, Coordination>>>
+{
+    using this_type = join<LeftObservable, RightObservable, LeftKeySelector, RightKeySelector, Duration, Selector, Coordination>;
+    using traits = join_traits<LeftObservable, RightObservable, LeftKeySelector, RightKeySelector, Duration, Selector, Coordination>;
+
+    using left_source_type = typename traits::left_source_type;
+    using right_source_type = typename traits::right_source_type;
+    using left_value_type = typename traits::left_value_type;
+    using right_value_type = typename traits::right_value_type;
+    using left_key_selector_type = typename traits::left_key_selector_type;
+    using right_key_selector_type = typename traits::right_key_selector_type;
+    using duration_type = typename traits::duration_type;
+    using selector_type = typename traits::selector_type;
+    using key_type = typename traits::key_type;
+
+    using coordination_type = typename traits::coordination_type;
+    using coordinator_type = typename coordination_type::coordinator_type;
+
+    struct values
+    {
+        values(left_source_type l, right_source_type r, left_key_selector_type lks, right_key_selector_type rks, duration_type w, selector_type s, coordination_type sf)
+            : left(std::move(l))
+            , right(std::move(r))
+            , left_key(std::move(lks))
+            , right_key(std::move(rks))
+            , window(w)
+            , selector(std::move(s))
+            , coordination(std::move(sf))
+        {
+        }
+        left_source_type left;
+        right_source_type right;
+        left_key_selector_type left_key;
+        right_key_selector_type right_key;
+        duration_type window;
+        selector_type selector;
+        coordination_type coordination;
+    };
+    values initial;
+
+    join(left_source_type l, right_source_type r, left_key_selector_type lks, right_key_selector_type rks, duration_type w, selector_type s, coordination_type sf)
+        : initial(std::move(l), std::move(r), std::move(lks), std::move(rks), w, std::move(s), std::move(sf))
+    {
+    }
+
+    template<class State, class Source, class SourceValue, class Arrive>
+    static void subscribe_one(std::shared_ptr<State> state, const Source& side, SourceValue*, Arrive arrive) {
+
+        composite_subscription innercs;
+
+        // when the out observer is unsubscribed all the
+        // inner subscriptions are unsubscribed as well
+        state->out.add(innercs);
+
+        auto source = on_exception(
+            [&](){return state->coordinator.in(side);},
+            state->out);
+        if (source.empty()) {
+            return;
+        }
+
+        // this subscribe does not share the observer subscription
+        // so that when it is unsubscribed the observer can be called
+        // until the inner subscriptions have finished
+        auto sink = make_subscriber<SourceValue>(
+            state->out,
+            innercs,
+        // on_next
+            [state, arrive](auto&& st) {
+                arrive(*state, std::forward<decltype(st)>(st));
+            },
+        // on_error
+            [state](rxu::error_ptr e) {
+                state->out.on_error(e);
+            },
+        // on_completed
+            [state]() {
+                if (--state->pendingCompletions == 0) {
+                    state->out.on_completed();
+                }
+            }
+        );
+        auto selectedSink = on_exception(
+            [&](){return state->coordinator.out(sink);},
+            state->out);
+        if (selectedSink.empty()) {
+            return;
+        }
+        source->subscribe(std::move(selectedSink.get()));
+    }
+
+    template<class Subscriber>
+    void on_subscribe(Subscriber scbr) const {
+        static_assert(is_subscriber<Subscriber>::value, "subscribe must be passed a subscriber");
+
+        using output_type = Subscriber;
+
+        struct join_state_type
+            : public std::enable_shared_from_this<join_state_type>
+            , public values
+        {
+            join_state_type(values i, coordinator_type coor, output_type oarg)
+                : values(std::move(i))
+                , pendingCompletions(2)
+                , coordinator(std::move(coor))
+                , out(std::move(oarg))
+            {
+            }
+
+            // on_completed on the output must wait until both
+            // subscriptions have received on_completed
+            mutable int pendingCompletions;
+            join_index<key_type, left_value_type> lefts;
+            join_index<key_type, right_value_type> rights;
+            coordinator_type coordinator;
+            output_type out;
+        };
+
+        auto coordinator = initial.coordination.create_coordinator(scbr.get_subscription());
+
+        // take a copy of the values for each subscription
+        auto state = rxu::make_shared_state<join_state_type>(initial, std::move(coordinator), std::move(scbr));
+
+        subscribe_one(state, state->left, (left_value_type*)nullptr,
+            [](join_state_type& st, auto&& v) {
+                auto key = on_exception(
+                    [&](){return st.left_key(rxu::as_const(v));},
+                    st.out);
+                if (key.empty()) {
+                    return;
+                }
+                auto now = st.coordination.now();
+                st.lefts.expire(now, st.window);
+                st.rights.expire(now, st.window);
+                bool selected = true;
+                st.rights.for_each(key.get(), [&](const right_value_type& r) {
+                    auto result = on_exception(
+                        [&](){return st.selector(rxu::as_const(v), r);},
+                        st.out);
+                    selected = !result.empty();
+                    if (selected) {
+                        st.out.on_next(std::move(result.get()));
+                    }
+                    return selected;
+                });
+                if (!selected) {
+                    return;
+                }
+                st.lefts.insert(now, std::move(key.get()), std::forward<decltype(v)>(v));
+            });
+
+        subscribe_one(state, state->right, (right_value_type*)nullptr,
+            [](join_state_type& st, auto&& v) {
+                auto key = on_exception(
+                    [&](){return st.right_key(rxu::as_const(v));},
+                    st.out);
+                if (key.empty()) {
+                    return;
+                }
+                auto now = st.coordination.now();
+                st.lefts.expire(now, st.window);
+                st.rights.expire(now, st.window);
+                bool selected = true;
+                st.lefts.for_each(key.get(), [&](const left_value_type& l) {
+                    auto result = on_exception(
+                        [&](){return st.selector(l, rxu::as_const(v));},
+                        st.out);
+                    selected = !result.empty();
+                    if (selected) {
+                        st.out.on_next(std::move(result.get()));
+                    }
+                    return selected;
+                });
+                if (!selected) {
+                    return;
+                }
+                st.rights.insert(now, std::move(key.get()), std::forward<decltype(v)>(v));
+            });
+    }
+};
+
+}
+
+/*! @copydoc rx-join.hpp
+*/
+template<class... AN>
+auto join(AN&&... an)
+    ->      operator_factory<join_tag, AN...> {
+     return operator_factory<join_tag, AN...>(std::make_tuple(std::forward<AN>(an)...));
+}
+
+}
+
+template<>
+struct member_overload<join_tag>
+{
+    template<class Observable, class RightObservable, class LeftKeySelector, class RightKeySelector, class Duration,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            all_observables<Observable, RightObservable>,
+            rxu::is_duration<Duration>,
+            operators::detail::is_join_selectors<rxu::value_type_t<Observable>, rxu::value_type_t<RightObservable>, LeftKeySelector, RightKeySelector, rxu::detail::pack>>,
+        class Join = rxo::detail::join<rxu::decay_t<Observable>, rxu::decay_t<RightObservable>, rxu::decay_t<LeftKeySelector>, rxu::decay_t<RightKeySelector>, rxu::decay_t<Duration>, rxu::detail::pack, identity_one_worker>,
+        class Value = rxu::value_type_t<Join>,
+        class Result = observable<Value, Join>>
+    static Result member(Observable&& o, RightObservable&& r, LeftKeySelector&& lks, RightKeySelector&& rks, Duration&& d) {
+        return Result(Join(std::forward<Observable>(o), std::forward<RightObservable>(r), std::forward<LeftKeySelector>(lks), std::forward<RightKeySelector>(rks), std::forward<Duration>(d), rxu::pack(), identity_current_thread()));
+    }
+
+    template<class Observable, class RightObservable, class LeftKeySelector, class RightKeySelector, class Duration, class Selector,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            all_observables<Observable, RightObservable>,
+            rxu::is_duration<Duration>,
+            operators::detail::is_join_selectors<rxu::value_type_t<Observable>, rxu::value_type_t<RightObservable>, LeftKeySelector, RightKeySelector, Selector>>,
+        class Join = rxo::detail::join<rxu::decay_t<Observable>, rxu::decay_t<RightObservable>, rxu::decay_t<LeftKeySelector>, rxu::decay_t<RightKeySelector>, rxu::decay_t<Duration>, rxu::decay_t<Selector>, identity_one_worker>,
+        class Value = rxu::value_type_t<Join>,
+        class Result = observable<Value, Join>>
+    static Result member(Observable&& o, RightObservable&& r, LeftKeySelector&& lks, RightKeySelector&& rks, Duration&& d, Selector&& s) {
+        return Result(Join(std::forward<Observable>(o), std::forward<RightObservable>(r), std::forward<LeftKeySelector>(lks), std::forward<RightKeySelector>(rks), std::forward<Duration>(d), std::forward<Selector>(s), identity_current_thread()));
+    }
+
+    template<class Observable, class RightObservable, class LeftKeySelector, class RightKeySelector, class Duration, class Selector, class Coordination,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            all_observables<Observable, RightObservable>,
+            rxu::is_duration<Duration>,
+            is_coordination<Coordination>,
+            operators::detail::is_join_selectors<rxu::value_type_t<Observable>, rxu::value_type_t<RightObservable>, LeftKeySelector, RightKeySelector, Selector>>,
+        class Join = rxo::detail::join<rxu::decay_t<Observable>, rxu::decay_t<RightObservable>, rxu::decay_t<LeftKeySelector>, rxu::decay_t<RightKeySelector>, rxu::decay_t<Duration>, rxu::decay_t<Selector>, rxu::decay_t<Coordination>>,
+        class Value = rxu::value_type_t<Join>,
+        class Result = observable<Value, Join>>
+    static Result member(Observable&& o, RightObservable&& r, LeftKeySelector&& lks, RightKeySelector&& rks, Duration&& d, Selector&& s, Coordination&& cn) {
+        return Result(Join(std::forward<Observable>(o), std::forward<RightObservable>(r), std::forward<LeftKeySelector>(lks), std::forward<RightKeySelector>(rks), std::forward<Duration>(d), std::forward<Selector>(s), std::forward<Coordination>(cn)));
+    }
+
+    template<class... AN>
+    static operators::detail::join_invalid_t<AN...> member(const AN&...) {
+        std::terminate();
+        return {};
+        static_assert(sizeof...(AN) == 10000, "join takes (RightObservable, LeftKeySelector, RightKeySelector, Duration, optional Selector, optional Coordination), LeftKeySelector and RightKeySelector must return the same key type, Selector takes (LeftValue, RightValue)");
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,87 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+/*! \file rx-merge_partitions.hpp
+
+    \brief For each shard emitted by partition, or each observable emitted by this observable, subscribe and emit the items, serializing the items from different threads.
+
+    \tparam Coordination  the type of the scheduler that serializes the items (optional).
+
+    \param coordination  the scheduler that serializes the items (optional). serialize_same_worker on the current thread is used when omitted.
+
+    \return  Observable that emits the items from all the shards, in the order that they were emitted on any worker.
+
+    This is merge with a coordination that serializes, because the shards emit concurrently on different workers.
+
+    \sample
+    \snippet partition.cpp partition sample
+    \snippet output.txt partition sample
+*/
+
+#if !defined(RXCPP_OPERATORS_RX_MERGE_PARTITIONS_HPP)
+#define RXCPP_OPERATORS_RX_MERGE_PARTITIONS_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+namespace detail {
+
+template<class... AN>
+struct merge_partitions_invalid_arguments {};
+
+template<class... AN>
+struct merge_partitions_invalid : public rxo::operator_base<merge_partitions_invalid_arguments<AN...>> {
+    using type = observable<merge_partitions_invalid_arguments<AN...>, merge_partitions_invalid<AN...>>;
+};
+template<class... AN>
+using merge_partitions_invalid_t = typename merge_partitions_invalid<AN...>::type;
+
+}
+
+/*! @copydoc rx-merge_partitions.hpp
+*/
+template<class... AN>
+auto merge_partitions(AN&&... an)
+    ->      operator_factory<merge_partitions_tag, AN...> {
+     return operator_factory<merge_partitions_tag, AN...>(std::make_tuple(std::forward<AN>(an)...));
+}
+
+}
+
+template<>
+struct member_overload<merge_partitions_tag>
+{
+    template<class Observable,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            is_observable<rxu::value_type_t<Observable>>>>
+    static auto member(Observable&& o)
+        -> decltype(o.merge(serialize_same_worker(rxsc::make_current_thread().create_worker()))) {
+        return      o.merge(serialize_same_worker(rxsc::make_current_thread().create_worker()));
+    }
+
+    template<class Observable, class Coordination,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            is_observable<rxu::value_type_t<Observable>>,
+            is_coordination<Coordination>>>
+    static auto member(Observable&& o, Coordination&& cn)
+        -> decltype(o.merge(std::forward<Coordination>(cn))) {
+        return      o.merge(std::forward<Coordination>(cn));
+    }
+
+    template<class... AN>
+    static operators::detail::merge_partitions_invalid_t<AN...> member(AN...) {
+        std::terminate();
+        return {};
+        static_assert(sizeof...(AN) == 10000, "merge_partitions takes (optional Coordination)");
+    }
+};
+
+}
+
+#endif
@@ -53,7 +53,7 @@ struct multicast : public operator_base<T>
     std::shared_ptr<multicast_state> state;
 
     multicast(source_type o, subject_type sub)
-        : state(std::make_shared<multicast_state>(std::move(o), std::move(sub)))
+        : state(rxu::make_shared_state<multicast_state>(std::move(o), std::move(sub)))
     {
     }
     template<class Subscriber>
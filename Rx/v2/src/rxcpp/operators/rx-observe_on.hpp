@@ -179,7 +179,7 @@ struct observe_on
         std::shared_ptr<observe_on_state> state;
 
         observe_on_observer(dest_type d, coordinator_type coor, composite_subscription cs)
-            : state(std::make_shared<observe_on_state>(std::move(d), std::move(coor), std::move(cs)))
+            : state(rxu::make_shared_state<observe_on_state>(std::move(d), std::move(coor), std::move(cs)))
         {
         }
 
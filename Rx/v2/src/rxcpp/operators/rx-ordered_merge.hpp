@@ -0,0 +1,401 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+/*! \file rx-ordered_merge.hpp
+
+    \brief For each given observable subscribe.
+           Merge the items from observables that are each ordered by a key into one observable that is ordered by the key.
+
+           There are 2 variants of the operator:
+           - The source observable emits nested observables, nested observables are merged.
+           - The source observable and the arguments v0...vn are used to provide the observables to merge.
+
+    \tparam KeySelector   the type of the function that extracts the key from an item.
+    \tparam Comparator    the type of the function that orders the keys (optional).
+    \tparam Coordination  the type of the scheduler (optional).
+    \tparam Value0  ... (optional).
+    \tparam ValueN  types of source observables (optional).
+
+    \param  ks  a function that extracts the key from an item.
+    \param  c   a function that returns true when the first key is before the second key (optional). std::less is used when it is omitted.
+    \param  cn  the scheduler to synchronize sources from different contexts (optional).
+    \param  v0  ... (optional).
+    \param  vn  source observables (optional).
+
+    \return  Observable that emits the items from all the sources in the order of their keys.
+
+    Each source must emit its items in key order. An item is emitted once every source that has not completed has an item
+    waiting, so that no source can still emit an earlier key. The sources that have items waiting are kept in a heap by the
+    key of their first item, so each item costs O(log k) for k sources. Items with equal keys are emitted in the order that
+    the sources were subscribed.
+
+    When the sources are emitted by a source observable, nothing is emitted until that observable completes, because another
+    source could still be added.
+
+    If scheduler is omitted, identity_current_thread is used.
+
+    \sample
+    \snippet ordered_merge.cpp ordered_merge sample
+    \snippet output.txt ordered_merge sample
+*/
+
+#if !defined(RXCPP_OPERATORS_RX_ORDERED_MERGE_HPP)
+#define RXCPP_OPERATORS_RX_ORDERED_MERGE_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+namespace detail {
+
+template<class... AN>
+struct ordered_merge_invalid_arguments {};
+
+template<class... AN>
+struct ordered_merge_invalid : public rxo::operator_base<ordered_merge_invalid_arguments<AN...>> {
+    using type = observable<ordered_merge_invalid_arguments<AN...>, ordered_merge_invalid<AN...>>;
+};
+template<class... AN>
+using ordered_merge_invalid_t = typename ordered_merge_invalid<AN...>::type;
+
+template<class T, class Observable, class KeySelector, class Comparator, class Coordination>
+struct ordered_merge
+    : public operator_base<rxu::value_type_t<rxu::decay_t<T>>>
+{
+    using this_type = ordered_merge<T, Observable, KeySelector, Comparator, Coordination>;
+
+    using source_value_type = rxu::decay_t<T>;
+    using source_type = rxu::decay_t<Observable>;
+
+    using source_operator_type = typename source_type::source_operator_type;
+    using value_type = typename source_value_type::value_type;
+
+    using key_selector_type = rxu::decay_t<KeySelector>;
+    using comparator_type = rxu::decay_t<Comparator>;
+    using key_type = rxu::decay_t<decltype(std::declval<key_selector_type>()(std::declval<const value_type&>()))>;
+
+    using coordination_type = rxu::decay_t<Coordination>;
+    using coordinator_type = typename coordination_type::coordinator_type;
+
+    struct values
+    {
+        values(source_operator_type o, key_selector_type ks, comparator_type c, coordination_type sf)
+            : source_operator(std::move(o))
+            , key_selector(std::move(ks))
+            , comparator(std::move(c))
+            , coordination(std::move(sf))
+        {
+        }
+        source_operator_type source_operator;
+        key_selector_type key_selector;
+        comparator_type comparator;
+        coordination_type coordination;
+    };
+    values initial;
+
+    ordered_merge(const source_type& o, key_selector_type ks, comparator_type c, coordination_type sf)
+        : initial(o.source_operator, std::move(ks), std::move(c), std::move(sf))
+    {
+    }
+
+    template<class Subscriber>
+    void on_subscribe(Subscriber scbr) const {
+        static_assert(is_subscriber<Subscriber>::value, "subscribe must be passed a subscriber");
+
+        using output_type = Subscriber;
+
+        struct inner_state
+        {
+            inner_state()
+                : completed(false)
+            {
+            }
+            std::deque<std::pair<key_type, value_type>> pending;
+            bool completed;
+        };
+
+        struct ordered_merge_state_type
+            : public std::enable_shared_from_this<ordered_merge_state_type>
+            , public values
+        {
+            ordered_merge_state_type(values i, coordinator_type coor, output_type oarg)
+                : values(i)
+                , source(i.source_operator)
+                , outerCompleted(false)
+                , pendingCompletions(0)
+                , waiting(0)
+                , coordinator(std::move(coor))
+                , out(std::move(oarg))
+            {
+            }
+
+            // true when the first item of source a is after the first item of source b
+            bool after(std::size_t a, std::size_t b) const {
+                const auto& ka = inners[a].pending.front().first;
+                const auto& kb = inners[b].pending.front().first;
+                return this->comparator(kb, ka) || (!this->comparator(ka, kb) && b < a);
+            }
+
+            void push_heap(std::size_t index) {
+                heads.push_back(index);
+                std::push_heap(heads.begin(), heads.end(), [this](std::size_t a, std::size_t b){return after(a, b);});
+            }
+
+            std::size_t pop_heap() {
+                std::pop_heap(heads.begin(), heads.end(), [this](std::size_t a, std::size_t b){return after(a, b);});
+                auto index = heads.back();
+                heads.pop_back();
+                return index;
+            }
+
+            void drain() {
+                while (outerCompleted && waiting == 0 && !heads.empty()) {
+                    auto index = pop_heap();
+                    auto& inner = inners[index];
+                    auto next = std::move(inner.pending.front().second);
+                    inner.pending.pop_front();
+                    if (!inner.pending.empty()) {
+                        push_heap(index);
+                    } else if (!inner.completed) {
+                        ++waiting;
+                    }
+                    out.on_next(std::move(next));
+                }
+                if (outerCompleted && pendingCompletions == 0 && heads.empty()) {
+                    out.on_completed();
+                }
+            }
+
+            observable<source_value_type, source_operator_type> source;
+            // the sources in the order that they were subscribed
+            std::vector<inner_state> inners;
+            // the sources that have items pending, ordered by the key of the first item
+            std::vector<std::size_t> heads;
+            bool outerCompleted;
+            // the sources that have not completed
+            int pendingCompletions;
+            // the sources that have not completed and have no items pending
+            int waiting;
+            coordinator_type coordinator;
+            output_type out;
+        };
+
+        auto coordinator = initial.coordination.create_coordinator(scbr.get_subscription());
+
+        // take a copy of the values for each subscription
+        auto state = rxu::make_shared_state<ordered_merge_state_type>(initial, std::move(coordinator), std::move(scbr));
+
+        composite_subscription outercs;
+
+        // when the out observer is unsubscribed all the
+        // inner subscriptions are unsubscribed as well
+        state->out.add(outercs);
+
+        auto source = on_exception(
+            [&](){return state->coordinator.in(state->source);},
+            state->out);
+        if (source.empty()) {
+            return;
+        }
+
+        // this subscribe does not share the observer subscription
+        // so that when it is unsubscribed the observer can be called
+        // until the inner subscriptions have finished
+        auto sink = make_subscriber<source_value_type>(
+            state->out,
+            outercs,
+        // on_next
+            [state](source_value_type st) {
+
+                composite_subscription innercs;
+
+                // when the out observer is unsubscribed all the
+                // inner subscriptions are unsubscribed as well
+                auto innercstoken = state->out.add(innercs);
+
+                innercs.add(make_subscription([state, innercstoken](){
+                    state->out.remove(innercstoken);
+                }));
+
+                auto selectedSource = state->coordinator.in(st);
+
+                auto index = state->inners.size();
+                state->inners.emplace_back();
+                ++state->pendingCompletions;
+                ++state->waiting;
+
+                // this subscribe does not share the source subscription
+                // so that when it is unsubscribed the source will continue
+                auto sinkInner = make_subscriber<value_type>(
+                    state->out,
+                    innercs,
+                // on_next
+                    [state, index](auto&& ct) {
+                        auto key = on_exception(
+                            [&](){return state->key_selector(rxu::as_const(ct));},
+                            state->out);
+                        if (key.empty()) {
+                            return;
+                        }
+                        auto& inner = state->inners[index];
+                        inner.pending.emplace_back(std::move(key.get()), std::forward<decltype(ct)>(ct));
+                        if (inner.pending.size() == 1) {
+                            --state->waiting;
+                            state->push_heap(index);
+                            state->drain();
+                        }
+                    },
+                // on_error
+                    [state](rxu::error_ptr e) {
+                        state->out.on_error(e);
+                    },
+                //on_completed
+                    [state, index](){
+                        auto& inner = state->inners[index];
+                        inner.completed = true;
+                        --state->pendingCompletions;
+                        if (inner.pending.empty()) {
+                            --state->waiting;
+                        }
+                        state->drain();
+                    }
+                );
+
+                auto selectedSinkInner = state->coordinator.out(sinkInner);
+                selectedSource.subscribe(std::move(selectedSinkInner));
+            },
+        // on_error
+            [state](rxu::error_ptr e) {
+                state->out.on_error(e);
+            },
+        // on_completed
+            [state]() {
+                state->outerCompleted = true;
+                state->drain();
+            }
+        );
+        auto selectedSink = on_exception(
+            [&](){return state->coordinator.out(sink);},
+            state->out);
+        if (selectedSink.empty()) {
+            return;
+        }
+        source->subscribe(std::move(selectedSink.get()));
+    }
+};
+
+}
+
+/*! @copydoc rx-ordered_merge.hpp
+*/
+template<class... AN>
+auto ordered_merge(AN&&... an)
+    ->     operator_factory<ordered_merge_tag, AN...> {
+    return operator_factory<ordered_merge_tag, AN...>(std::make_tuple(std::forward<AN>(an)...));
+}
+
+}
+
+template<>
+struct member_overload<ordered_merge_tag>
+{
+    template<class Observable, class KeySelector,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            is_observable<rxu::value_type_t<Observable>>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class OrderedMerge = rxo::detail::ordered_merge<SourceValue, rxu::decay_t<Observable>, rxu::decay_t<KeySelector>, std::less<>, identity_one_worker>,
+        class Value = rxu::value_type_t<SourceValue>,
+        class Result = observable<Value, OrderedMerge>
+    >
+    static Result member(Observable&& o, KeySelector&& ks) {
+        return Result(OrderedMerge(std::forward<Observable>(o), std::forward<KeySelector>(ks), std::less<>(), identity_current_thread()));
+    }
+
+    template<class Observable, class KeySelector, class Comparator,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            is_observable<rxu::value_type_t<Observable>>,
+            rxu::negation<is_observable<Comparator>>,
+            rxu::negation<is_coordination<Comparator>>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class OrderedMerge = rxo::detail::ordered_merge<SourceValue, rxu::decay_t<Observable>, rxu::decay_t<KeySelector>, rxu::decay_t<Comparator>, identity_one_worker>,
+        class Value = rxu::value_type_t<SourceValue>,
+        class Result = observable<Value, OrderedMerge>
+    >
+    static Result member(Observable&& o, KeySelector&& ks, Comparator&& c) {
+        return Result(OrderedMerge(std::forward<Observable>(o), std::forward<KeySelector>(ks), std::forward<Comparator>(c), identity_current_thread()));
+    }
+
+    template<class Observable, class KeySelector, class Comparator, class Coordination,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            is_observable<rxu::value_type_t<Observable>>,
+            is_coordination<Coordination>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class OrderedMerge = rxo::detail::ordered_merge<SourceValue, rxu::decay_t<Observable>, rxu::decay_t<KeySelector>, rxu::decay_t<Comparator>, rxu::decay_t<Coordination>>,
+        class Value = rxu::value_type_t<SourceValue>,
+        class Result = observable<Value, OrderedMerge>
+    >
+    static Result member(Observable&& o, KeySelector&& ks, Comparator&& c, Coordination&& cn) {
+        return Result(OrderedMerge(std::forward<Observable>(o), std::forward<KeySelector>(ks), std::forward<Comparator>(c), std::forward<Coordination>(cn)));
+    }
+
+    template<class Observable, class KeySelector, class Value0, class... ValueN,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            all_observables<Observable, Value0, ValueN...>>,
+        class EmittedValue = rxu::value_type_t<Observable>,
+        class SourceValue = observable<EmittedValue>,
+        class ObservableObservable = observable<SourceValue>,
+        class OrderedMerge = typename rxu::defer_type<rxo::detail::ordered_merge, SourceValue, ObservableObservable, rxu::decay_t<KeySelector>, std::less<>, identity_one_worker>::type,
+        class Value = rxu::value_type_t<OrderedMerge>,
+        class Result = observable<Value, OrderedMerge>
+    >
+    static Result member(Observable&& o, KeySelector&& ks, Value0&& v0, ValueN&&... vn) {
+        return Result(OrderedMerge(rxs::from(o.as_dynamic(), v0.as_dynamic(), vn.as_dynamic()...), std::forward<KeySelector>(ks), std::less<>(), identity_current_thread()));
+    }
+
+    template<class Observable, class KeySelector, class Comparator, class Value0, class... ValueN,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            all_observables<Observable, Value0, ValueN...>,
+            rxu::negation<is_observable<Comparator>>>,
+        class EmittedValue = rxu::value_type_t<Observable>,
+        class SourceValue = observable<EmittedValue>,
+        class ObservableObservable = observable<SourceValue>,
+        class OrderedMerge = typename rxu::defer_type<rxo::detail::ordered_merge, SourceValue, ObservableObservable, rxu::decay_t<KeySelector>, rxu::decay_t<Comparator>, identity_one_worker>::type,
+        class Value = rxu::value_type_t<OrderedMerge>,
+        class Result = observable<Value, OrderedMerge>
+    >
+    static Result member(Observable&& o, KeySelector&& ks, Comparator&& c, Value0&& v0, ValueN&&... vn) {
+        return Result(OrderedMerge(rxs::from(o.as_dynamic(), v0.as_dynamic(), vn.as_dynamic()...), std::forward<KeySelector>(ks), std::forward<Comparator>(c), identity_current_thread()));
+    }
+
+    template<class Observable, class KeySelector, class Comparator, class Coordination, class Value0, class... ValueN,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            all_observables<Observable, Value0, ValueN...>,
+            is_coordination<Coordination>>,
+        class EmittedValue = rxu::value_type_t<Observable>,
+        class SourceValue = observable<EmittedValue>,
+        class ObservableObservable = observable<SourceValue>,
+        class OrderedMerge = typename rxu::defer_type<rxo::detail::ordered_merge, SourceValue, ObservableObservable, rxu::decay_t<KeySelector>, rxu::decay_t<Comparator>, rxu::decay_t<Coordination>>::type,
+        class Value = rxu::value_type_t<OrderedMerge>,
+        class Result = observable<Value, OrderedMerge>
+    >
+    static Result member(Observable&& o, KeySelector&& ks, Comparator&& c, Coordination&& cn, Value0&& v0, ValueN&&... vn) {
+        return Result(OrderedMerge(rxs::from(o.as_dynamic(), v0.as_dynamic(), vn.as_dynamic()...), std::forward<KeySelector>(ks), std::forward<Comparator>(c), std::forward<Coordination>(cn)));
+    }
+
+    template<class... AN>
+    static operators::detail::ordered_merge_invalid_t<AN...> member(AN...) {
+        std::terminate();
+        return {};
+        static_assert(sizeof...(AN) == 10000, "ordered_merge takes (KeySelector, optional Comparator, optional Coordination, optional Value0, optional ValueN...)");
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,346 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+/*! \file rx-parallel_reduce.hpp
+
+    \brief Split the items from this observable into chunks, reduce the chunks concurrently on the workers of a coordination and combine the partial results.
+
+    \tparam Seed          the type of the initial value for the accumulator.
+    \tparam Accumulator   the type of the function that adds an item to a partial result.
+    \tparam Combiner      the type of the function that combines two partial results.
+    \tparam Coordination  the type of the scheduler that provides the workers.
+
+    \param seed          the initial value for each chunk. seed must be an identity of combine, such as 0 for a sum.
+    \param a             an accumulator function that is called with a partial result and each item of a chunk.
+    \param c             an associative function that combines the partial results of two adjacent chunks.
+    \param coordination  the scheduler that provides the workers. It should be able to run work concurrently, such as observe_on_event_loop().
+    \param chunk         the number of items in each chunk (optional).
+
+    \return  An observable that emits a single item that is the combination of the partial results of all the chunks, in the order of the chunks.
+
+    The items of each chunk are collected on the thread that calls on_next. Each full chunk is handed to
+    one of up to std::thread::hardware_concurrency() workers, which are created from the coordination as they are needed.
+    Partial results are combined in order as soon as the chunks before them are done, so only the chunks that finish
+    out of order are kept.
+
+    \sample
+    \snippet parallel_reduce.cpp parallel_reduce sample
+    \snippet output.txt parallel_reduce sample
+*/
+
+#if !defined(RXCPP_OPERATORS_RX_PARALLEL_REDUCE_HPP)
+#define RXCPP_OPERATORS_RX_PARALLEL_REDUCE_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+namespace detail {
+
+template<class... AN>
+struct parallel_reduce_invalid_arguments {};
+
+template<class... AN>
+struct parallel_reduce_invalid : public rxo::operator_base<parallel_reduce_invalid_arguments<AN...>> {
+    using type = observable<parallel_reduce_invalid_arguments<AN...>, parallel_reduce_invalid<AN...>>;
+};
+template<class... AN>
+using parallel_reduce_invalid_t = typename parallel_reduce_invalid<AN...>::type;
+
+const int parallel_default_chunk = 4096;
+
+// hands work out to the workers of a coordination in turn.
+// a worker is created for each call until there is one per hardware thread.
+template<class Coordination>
+struct parallel_workers
+{
+    using coordination_type = rxu::decay_t<Coordination>;
+    using coordinator_type = typename coordination_type::coordinator_type;
+
+    parallel_workers(coordination_type cn, composite_subscription cs)
+        : coordination(std::move(cn))
+        , lifetime(std::move(cs))
+        , next(0)
+        , limit((std::max)(1u, std::thread::hardware_concurrency()))
+    {
+    }
+
+    template<class F>
+    void schedule(F f) {
+        auto selected = select();
+        auto action = selected.act(std::move(f));
+        selected.get_worker().schedule(action);
+    }
+
+    void unsubscribe() {
+        lifetime.unsubscribe();
+    }
+
+    coordinator_type select() {
+        std::unique_lock<std::mutex> guard(lock);
+        if (coordinators.size() < limit) {
+            composite_subscription cs;
+            lifetime.add(cs);
+            coordinators.push_back(coordination.create_coordinator(cs));
+        }
+        return coordinators[next++ % coordinators.size()];
+    }
+
+    coordination_type coordination;
+    composite_subscription lifetime;
+    std::mutex lock;
+    std::vector<coordinator_type> coordinators;
+    std::size_t next;
+    std::size_t limit;
+};
+
+template<class T, class Seed, class Accumulator, class Combiner, class Coordination>
+struct parallel_reduce
+{
+    using source_value_type = rxu::decay_t<T>;
+    using seed_type = rxu::decay_t<Seed>;
+    using accumulator_type = rxu::decay_t<Accumulator>;
+    using combiner_type = rxu::decay_t<Combiner>;
+    using coordination_type = rxu::decay_t<Coordination>;
+    using value_type = seed_type;
+
+    struct parallel_reduce_values
+    {
+        parallel_reduce_values(seed_type s, accumulator_type a, combiner_type c, coordination_type cn, int n)
+            : seed(std::move(s))
+            , accumulator(std::move(a))
+            , combiner(std::move(c))
+            , coordination(std::move(cn))
+            , chunk((std::max)(1, n))
+        {
+        }
+        seed_type seed;
+        accumulator_type accumulator;
+        combiner_type combiner;
+        coordination_type coordination;
+        int chunk;
+    };
+
+    parallel_reduce_values initial;
+
+    parallel_reduce(seed_type s, accumulator_type a, combiner_type c, coordination_type cn, int n)
+        : initial(std::move(s), std::move(a), std::move(c), std::move(cn), n)
+    {
+    }
+
+    template<class Subscriber>
+    struct parallel_reduce_observer
+    {
+        using this_type = parallel_reduce_observer<Subscriber>;
+        using dest_type = rxu::decay_t<Subscriber>;
+        using observer_type = observer<source_value_type, this_type>;
+
+        struct parallel_reduce_state : public std::enable_shared_from_this<parallel_reduce_state>, public parallel_reduce_values
+        {
+            parallel_reduce_state(parallel_reduce_values v, dest_type d, composite_subscription cs)
+                : parallel_reduce_values(std::move(v))
+                , dest(std::move(d))
+                , workers(this->coordination, std::move(cs))
+                , dispatched(0)
+                , combined(0)
+                , completed(false)
+                , done(false)
+            {
+                current.reserve(this->chunk);
+            }
+
+            // called on the thread that calls on_next
+            void dispatch() {
+                std::size_t index = 0;
+                {
+                    std::unique_lock<std::mutex> guard(lock);
+                    index = dispatched++;
+                    partials.emplace_back();
+                }
+                auto items = std::make_shared<std::vector<source_value_type>>(std::move(current));
+                current = std::vector<source_value_type>();
+                current.reserve(this->chunk);
+
+                auto state = this->shared_from_this();
+                auto work = [state, items, index](const rxsc::schedulable&){
+                    auto partial = on_exception(
+                        [&](){
+                            auto result = state->seed;
+                            for (auto& item : *items) {
+                                result = state->accumulator(std::move(result), item);
+                            }
+                            return result;
+                        },
+                        [&](rxu::error_ptr e){
+                            state->fail(e);
+                        });
+                    items->clear();
+                    if (!partial.empty()) {
+                        state->finish_chunk(index, std::move(partial.get()));
+                    }
+                };
+                on_exception(
+                    [&](){
+                        workers.schedule(work);
+                        return true;
+                    },
+                    [&](rxu::error_ptr e){
+                        fail(e);
+                    });
+            }
+
+            void finish_chunk(std::size_t index, seed_type partial) {
+                std::unique_lock<std::mutex> guard(lock);
+                if (done) {
+                    return;
+                }
+                partials[index - combined].reset(std::move(partial));
+                auto folded = on_exception(
+                    [&](){
+                        while (!partials.empty() && !partials.front().empty()) {
+                            if (accumulated.empty()) {
+                                accumulated.reset(std::move(partials.front().get()));
+                            } else {
+                                accumulated.reset(this->combiner(std::move(accumulated.get()), std::move(partials.front().get())));
+                            }
+                            partials.pop_front();
+                            ++combined;
+                        }
+                        return true;
+                    },
+                    [&](rxu::error_ptr e){
+                        guard.unlock();
+                        fail(e);
+                    });
+                if (folded.empty()) {
+                    return;
+                }
+                try_complete(guard);
+            }
+
+            // must be called with lock held, releases the lock
+            void try_complete(std::unique_lock<std::mutex>& guard) {
+                if (done || !completed || combined != dispatched) {
+                    return;
+                }
+                done = true;
+                auto result = accumulated.empty() ? this->seed : std::move(accumulated.get());
+                accumulated.reset();
+                guard.unlock();
+                dest.on_next(std::move(result));
+                dest.on_completed();
+                workers.unsubscribe();
+            }
+
+            void fail(rxu::error_ptr e) {
+                {
+                    std::unique_lock<std::mutex> guard(lock);
+                    if (done) {
+                        return;
+                    }
+                    done = true;
+                }
+                dest.on_error(e);
+                workers.unsubscribe();
+            }
+
+            dest_type dest;
+            parallel_workers<coordination_type> workers;
+            // only used on the thread that calls on_next
+            std::vector<source_value_type> current;
+
+            std::mutex lock;
+            std::size_t dispatched;
+            std::size_t combined;
+            // the partial results of the chunks after the last one combined
+            std::deque<rxu::maybe<seed_type>> partials;
+            rxu::maybe<seed_type> accumulated;
+            bool completed;
+            bool done;
+        };
+
+        std::shared_ptr<parallel_reduce_state> state;
+
+        explicit parallel_reduce_observer(std::shared_ptr<parallel_reduce_state> s)
+            : state(std::move(s))
+        {
+        }
+
+        void on_next(const source_value_type& v) const {
+            state->current.push_back(v);
+            if (int(state->current.size()) == state->chunk) {
+                state->dispatch();
+            }
+        }
+        void on_error(rxu::error_ptr e) const {
+            state->fail(e);
+        }
+        void on_completed() const {
+            if (!state->current.empty()) {
+                state->dispatch();
+            }
+            std::unique_lock<std::mutex> guard(state->lock);
+            state->completed = true;
+            state->try_complete(guard);
+        }
+
+        static subscriber<source_value_type, observer_type> make(dest_type d, parallel_reduce_values v) {
+            // the source is unsubscribed when it completes, before the chunks are done,
+            // so it does not share the subscription of the output
+            composite_subscription cs;
+            d.add(cs);
+            composite_subscription workers;
+            d.add(workers);
+            auto state = rxu::make_shared_state<parallel_reduce_state>(std::move(v), d, std::move(workers));
+            return make_subscriber<source_value_type>(std::move(cs), observer_type(this_type(std::move(state))));
+        }
+    };
+
+    template<class Subscriber>
+    auto operator()(Subscriber dest) const
+        -> decltype(parallel_reduce_observer<Subscriber>::make(std::move(dest), initial)) {
+        return      parallel_reduce_observer<Subscriber>::make(std::move(dest), initial);
+    }
+};
+
+}
+
+/*! @copydoc rx-parallel_reduce.hpp
+*/
+template<class... AN>
+auto parallel_reduce(AN&&... an)
+    ->      operator_factory<parallel_reduce_tag, AN...> {
+     return operator_factory<parallel_reduce_tag, AN...>(std::make_tuple(std::forward<AN>(an)...));
+}
+
+}
+
+template<>
+struct member_overload<parallel_reduce_tag>
+{
+    template<class Observable, class Seed, class Accumulator, class Combiner, class Coordination,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            is_coordination<Coordination>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class ParallelReduce = rxo::detail::parallel_reduce<SourceValue, rxu::decay_t<Seed>, rxu::decay_t<Accumulator>, rxu::decay_t<Combiner>, rxu::decay_t<Coordination>>,
+        class Value = rxu::value_type_t<ParallelReduce>>
+    static auto member(Observable&& o, Seed&& s, Accumulator&& a, Combiner&& c, Coordination&& cn, int chunk = rxo::detail::parallel_default_chunk)
+        -> decltype(o.template lift<Value>(ParallelReduce(std::forward<Seed>(s), std::forward<Accumulator>(a), std::forward<Combiner>(c), std::forward<Coordination>(cn), chunk))) {
+        return      o.template lift<Value>(ParallelReduce(std::forward<Seed>(s), std::forward<Accumulator>(a), std::forward<Combiner>(c), std::forward<Coordination>(cn), chunk));
+    }
+
+    template<class... AN>
+    static operators::detail::parallel_reduce_invalid_t<AN...> member(AN...) {
+        std::terminate();
+        return {};
+        static_assert(sizeof...(AN) == 10000, "parallel_reduce takes (Seed, Accumulator, Combiner, Coordination, optional Chunk)");
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,415 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+/*! \file rx-parallel_scan.hpp
+
+    \brief Split the items from this observable into chunks, scan the chunks concurrently on the workers of a coordination and emit the running results in order.
+
+    \tparam Seed          the type of the initial value for the accumulator.
+    \tparam Accumulator   the type of the function that adds an item to a running result.
+    \tparam Combiner      the type of the function that combines two running results.
+    \tparam Coordination  the type of the scheduler that provides the workers.
+
+    \param seed          the initial value for each chunk. seed must be an identity of combine, such as 0 for a sum.
+    \param a             an accumulator function that is called with a running result and each item of a chunk.
+    \param c             an associative function that combines the total of the earlier chunks with a running result of a later chunk.
+    \param coordination  the scheduler that provides the workers. It should be able to run work concurrently, such as observe_on_event_loop().
+    \param chunk         the number of items in each chunk (optional).
+
+    \return  An observable that emits, for each item, the combination of all the items up to and including it, in the order of the items.
+
+    Each chunk is scanned on its own from seed. Once the total of the earlier chunks is known, a second pass on a worker
+    combines it with every result of the chunk. The results are emitted in order by whichever thread finishes the next chunk.
+
+    \sample
+    \snippet parallel_scan.cpp parallel_scan sample
+    \snippet output.txt parallel_scan sample
+*/
+
+#if !defined(RXCPP_OPERATORS_RX_PARALLEL_SCAN_HPP)
+#define RXCPP_OPERATORS_RX_PARALLEL_SCAN_HPP
+
+#include "../rx-includes.hpp"
+#include "rx-parallel_reduce.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+namespace detail {
+
+template<class... AN>
+struct parallel_scan_invalid_arguments {};
+
+template<class... AN>
+struct parallel_scan_invalid : public rxo::operator_base<parallel_scan_invalid_arguments<AN...>> {
+    using type = observable<parallel_scan_invalid_arguments<AN...>, parallel_scan_invalid<AN...>>;
+};
+template<class... AN>
+using parallel_scan_invalid_t = typename parallel_scan_invalid<AN...>::type;
+
+template<class T, class Seed, class Accumulator, class Combiner, class Coordination>
+struct parallel_scan
+{
+    using source_value_type = rxu::decay_t<T>;
+    using seed_type = rxu::decay_t<Seed>;
+    using accumulator_type = rxu::decay_t<Accumulator>;
+    using combiner_type = rxu::decay_t<Combiner>;
+    using coordination_type = rxu::decay_t<Coordination>;
+    using value_type = seed_type;
+
+    struct parallel_scan_values
+    {
+        parallel_scan_values(seed_type s, accumulator_type a, combiner_type c, coordination_type cn, int n)
+            : seed(std::move(s))
+            , accumulator(std::move(a))
+            , combiner(std::move(c))
+            , coordination(std::move(cn))
+            , chunk((std::max)(1, n))
+        {
+        }
+        seed_type seed;
+        accumulator_type accumulator;
+        combiner_type combiner;
+        coordination_type coordination;
+        int chunk;
+    };
+
+    parallel_scan_values initial;
+
+    parallel_scan(seed_type s, accumulator_type a, combiner_type c, coordination_type cn, int n)
+        : initial(std::move(s), std::move(a), std::move(c), std::move(cn), n)
+    {
+    }
+
+    template<class Subscriber>
+    struct parallel_scan_observer
+    {
+        using this_type = parallel_scan_observer<Subscriber>;
+        using dest_type = rxu::decay_t<Subscriber>;
+        using observer_type = observer<source_value_type, this_type>;
+        using results_type = std::vector<seed_type>;
+
+        struct chunk_type
+        {
+            chunk_type()
+                : scanned(false)
+                , ready(false)
+            {
+            }
+            results_type results;
+            // the results are relative to the start of the chunk
+            bool scanned;
+            // the results include the total of the earlier chunks
+            bool ready;
+        };
+
+        struct parallel_scan_state : public std::enable_shared_from_this<parallel_scan_state>, public parallel_scan_values
+        {
+            parallel_scan_state(parallel_scan_values v, dest_type d, composite_subscription cs)
+                : parallel_scan_values(std::move(v))
+                , dest(std::move(d))
+                , workers(this->coordination, std::move(cs))
+                , dispatched(0)
+                , emitted(0)
+                , carried(0)
+                , completed(false)
+                , emitting(false)
+                , done(false)
+            {
+                current.reserve(this->chunk);
+            }
+
+            // called on the thread that calls on_next
+            void dispatch() {
+                std::size_t index = 0;
+                {
+                    std::unique_lock<std::mutex> guard(lock);
+                    index = dispatched++;
+                    chunks.emplace_back();
+                }
+                auto items = std::make_shared<std::vector<source_value_type>>(std::move(current));
+                current = std::vector<source_value_type>();
+                current.reserve(this->chunk);
+
+                auto state = this->shared_from_this();
+                schedule([state, items, index](const rxsc::schedulable&){
+                    auto results = on_exception(
+                        [&](){
+                            results_type results;
+                            results.reserve(items->size());
+                            auto result = state->seed;
+                            for (auto& item : *items) {
+                                result = state->accumulator(std::move(result), item);
+                                results.push_back(result);
+                            }
+                            return results;
+                        },
+                        [&](rxu::error_ptr e){
+                            state->fail(e);
+                        });
+                    items->clear();
+                    if (!results.empty()) {
+                        state->finish_scan(index, std::move(results.get()));
+                    }
+                });
+            }
+
+            template<class F>
+            void schedule(F f) {
+                on_exception(
+                    [&](){
+                        workers.schedule(std::move(f));
+                        return true;
+                    },
+                    [&](rxu::error_ptr e){
+                        fail(e);
+                    });
+            }
+
+            void finish_scan(std::size_t index, results_type results) {
+                std::vector<std::function<void(const rxsc::schedulable&)>> adjust;
+                rxu::maybe<rxu::error_ptr> failed;
+                {
+                    std::unique_lock<std::mutex> guard(lock);
+                    if (done) {
+                        return;
+                    }
+                    auto& c = chunks[index - emitted];
+                    c.results = std::move(results);
+                    c.scanned = true;
+
+                    // pass the total of the earlier chunks along to each chunk that has been scanned
+                    auto state = this->shared_from_this();
+                    auto carry = on_exception(
+                        [&](){
+                            while (carried - emitted < chunks.size() && chunks[carried - emitted].scanned) {
+                                auto carriedIndex = carried++;
+                                auto& next = chunks[carriedIndex - emitted];
+                                if (total.empty()) {
+                                    total.reset(next.results.back());
+                                    next.ready = true;
+                                    continue;
+                                }
+                                auto before = total.get();
+                                total.reset(this->combiner(before, next.results.back()));
+                                auto chunkResults = std::make_shared<results_type>(std::move(next.results));
+                                adjust.push_back([state, carriedIndex, before, chunkResults](const rxsc::schedulable&){
+                                    auto adjusted = on_exception(
+                                        [&](){
+                                            for (auto& result : *chunkResults) {
+                                                result = state->combiner(before, result);
+                                            }
+                                            return true;
+                                        },
+                                        [&](rxu::error_ptr e){
+                                            state->fail(e);
+                                        });
+                                    if (!adjusted.empty()) {
+                                        state->finish_adjust(carriedIndex, std::move(*chunkResults));
+                                    }
+                                });
+                            }
+                            return true;
+                        },
+                        [&](rxu::error_ptr e){
+                            failed.reset(e);
+                        });
+                    if (carry.empty()) {
+                        adjust.clear();
+                    } else {
+                        drain(guard);
+                    }
+                }
+                if (!failed.empty()) {
+                    fail(failed.get());
+                    return;
+                }
+                for (auto& a : adjust) {
+                    schedule(std::move(a));
+                }
+            }
+
+            void finish_adjust(std::size_t index, results_type results) {
+                std::unique_lock<std::mutex> guard(lock);
+                if (done) {
+                    return;
+                }
+                auto& c = chunks[index - emitted];
+                c.results = std::move(results);
+                c.ready = true;
+                drain(guard);
+            }
+
+            // must be called with lock held.
+            // emits the chunks that are ready, in order, on one thread at a time.
+            void drain(std::unique_lock<std::mutex>& guard) {
+                if (emitting) {
+                    return;
+                }
+                emitting = true;
+                for (;;) {
+                    if (done) {
+                        break;
+                    }
+                    if (!chunks.empty() && chunks.front().ready) {
+                        auto results = std::move(chunks.front().results);
+                        chunks.pop_front();
+                        ++emitted;
+                        guard.unlock();
+                        for (auto& result : results) {
+                            dest.on_next(std::move(result));
+                        }
+                        guard.lock();
+                        continue;
+                    }
+                    if (completed && emitted == dispatched) {
+                        done = true;
+                        guard.unlock();
+                        dest.on_completed();
+                        workers.unsubscribe();
+                        guard.lock();
+                    }
+                    break;
+                }
+                emitting = false;
+                if (!error.empty()) {
+                    guard.unlock();
+                    report();
+                    guard.lock();
+                }
+            }
+
+            void fail(rxu::error_ptr e) {
+                {
+                    std::unique_lock<std::mutex> guard(lock);
+                    if (done) {
+                        return;
+                    }
+                    done = true;
+                    error.reset(e);
+                    if (emitting) {
+                        // the emitting thread reports the error when it stops
+                        return;
+                    }
+                }
+                report();
+            }
+
+            void report() {
+                rxu::error_ptr e;
+                {
+                    std::unique_lock<std::mutex> guard(lock);
+                    if (error.empty() || emitting) {
+                        return;
+                    }
+                    e = error.get();
+                    error.reset();
+                    emitting = true;
+                }
+                dest.on_error(e);
+                workers.unsubscribe();
+            }
+
+            dest_type dest;
+            parallel_workers<coordination_type> workers;
+            // only used on the thread that calls on_next
+            std::vector<source_value_type> current;
+
+            std::mutex lock;
+            std::size_t dispatched;
+            // the index of the first chunk in chunks
+            std::size_t emitted;
+            // the index of the first chunk that is not included in total
+            std::size_t carried;
+            std::deque<chunk_type> chunks;
+            rxu::maybe<seed_type> total;
+            rxu::maybe<rxu::error_ptr> error;
+            bool completed;
+            bool emitting;
+            bool done;
+        };
+
+        std::shared_ptr<parallel_scan_state> state;
+
+        explicit parallel_scan_observer(std::shared_ptr<parallel_scan_state> s)
+            : state(std::move(s))
+        {
+        }
+
+        void on_next(const source_value_type& v) const {
+            state->current.push_back(v);
+            if (int(state->current.size()) == state->chunk) {
+                state->dispatch();
+            }
+        }
+        void on_error(rxu::error_ptr e) const {
+            state->fail(e);
+        }
+        void on_completed() const {
+            if (!state->current.empty()) {
+                state->dispatch();
+            }
+            std::unique_lock<std::mutex> guard(state->lock);
+            state->completed = true;
+            state->drain(guard);
+        }
+
+        static subscriber<source_value_type, observer_type> make(dest_type d, parallel_scan_values v) {
+            // the source is unsubscribed when it completes, before the chunks are done,
+            // so it does not share the subscription of the output
+            composite_subscription cs;
+            d.add(cs);
+            composite_subscription workers;
+            d.add(workers);
+            auto state = rxu::make_shared_state<parallel_scan_state>(std::move(v), d, std::move(workers));
+            return make_subscriber<source_value_type>(std::move(cs), observer_type(this_type(std::move(state))));
+        }
+    };
+
+    template<class Subscriber>
+    auto operator()(Subscriber dest) const
+        -> decltype(parallel_scan_observer<Subscriber>::make(std::move(dest), initial)) {
+        return      parallel_scan_observer<Subscriber>::make(std::move(dest), initial);
+    }
+};
+
+}
+
+/*! @copydoc rx-parallel_scan.hpp
+*/
+template<class... AN>
+auto parallel_scan(AN&&... an)
+    ->      operator_factory<parallel_scan_tag, AN...> {
+     return operator_factory<parallel_scan_tag, AN...>(std::make_tuple(std::forward<AN>(an)...));
+}
+
+}
+
+template<>
+struct member_overload<parallel_scan_tag>
+{
+    template<class Observable, class Seed, class Accumulator, class Combiner, class Coordination,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            is_coordination<Coordination>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class ParallelScan = rxo::detail::parallel_scan<SourceValue, rxu::decay_t<Seed>, rxu::decay_t<Accumulator>, rxu::decay_t<Combiner>, rxu::decay_t<Coordination>>,
+        class Value = rxu::value_type_t<ParallelScan>>
+    static auto member(Observable&& o, Seed&& s, Accumulator&& a, Combiner&& c, Coordination&& cn, int chunk = rxo::detail::parallel_default_chunk)
+        -> decltype(o.template lift<Value>(ParallelScan(std::forward<Seed>(s), std::forward<Accumulator>(a), std::forward<Combiner>(c), std::forward<Coordination>(cn), chunk))) {
+        return      o.template lift<Value>(ParallelScan(std::forward<Seed>(s), std::forward<Accumulator>(a), std::forward<Combiner>(c), std::forward<Coordination>(cn), chunk));
+    }
+
+    template<class... AN>
+    static operators::detail::parallel_scan_invalid_t<AN...> member(AN...) {
+        std::terminate();
+        return {};
+        static_assert(sizeof...(AN) == 10000, "parallel_scan takes (Seed, Accumulator, Combiner, Coordination, optional Chunk)");
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,470 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+/*! \file rx-partition.hpp
+
+    \brief Route each item from this observable to one of a fixed number of shards by the hash of its key, each shard emitting on its own worker.
+
+    \tparam KeyHash       the type of the function that returns the hash of the key of an item.
+    \tparam Coordination  the type of the scheduler that provides a worker for each shard (optional).
+
+    \param count         the number of shards, at least 1. The result fails with std::invalid_argument when it is subscribed with a smaller count.
+    \param key_hash      a function that returns the hash of the key of an item, as an integer. Items with the same hash go to the same shard.
+    \param coordination  the scheduler that provides a worker for each shard (optional). Use observe_on_event_loop() to run the shards on different threads.
+
+    \return  Observable that emits count grouped_observables, keyed by the shard index from 0 to count - 1.
+
+    The shards are emitted when the source emits its first item, or terminates, before any item is routed.
+    Each shard emits on a worker that is created for it from the coordination, so the items of a shard, and
+    the items of each key, keep their order, and any state used for one shard is only touched by one worker.
+
+    The thread that calls on_next hands the items to each shard through a single producer, single consumer
+    queue without a lock. A shard worker is only scheduled when its queue was idle.
+
+    Like group_by, the shards are hot. Items are dropped when they are routed to a shard that is not subscribed.
+
+    The result completes after every shard has completed. If the source fails, every shard and the result fail.
+
+    \sample
+    \snippet partition.cpp partition sample
+    \snippet output.txt partition sample
+*/
+
+#if !defined(RXCPP_OPERATORS_RX_PARTITION_HPP)
+#define RXCPP_OPERATORS_RX_PARTITION_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+namespace detail {
+
+template<class... AN>
+struct partition_invalid_arguments {};
+
+template<class... AN>
+struct partition_invalid : public rxo::operator_base<partition_invalid_arguments<AN...>> {
+    using type = observable<partition_invalid_arguments<AN...>, partition_invalid<AN...>>;
+};
+template<class... AN>
+using partition_invalid_t = typename partition_invalid<AN...>::type;
+
+template<class T, class KeyHash>
+struct is_partition_key_hash {
+    struct tag_not_valid {};
+    template<class CV, class CH>
+    static auto check(int) -> decltype((*(CH*)nullptr)(*(const CV*)nullptr));
+    template<class CV, class CH>
+    static tag_not_valid check(...);
+
+    static const bool value = std::is_integral<rxu::decay_t<decltype(check<rxu::decay_t<T>, rxu::decay_t<KeyHash>>(0))>>::value;
+};
+
+// an unbounded queue for one thread that pushes and one thread that pops.
+// the items are stored in blocks that are linked together. the consumer
+// hands an emptied block back to the producer so that a queue that keeps
+// up with the producer does not allocate.
+template<class T>
+class partition_queue
+{
+    static const std::size_t block_size = 256;
+
+    struct block
+    {
+        block()
+            : published(0)
+            , next(nullptr)
+        {
+        }
+        T* slot(std::size_t i) {
+            return reinterpret_cast<T*>(&slots[i]);
+        }
+        // the number of slots that the producer has filled
+        std::atomic<std::size_t> published;
+        std::atomic<block*> next;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type slots[block_size];
+    };
+
+    // only used by the producer
+    block* tail;
+    std::size_t tail_index;
+    // only used by the consumer
+    block* head;
+    std::size_t head_index;
+    std::atomic<block*> spare;
+
+    partition_queue(const partition_queue&) = delete;
+    partition_queue& operator=(const partition_queue&) = delete;
+
+public:
+    partition_queue()
+        : tail(new block())
+        , tail_index(0)
+        , head(tail)
+        , head_index(0)
+        , spare(nullptr)
+    {
+    }
+    ~partition_queue()
+    {
+        while (head != nullptr) {
+            auto published = head->published.load(std::memory_order_acquire);
+            for (; head_index != published; ++head_index) {
+                head->slot(head_index)->~T();
+            }
+            auto next = head->next.load(std::memory_order_acquire);
+            delete head;
+            head = next;
+            head_index = 0;
+        }
+        delete spare.load(std::memory_order_acquire);
+    }
+
+    // called by the producer
+    template<class U>
+    void push(U&& value) {
+        if (tail_index == block_size) {
+            auto next = spare.exchange(nullptr, std::memory_order_acquire);
+            if (next == nullptr) {
+                next = new block();
+            }
+            tail->next.store(next, std::memory_order_release);
+            tail = next;
+            tail_index = 0;
+        }
+        new (tail->slot(tail_index)) T(std::forward<U>(value));
+        tail->published.store(++tail_index, std::memory_order_release);
+    }
+
+    // called by the consumer
+    T* front() {
+        if (head_index == head->published.load(std::memory_order_acquire)) {
+            if (head_index != block_size) {
+                return nullptr;
+            }
+            auto next = head->next.load(std::memory_order_acquire);
+            if (next == nullptr) {
+                return nullptr;
+            }
+            auto emptied = head;
+            head = next;
+            head_index = 0;
+            emptied->published.store(0, std::memory_order_relaxed);
+            emptied->next.store(nullptr, std::memory_order_relaxed);
+            delete spare.exchange(emptied, std::memory_order_release);
+            if (head->published.load(std::memory_order_acquire) == 0) {
+                return nullptr;
+            }
+        }
+        return head->slot(head_index);
+    }
+
+    // called by the consumer after front() returned an item
+    void pop() {
+        head->slot(head_index)->~T();
+        ++head_index;
+    }
+};
+
+template<class T, class KeyHash, class Coordination>
+struct partition
+{
+    using source_value_type = rxu::decay_t<T>;
+    using key_hash_type = rxu::decay_t<KeyHash>;
+    using coordination_type = rxu::decay_t<Coordination>;
+    using coordinator_type = typename coordination_type::coordinator_type;
+    using shard_subject_type = rxsub::unicast<source_value_type>;
+    using value_type = grouped_observable<std::size_t, source_value_type>;
+
+    struct partition_values
+    {
+        partition_values(std::size_t c, key_hash_type kh, coordination_type cn)
+            : count(c)
+            , key_hash(std::move(kh))
+            , coordination(std::move(cn))
+        {
+        }
+        std::size_t count;
+        key_hash_type key_hash;
+        coordination_type coordination;
+    };
+    partition_values initial;
+
+    // a count below 1 is kept as 0 and reported by on_error when subscribed
+    template<class Count>
+    partition(Count count, key_hash_type kh, coordination_type cn)
+        : initial(count < 1 ? 0 : static_cast<std::size_t>(count), std::move(kh), std::move(cn))
+    {
+    }
+
+    struct shard_observable : public rxs::source_base<source_value_type>
+    {
+        shard_subject_type subject;
+        std::size_t key;
+
+        shard_observable(shard_subject_type s, std::size_t k)
+            : subject(std::move(s))
+            , key(k)
+        {
+        }
+
+        template<class Subscriber>
+        void on_subscribe(Subscriber&& o) const {
+            subject.get_observable().subscribe(std::forward<Subscriber>(o));
+        }
+
+        std::size_t on_get_key() {
+            return key;
+        }
+    };
+
+    template<class Subscriber>
+    struct partition_observer
+    {
+        using this_type = partition_observer<Subscriber>;
+        using dest_type = rxu::decay_t<Subscriber>;
+        using observer_type = observer<source_value_type, this_type>;
+
+        struct shard
+        {
+            shard(coordinator_type c, composite_subscription cs)
+                : lifetime(std::move(cs))
+                , coordinator(std::move(c))
+                , subject(lifetime)
+                , out(subject.get_subscriber())
+                , scheduled(false)
+            {
+            }
+            composite_subscription lifetime;
+            coordinator_type coordinator;
+            shard_subject_type subject;
+            typename shard_subject_type::subscriber_type out;
+            partition_queue<source_value_type> queue;
+            // true from the time a drain is scheduled until it finds the queue empty
+            std::atomic<bool> scheduled;
+        };
+
+        struct partition_state : public std::enable_shared_from_this<partition_state>, public partition_values
+        {
+            partition_state(dest_type d, partition_values v)
+                : partition_values(std::move(v))
+                , dest(std::move(d))
+                , emitted(false)
+                , stopped(false)
+                , pending(0)
+                , lifetimes(this->count)
+            {
+            }
+
+            // called on the thread that calls on_next
+            void emit_shards() {
+                if (emitted) {
+                    return;
+                }
+                emitted = true;
+                shards.reserve(this->count);
+                pending = this->count;
+                for (std::size_t i = 0; i != this->count; ++i) {
+                    auto& cs = lifetimes[i];
+                    shards.emplace_back(new shard(this->coordination.create_coordinator(cs), cs));
+                    dest.on_next(make_dynamic_grouped_observable<std::size_t, source_value_type>(shard_observable(shards.back()->subject, i)));
+                }
+            }
+
+            // called on the thread that calls on_next
+            template<class U>
+            void route(std::size_t index, U&& v) {
+                auto& s = *shards[index];
+                s.queue.push(std::forward<U>(v));
+                kick(index);
+            }
+
+            // called on the thread that calls on_next after the last item
+            void stop(rxu::error_ptr e) {
+                error = e;
+                stopped.store(true, std::memory_order_release);
+                for (std::size_t i = 0; i != shards.size(); ++i) {
+                    kick(i);
+                }
+            }
+
+            void kick(std::size_t index) {
+                auto& s = *shards[index];
+                if (s.scheduled.exchange(true, std::memory_order_acq_rel)) {
+                    return;
+                }
+                auto state = this->shared_from_this();
+                auto action = s.coordinator.act([state, index](const rxsc::schedulable&){
+                    state->drain(index);
+                });
+                s.coordinator.get_worker().schedule(action);
+            }
+
+            // called on the worker of the shard
+            void drain(std::size_t index) {
+                auto& s = *shards[index];
+                for (;;) {
+                    while (auto v = s.queue.front()) {
+                        s.out.on_next(std::move(*v));
+                        s.queue.pop();
+                    }
+                    if (stopped.load(std::memory_order_acquire) && s.queue.front() == nullptr) {
+                        finish(s);
+                        return;
+                    }
+                    s.scheduled.exchange(false, std::memory_order_acq_rel);
+                    // the producer may have pushed after the queue was found empty
+                    if (s.queue.front() == nullptr && !stopped.load(std::memory_order_acquire)) {
+                        return;
+                    }
+                    if (s.scheduled.exchange(true, std::memory_order_acq_rel)) {
+                        return;
+                    }
+                }
+            }
+
+            void finish(shard& s) {
+                if (error) {
+                    s.out.on_error(error);
+                } else {
+                    s.out.on_completed();
+                }
+                s.lifetime.unsubscribe();
+                if (--pending == 0) {
+                    if (error) {
+                        dest.on_error(error);
+                    } else {
+                        dest.on_completed();
+                    }
+                }
+            }
+
+            dest_type dest;
+            std::vector<std::unique_ptr<shard>> shards;
+            bool emitted;
+            // set after the last item has been routed
+            std::atomic<bool> stopped;
+            rxu::error_ptr error;
+            // the number of shards that have not completed
+            std::atomic<std::size_t> pending;
+            // the lifetime of each shard is created up front so that
+            // unsubscribe does not race with creating the shards
+            std::vector<composite_subscription> lifetimes;
+        };
+
+        std::shared_ptr<partition_state> state;
+
+        partition_observer(dest_type d, partition_values v)
+            : state(rxu::make_shared_state<partition_state>(std::move(d), std::move(v)))
+        {
+        }
+
+        template<typename U>
+        void on_next(U&& v) const {
+            if (state->stopped.load(std::memory_order_relaxed)) {
+                return;
+            }
+            state->emit_shards();
+            auto hash = on_exception(
+                [&](){return state->key_hash(rxu::as_const(v));},
+                [this](rxu::error_ptr e){on_error(e);});
+            if (hash.empty()) {
+                return;
+            }
+            state->route(static_cast<std::size_t>(hash.get()) % state->count, std::forward<U>(v));
+        }
+        void on_error(rxu::error_ptr e) const {
+            state->emit_shards();
+            state->stop(e);
+        }
+        void on_completed() const {
+            state->emit_shards();
+            state->stop(rxu::error_ptr());
+        }
+
+        static subscriber<source_value_type, observer_type> make(dest_type d, partition_values v) {
+            // the source is stopped when the result is unsubscribed, but the
+            // result is only completed after the shards have drained
+            composite_subscription cs;
+            d.add(cs);
+            auto o = this_type(d, std::move(v));
+            auto state = o.state;
+            if (state->count == 0) {
+                // there is no shard to route the items to
+                state->stopped = true;
+                cs.unsubscribe();
+                d.on_error(rxu::make_error_ptr(std::invalid_argument("partition count must be at least 1")));
+                return make_subscriber<source_value_type>(std::move(cs), std::move(o));
+            }
+            d.add([state](){
+                for (auto& lifetime : state->lifetimes) {
+                    lifetime.unsubscribe();
+                }
+            });
+            return make_subscriber<source_value_type>(std::move(cs), std::move(o));
+        }
+    };
+
+    template<class Subscriber>
+    auto operator()(Subscriber dest) const
+        -> decltype(partition_observer<Subscriber>::make(std::move(dest), initial)) {
+        return      partition_observer<Subscriber>::make(std::move(dest), initial);
+    }
+};
+
+}
+
+/*! @copydoc rx-partition.hpp
+*/
+template<class... AN>
+auto partition(AN&&... an)
+    ->      operator_factory<partition_tag, AN...> {
+     return operator_factory<partition_tag, AN...>(std::make_tuple(std::forward<AN>(an)...));
+}
+
+}
+
+template<>
+struct member_overload<partition_tag>
+{
+    template<class Observable, class Count, class KeyHash,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            std::is_integral<rxu::decay_t<Count>>,
+            operators::detail::is_partition_key_hash<SourceValue, KeyHash>>,
+        class Partition = rxo::detail::partition<SourceValue, rxu::decay_t<KeyHash>, identity_one_worker>,
+        class Value = typename Partition::value_type>
+    static auto member(Observable&& o, Count&& n, KeyHash&& kh)
+        -> decltype(o.template lift<Value>(Partition(n, std::forward<KeyHash>(kh), identity_current_thread()))) {
+        return      o.template lift<Value>(Partition(n, std::forward<KeyHash>(kh), identity_current_thread()));
+    }
+
+    template<class Observable, class Count, class KeyHash, class Coordination,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            std::is_integral<rxu::decay_t<Count>>,
+            operators::detail::is_partition_key_hash<SourceValue, KeyHash>,
+            is_coordination<Coordination>>,
+        class Partition = rxo::detail::partition<SourceValue, rxu::decay_t<KeyHash>, rxu::decay_t<Coordination>>,
+        class Value = typename Partition::value_type>
+    static auto member(Observable&& o, Count&& n, KeyHash&& kh, Coordination&& cn)
+        -> decltype(o.template lift<Value>(Partition(n, std::forward<KeyHash>(kh), std::forward<Coordination>(cn)))) {
+        return      o.template lift<Value>(Partition(n, std::forward<KeyHash>(kh), std::forward<Coordination>(cn)));
+    }
+
+    template<class... AN>
+    static operators::detail::partition_invalid_t<AN...> member(AN...) {
+        std::terminate();
+        return {};
+        static_assert(sizeof...(AN) == 10000, "partition takes (Count, KeyHash, optional Coordination), KeyHash takes (SourceValue) and returns an integer");
+    }
+};
+
+}
+
+#endif
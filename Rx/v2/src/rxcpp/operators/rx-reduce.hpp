@@ -157,7 +157,7 @@ struct reduce : public operator_base<rxu::value_type_t<reduce_traits<T, Observab
         private:
             reduce_state_type& operator=(reduce_state_type o) RXCPP_DELETE;
         };
-        auto state = std::make_shared<reduce_state_type>(initial, std::move(o));
+        auto state = rxu::make_shared_state<reduce_state_type>(initial, std::move(o));
         state->source.subscribe(
             state->out,
         // on_next
@@ -344,6 +344,149 @@ struct last {
     }
 };
 
+// a batch is an item that holds arithmetic values in one array, such as the
+// std::vector<T> emitted by buffer(). sum_all, average_all, min_all and max_all
+// reduce all the values in all the batches using the kernels in rx-util.hpp.
+// bool is excluded, std::vector<bool> does not store its values in an array.
+template<class T>
+struct is_batch_value : public std::integral_constant<bool, std::is_arithmetic<T>::value && !std::is_same<T, bool>::value> {};
+
+template<class Batch>
+struct is_arithmetic_batch : public std::false_type {};
+template<class T, class Allocator>
+struct is_arithmetic_batch<std::vector<T, Allocator>> : public is_batch_value<T> { using value_type = T; };
+template<class T, std::size_t Size>
+struct is_arithmetic_batch<std::array<T, Size>> : public is_batch_value<T> { using value_type = T; };
+template<class T>
+struct is_arithmetic_batch<rxu::pooled_buffer<T>> : public is_batch_value<T> { using value_type = T; };
+
+template<class Batch>
+struct sum_batch {
+    using value_type = typename is_arithmetic_batch<Batch>::value_type;
+    using seed_type = rxu::maybe<value_type>;
+    static seed_type seed() {
+        return seed_type();
+    }
+    seed_type operator()(seed_type a, const Batch& b) const {
+        if (b.size() == 0)
+            return a;
+        auto s = rxu::sum_of(b.data(), b.data() + b.size());
+        if (a.empty())
+            a.reset(s);
+        else
+            *a = *a + s;
+        return a;
+    }
+    value_type operator()(seed_type a) const {
+        if (a.empty())
+            rxu::throw_exception(rxcpp::empty_error("sum_all() requires a stream with at least one value"));
+        return *a;
+    }
+};
+
+template<class Batch>
+struct average_batch {
+    using value_type = typename is_arithmetic_batch<Batch>::value_type;
+    // integers are added as double so that the total does not overflow
+    using total_type = typename std::conditional<std::is_floating_point<value_type>::value, value_type, double>::type;
+    struct seed_type
+    {
+        seed_type()
+            : total()
+            , count(0)
+        {
+        }
+        total_type total;
+        std::size_t count;
+    };
+    static seed_type seed() {
+        return seed_type{};
+    }
+    seed_type operator()(seed_type a, const Batch& b) const {
+        a.total += rxu::sum_of<value_type, total_type>(b.data(), b.data() + b.size());
+        a.count += b.size();
+        return a;
+    }
+    double operator()(seed_type a) const {
+        if (a.count == 0)
+            rxu::throw_exception(rxcpp::empty_error("average_all() requires a stream with at least one value"));
+        return static_cast<double>(a.total) / a.count;
+    }
+};
+
+template<class Batch>
+struct max_batch {
+    using value_type = typename is_arithmetic_batch<Batch>::value_type;
+    using seed_type = rxu::maybe<value_type>;
+    static seed_type seed() {
+        return seed_type();
+    }
+    seed_type operator()(seed_type a, const Batch& b) const {
+        if (b.size() == 0)
+            return a;
+        auto m = rxu::max_of(b.data(), b.data() + b.size());
+        if (a.empty() || *a < m)
+            a.reset(m);
+        return a;
+    }
+    value_type operator()(seed_type a) const {
+        if (a.empty())
+            rxu::throw_exception(rxcpp::empty_error("max_all() requires a stream with at least one value"));
+        return *a;
+    }
+};
+
+template<class Batch>
+struct min_batch {
+    using value_type = typename is_arithmetic_batch<Batch>::value_type;
+    using seed_type = rxu::maybe<value_type>;
+    static seed_type seed() {
+        return seed_type();
+    }
+    seed_type operator()(seed_type a, const Batch& b) const {
+        if (b.size() == 0)
+            return a;
+        auto m = rxu::min_of(b.data(), b.data() + b.size());
+        if (a.empty() || m < *a)
+            a.reset(m);
+        return a;
+    }
+    value_type operator()(seed_type a) const {
+        if (a.empty())
+            rxu::throw_exception(rxcpp::empty_error("min_all() requires a stream with at least one value"));
+        return *a;
+    }
+};
+
+// the member overloads of sum_all, average_all, max_all and min_all, which only
+// differ in the Aggregator that reduces each batch
+template<template<class> class Aggregator>
+struct batch_reduce_overload
+{
+    template<class Observable,
+        class SValue = rxu::value_type_t<Observable>,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_arithmetic_batch<SValue>>,
+        class Operation = Aggregator<SValue>,
+        class Seed = decltype(Operation::seed()),
+        class Accumulator = Operation,
+        class ResultSelector = Operation,
+        class Reduce = reduce<SValue, rxu::decay_t<Observable>, rxu::decay_t<Accumulator>, rxu::decay_t<ResultSelector>, rxu::decay_t<Seed>>,
+        class RValue = rxu::value_type_t<Reduce>,
+        class Result = observable<RValue, Reduce>>
+    static Result member(Observable&& o)
+    {
+        return Result(Reduce(std::forward<Observable>(o), Operation{}, Operation{}, Operation::seed()));
+    }
+
+    template<class... AN>
+    static reduce_invalid_t<AN...> member(AN...) {
+        std::terminate();
+        return {};
+        static_assert(sizeof...(AN) == 10000, "sum_all, average_all, max_all and min_all require Observable::value_type to be a std::vector, std::array or rxu::pooled_buffer of arithmetic values");
+    }
+};
+
 }
 
 /*! @copydoc rx-reduce.hpp
@@ -497,6 +640,46 @@ inline auto max()
     return operator_factory<max_tag>(std::tuple<>{});
 }
 
+/*! \brief For each batch of arithmetic values from this observable, such as the std::vector<T> emitted by buffer(), add all the values.
+
+    \return  An observable that emits a single item: the sum of all the values in all the batches emitted by the source observable.
+
+    \sample
+    \snippet math.cpp sum_all sample
+    \snippet output.txt sum_all sample
+*/
+inline auto sum_all()
+    ->     operator_factory<sum_all_tag> {
+    return operator_factory<sum_all_tag>(std::tuple<>{});
+}
+
+/*! \brief For each batch of arithmetic values from this observable, such as the std::vector<T> emitted by buffer(), average all the values.
+
+    \return  An observable that emits a single item: the average of all the values in all the batches emitted by the source observable.
+*/
+inline auto average_all()
+    ->     operator_factory<average_all_tag> {
+    return operator_factory<average_all_tag>(std::tuple<>{});
+}
+
+/*! \brief For each batch of arithmetic values from this observable, such as the std::vector<T> emitted by buffer(), take the min of all the values.
+
+    \return  An observable that emits a single item: the min of all the values in all the batches emitted by the source observable.
+*/
+inline auto min_all()
+    ->     operator_factory<min_all_tag> {
+    return operator_factory<min_all_tag>(std::tuple<>{});
+}
+
+/*! \brief For each batch of arithmetic values from this observable, such as the std::vector<T> emitted by buffer(), take the max of all the values.
+
+    \return  An observable that emits a single item: the max of all the values in all the batches emitted by the source observable.
+*/
+inline auto max_all()
+    ->     operator_factory<max_all_tag> {
+    return operator_factory<max_all_tag>(std::tuple<>{});
+}
+
 }
 
 template<>
@@ -681,6 +864,26 @@ struct member_overload<min_tag>
     }
 };
 
+template<>
+struct member_overload<sum_all_tag> : public operators::detail::batch_reduce_overload<operators::detail::sum_batch>
+{
+};
+
+template<>
+struct member_overload<average_all_tag> : public operators::detail::batch_reduce_overload<operators::detail::average_batch>
+{
+};
+
+template<>
+struct member_overload<max_all_tag> : public operators::detail::batch_reduce_overload<operators::detail::max_batch>
+{
+};
+
+template<>
+struct member_overload<min_all_tag> : public operators::detail::batch_reduce_overload<operators::detail::min_batch>
+{
+};
+
 }
 
 #endif
@@ -128,7 +128,7 @@ struct ref_count : public operator_base<T>
               class Enabled = rxu::enable_if_all_true_type_t<
                   rxu::negation<HasObservable>>>
     explicit ref_count(connectable_type source)
-        : state(std::make_shared<ref_count_state>(std::move(source)))
+        : state(rxu::make_shared_state<ref_count_state>(std::move(source)))
     {
     }
 
@@ -140,7 +140,7 @@ struct ref_count : public operator_base<T>
     template <bool HasObservableV = has_observable_v>
     ref_count(connectable_type other,
               typename std::enable_if<HasObservableV, observable_type>::type source)
-        : state(std::make_shared<ref_count_state>(std::move(other), std::move(source)))
+        : state(rxu::make_shared_state<ref_count_state>(std::move(other), std::move(source)))
     {
     }
 
@@ -94,7 +94,7 @@ namespace rxcpp {
           void on_subscribe(const Subscriber& s) const {
               using state_t = state_type<values, Subscriber, EventHandlers, T>;
             // take a copy of the values for each subscription
-            auto state = std::make_shared<state_t>(initial_, s);      
+            auto state = rxu::make_shared_state<state_t>(initial_, s);      
             if (initial_.completed_predicate()) {
               // return completed
               state->out.on_completed();
@@ -137,7 +137,7 @@ namespace rxcpp {
           void on_subscribe(const Subscriber& s) const {
               using state_t = state_type<values, Subscriber, EventHandlers, T>;
             // take a copy of the values for each subscription
-            auto state = std::make_shared<state_t>(initial_, s);
+            auto state = rxu::make_shared_state<state_t>(initial_, s);
             // start the first iteration
             state->do_subscribe();
           }
@@ -92,7 +92,7 @@ struct sample_with_time
         std::shared_ptr<sample_with_time_subscriber_value> state;
 
         sample_with_time_observer(composite_subscription cs, dest_type d, sample_with_time_value v, coordinator_type c)
-            : state(std::make_shared<sample_with_time_subscriber_value>(sample_with_time_subscriber_value(std::move(cs), std::move(d), v, std::move(c))))
+            : state(rxu::make_shared_state<sample_with_time_subscriber_value>(sample_with_time_subscriber_value(std::move(cs), std::move(d), v, std::move(c))))
         {
             auto localState = state;
 
@@ -0,0 +1,579 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+/*! \file rx-sliding_aggregate.hpp
+
+    \brief Return an observable that emits the aggregate of each sliding window over this observable.
+           The windows are the same as the buffers of buffer(count, skip) or buffer_with_time(period, skip),
+           but the aggregate is maintained incrementally instead of being recomputed from a copy of each window.
+
+    \tparam Monoid        the type of the monoid that combines the items.
+    \tparam Coordination  the type of the scheduler (optional, time windows only).
+
+    \param count         the number of items in each window.
+    \param slide         how many items to skip before starting a new window.
+    \param period        the period of time each window collects items before its aggregate is emitted.
+    \param skip          the period of time after which a new window is started.
+    \param monoid        an object with identity() returning the aggregate of an empty window and
+                         combine(a, b) returning the aggregate of a followed by b. combine must be associative
+                         but does not need to be invertible or commutative, so min and max work as well as sum.
+    \param coordination  the scheduler for the windows (optional, time windows only).
+
+    \return  Observable that emits the aggregate of each window.
+
+    The windows are kept in a two-stacks queue: adding an item, removing the oldest item and reading the
+    aggregate each take amortized O(1) calls to combine, whatever the size of the window.
+
+    make_monoid(identity, combine) builds a monoid from a value and a function. sum_monoid<T>(), min_monoid<T>()
+    and max_monoid<T>() cover the common cases. Items are converted to the type returned by identity() before they
+    are combined, so map the source first for aggregates such as a volume weighted average.
+
+    \sample
+    \snippet sliding_aggregate.cpp sliding_aggregate count sample
+    \snippet output.txt sliding_aggregate count sample
+
+    \sample
+    \snippet sliding_aggregate.cpp sliding_aggregate min sample
+    \snippet output.txt sliding_aggregate min sample
+*/
+
+#if !defined(RXCPP_OPERATORS_RX_SLIDING_AGGREGATE_HPP)
+#define RXCPP_OPERATORS_RX_SLIDING_AGGREGATE_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+template<class T, class Combine>
+struct function_monoid
+{
+    using value_type = T;
+
+    function_monoid(value_type i, Combine c)
+        : seed(std::move(i))
+        , combiner(std::move(c))
+    {
+    }
+    value_type identity() const {
+        return seed;
+    }
+    value_type combine(const value_type& a, const value_type& b) const {
+        return combiner(a, b);
+    }
+    value_type seed;
+    Combine combiner;
+};
+
+template<class T, class Combine>
+auto make_monoid(T&& identity, Combine&& combine)
+    ->      function_monoid<rxu::decay_t<T>, rxu::decay_t<Combine>> {
+    return  function_monoid<rxu::decay_t<T>, rxu::decay_t<Combine>>(std::forward<T>(identity), std::forward<Combine>(combine));
+}
+
+template<class T>
+struct sum_monoid_type
+{
+    using value_type = T;
+    value_type identity() const {
+        return value_type();
+    }
+    value_type combine(const value_type& a, const value_type& b) const {
+        return a + b;
+    }
+};
+
+template<class T>
+struct min_monoid_type
+{
+    using value_type = T;
+    value_type identity() const {
+        return (std::numeric_limits<value_type>::max)();
+    }
+    value_type combine(const value_type& a, const value_type& b) const {
+        return b < a ? b : a;
+    }
+};
+
+template<class T>
+struct max_monoid_type
+{
+    using value_type = T;
+    value_type identity() const {
+        return std::numeric_limits<value_type>::lowest();
+    }
+    value_type combine(const value_type& a, const value_type& b) const {
+        return a < b ? b : a;
+    }
+};
+
+template<class T>
+sum_monoid_type<T> sum_monoid() {
+    return sum_monoid_type<T>();
+}
+
+template<class T>
+min_monoid_type<T> min_monoid() {
+    return min_monoid_type<T>();
+}
+
+template<class T>
+max_monoid_type<T> max_monoid() {
+    return max_monoid_type<T>();
+}
+
+namespace operators {
+
+namespace detail {
+
+template<class... AN>
+struct sliding_aggregate_invalid_arguments {};
+
+template<class... AN>
+struct sliding_aggregate_invalid : public rxo::operator_base<sliding_aggregate_invalid_arguments<AN...>> {
+    using type = observable<sliding_aggregate_invalid_arguments<AN...>, sliding_aggregate_invalid<AN...>>;
+};
+template<class... AN>
+using sliding_aggregate_invalid_t = typename sliding_aggregate_invalid<AN...>::type;
+
+template<class Monoid>
+using monoid_value_t = rxu::decay_t<decltype(std::declval<const Monoid&>().identity())>;
+
+// a fifo queue that maintains the aggregate of its items.
+// items are pushed onto the back stack which keeps a running aggregate.
+// when the front stack is empty, pop() moves the back stack over and stores
+// the suffix aggregates so that the oldest item can be dropped without recomputing.
+template<class Monoid>
+struct sliding_aggregator
+{
+    using monoid_type = rxu::decay_t<Monoid>;
+    using value_type = monoid_value_t<monoid_type>;
+
+    explicit sliding_aggregator(monoid_type m)
+        : monoid(std::move(m))
+        , back_aggregate(monoid.identity())
+    {
+    }
+
+    std::size_t size() const {
+        return front.size() + back.size();
+    }
+    bool empty() const {
+        return front.empty() && back.empty();
+    }
+
+    template<class U>
+    void push(U&& u) {
+        back.push_back(value_type(std::forward<U>(u)));
+        back_aggregate = monoid.combine(back_aggregate, back.back());
+    }
+
+    void pop() {
+        if (front.empty()) {
+            auto aggregate = monoid.identity();
+            for (auto it = back.rbegin(); it != back.rend(); ++it) {
+                aggregate = monoid.combine(*it, aggregate);
+                front.push_back(aggregate);
+            }
+            back.clear();
+            back_aggregate = monoid.identity();
+        }
+        front.pop_back();
+    }
+
+    void clear() {
+        front.clear();
+        back.clear();
+        back_aggregate = monoid.identity();
+    }
+
+    value_type aggregate() const {
+        if (front.empty()) {
+            return back_aggregate;
+        }
+        return monoid.combine(front.back(), back_aggregate);
+    }
+
+    monoid_type monoid;
+    // aggregates of the suffixes of the older items, the oldest is at the back
+    std::vector<value_type> front;
+    // the newer items, the newest is at the back
+    std::vector<value_type> back;
+    value_type back_aggregate;
+};
+
+template<class T, class Monoid>
+struct sliding_aggregate_count
+{
+    using source_value_type = rxu::decay_t<T>;
+    using monoid_type = rxu::decay_t<Monoid>;
+    using value_type = monoid_value_t<monoid_type>;
+
+    struct sliding_aggregate_count_values
+    {
+        sliding_aggregate_count_values(int c, int s, monoid_type m)
+            : count(c)
+            , slide(s)
+            , monoid(std::move(m))
+        {
+        }
+        int count;
+        int slide;
+        monoid_type monoid;
+    };
+
+    sliding_aggregate_count_values initial;
+
+    sliding_aggregate_count(int count, int slide, monoid_type m)
+        : initial(count, slide, std::move(m))
+    {
+    }
+
+    template<class Subscriber>
+    struct sliding_aggregate_count_observer : public sliding_aggregate_count_values
+    {
+        using this_type = sliding_aggregate_count_observer<Subscriber>;
+        using value_type = monoid_value_t<monoid_type>;
+        using dest_type = rxu::decay_t<Subscriber>;
+        using observer_type = observer<source_value_type, this_type>;
+        dest_type dest;
+        // the items of the oldest open window and the windows after it
+        mutable sliding_aggregator<monoid_type> window;
+        // the position of the next item relative to the start of a window when slide > count
+        mutable int cursor;
+
+        sliding_aggregate_count_observer(dest_type d, sliding_aggregate_count_values v)
+            : sliding_aggregate_count_values(v)
+            , dest(std::move(d))
+            , window(v.monoid)
+            , cursor(0)
+        {
+            window.front.reserve(v.count);
+            window.back.reserve(v.count);
+        }
+
+        void drop_window() const {
+            if (this->slide >= this->count) {
+                window.clear();
+                return;
+            }
+            for (int i = 0; i < this->slide && !window.empty(); ++i) {
+                window.pop();
+            }
+        }
+
+        void on_next(const source_value_type& v) const {
+            if (this->slide > this->count) {
+                // items between the windows are not in any window
+                auto position = cursor;
+                cursor = (cursor + 1) % this->slide;
+                if (position >= this->count) {
+                    return;
+                }
+            }
+            window.push(v);
+            if (int(window.size()) == this->count) {
+                dest.on_next(window.aggregate());
+                drop_window();
+            }
+        }
+        void on_error(rxu::error_ptr e) const {
+            dest.on_error(e);
+        }
+        void on_completed() const {
+            auto done = on_exception(
+                [&](){
+                    while (!window.empty()) {
+                        dest.on_next(window.aggregate());
+                        drop_window();
+                    }
+                    return true;
+                },
+                dest);
+            if (done.empty()) {
+                return;
+            }
+            dest.on_completed();
+        }
+
+        static subscriber<source_value_type, observer_type> make(dest_type d, sliding_aggregate_count_values v) {
+            auto cs = d.get_subscription();
+            return make_subscriber<source_value_type>(std::move(cs), observer_type(this_type(std::move(d), std::move(v))));
+        }
+    };
+
+    template<class Subscriber>
+    auto operator()(Subscriber dest) const
+        -> decltype(sliding_aggregate_count_observer<Subscriber>::make(std::move(dest), initial)) {
+        return      sliding_aggregate_count_observer<Subscriber>::make(std::move(dest), initial);
+    }
+};
+
+template<class T, class Duration, class Monoid, class Coordination>
+struct sliding_aggregate_time
+{
+    using source_value_type = rxu::decay_t<T>;
+    using monoid_type = rxu::decay_t<Monoid>;
+    using value_type = monoid_value_t<monoid_type>;
+    using coordination_type = rxu::decay_t<Coordination>;
+    using coordinator_type = typename coordination_type::coordinator_type;
+    using duration_type = rxu::decay_t<Duration>;
+
+    struct sliding_aggregate_time_values
+    {
+        sliding_aggregate_time_values(duration_type p, duration_type s, monoid_type m, coordination_type c)
+            : period(p)
+            , skip(s)
+            , monoid(std::move(m))
+            , coordination(c)
+        {
+        }
+        duration_type period;
+        duration_type skip;
+        monoid_type monoid;
+        coordination_type coordination;
+    };
+    sliding_aggregate_time_values initial;
+
+    sliding_aggregate_time(duration_type period, duration_type skip, monoid_type m, coordination_type coordination)
+        : initial(period, skip, std::move(m), coordination)
+    {
+    }
+
+    template<class Subscriber>
+    struct sliding_aggregate_time_observer
+    {
+        using this_type = sliding_aggregate_time_observer<Subscriber>;
+        using value_type = monoid_value_t<monoid_type>;
+        using dest_type = rxu::decay_t<Subscriber>;
+        using observer_type = observer<source_value_type, this_type>;
+
+        struct sliding_aggregate_time_subscriber_values : public sliding_aggregate_time_values
+        {
+            sliding_aggregate_time_subscriber_values(composite_subscription cs, dest_type d, sliding_aggregate_time_values v, coordinator_type c)
+                : sliding_aggregate_time_values(v)
+                , cs(std::move(cs))
+                , dest(std::move(d))
+                , coordinator(std::move(c))
+                , worker(coordinator.get_worker())
+                , window(this->monoid)
+                , pushed(0)
+                , expected(worker.now())
+            {
+            }
+            composite_subscription cs;
+            dest_type dest;
+            coordinator_type coordinator;
+            rxsc::worker worker;
+            // the items of the oldest open window and the windows after it
+            sliding_aggregator<monoid_type> window;
+            // the number of items pushed into window before each open window started
+            rxu::ring_buffer<std::size_t> starts;
+            std::size_t pushed;
+            rxsc::scheduler::clock_type::time_point expected;
+
+            void produce() {
+                dest.on_next(window.aggregate());
+                auto first = starts.front();
+                starts.pop_front();
+                auto next = starts.empty() ? pushed : starts.front();
+                for (; first != next; ++first) {
+                    window.pop();
+                }
+            }
+        };
+        std::shared_ptr<sliding_aggregate_time_subscriber_values> state;
+
+        sliding_aggregate_time_observer(composite_subscription cs, dest_type d, sliding_aggregate_time_values v, coordinator_type c)
+            : state(rxu::make_shared_state<sliding_aggregate_time_subscriber_values>(sliding_aggregate_time_subscriber_values(std::move(cs), std::move(d), v, std::move(c))))
+        {
+            auto localState = state;
+
+            auto disposer = [=](const rxsc::schedulable&){
+                localState->cs.unsubscribe();
+                localState->dest.unsubscribe();
+                localState->worker.unsubscribe();
+            };
+            auto selectedDisposer = on_exception(
+                [&](){return localState->coordinator.act(disposer);},
+                localState->dest);
+            if (selectedDisposer.empty()) {
+                return;
+            }
+
+            localState->dest.add([=](){
+                localState->worker.schedule(selectedDisposer.get());
+            });
+            localState->cs.add([=](){
+                localState->worker.schedule(selectedDisposer.get());
+            });
+
+            //
+            // The scheduler is FIFO for any time T. Since the observer is scheduling
+            // on_next/on_error/oncompleted the timed schedule calls must be resheduled
+            // when they occur to ensure that production happens after on_next/on_error/oncompleted
+            //
+
+            auto produce_aggregate = [localState](const rxsc::schedulable&) {
+                localState->produce();
+            };
+            auto selectedProduce = on_exception(
+                [&](){return localState->coordinator.act(produce_aggregate);},
+                localState->dest);
+            if (selectedProduce.empty()) {
+                return;
+            }
+
+            auto create_window = [localState, selectedProduce](const rxsc::schedulable&) {
+                localState->starts.push_back(localState->pushed);
+                auto produce_at = localState->expected + localState->period;
+                localState->expected += localState->skip;
+                localState->worker.schedule(produce_at, [localState, selectedProduce](const rxsc::schedulable&) {
+                    localState->worker.schedule(selectedProduce.get());
+                });
+            };
+            auto selectedCreate = on_exception(
+                [&](){return localState->coordinator.act(create_window);},
+                localState->dest);
+            if (selectedCreate.empty()) {
+                return;
+            }
+
+            state->worker.schedule_periodically(
+                state->expected,
+                state->skip,
+                [localState, selectedCreate](const rxsc::schedulable&) {
+                    localState->worker.schedule(selectedCreate.get());
+                });
+        }
+        void on_next(const source_value_type& v) const {
+            auto localState = state;
+            auto work = [v, localState](const rxsc::schedulable&){
+                // items between the windows are not in any window
+                if (localState->starts.empty()) {
+                    return;
+                }
+                localState->window.push(v);
+                ++localState->pushed;
+            };
+            auto selectedWork = on_exception(
+                [&](){return localState->coordinator.act(work);},
+                localState->dest);
+            if (selectedWork.empty()) {
+                return;
+            }
+            localState->worker.schedule(selectedWork.get());
+        }
+        void on_error(rxu::error_ptr e) const {
+            auto localState = state;
+            auto work = [e, localState](const rxsc::schedulable&){
+                localState->dest.on_error(e);
+            };
+            auto selectedWork = on_exception(
+                [&](){return localState->coordinator.act(work);},
+                localState->dest);
+            if (selectedWork.empty()) {
+                return;
+            }
+            localState->worker.schedule(selectedWork.get());
+        }
+        void on_completed() const {
+            auto localState = state;
+            auto work = [localState](const rxsc::schedulable&){
+                on_exception(
+                    [&](){
+                        while (!localState->starts.empty()) {
+                            localState->produce();
+                        }
+                        return true;
+                    },
+                    localState->dest);
+                localState->dest.on_completed();
+            };
+            auto selectedWork = on_exception(
+                [&](){return localState->coordinator.act(work);},
+                localState->dest);
+            if (selectedWork.empty()) {
+                return;
+            }
+            localState->worker.schedule(selectedWork.get());
+        }
+
+        static subscriber<source_value_type, observer_type> make(dest_type d, sliding_aggregate_time_values v) {
+            auto cs = composite_subscription();
+            auto coordinator = v.coordination.create_coordinator();
+
+            return make_subscriber<source_value_type>(cs, observer_type(this_type(cs, std::move(d), std::move(v), std::move(coordinator))));
+        }
+    };
+
+    template<class Subscriber>
+    auto operator()(Subscriber dest) const
+        -> decltype(sliding_aggregate_time_observer<Subscriber>::make(std::move(dest), initial)) {
+        return      sliding_aggregate_time_observer<Subscriber>::make(std::move(dest), initial);
+    }
+};
+
+}
+
+/*! @copydoc rx-sliding_aggregate.hpp
+*/
+template<class... AN>
+auto sliding_aggregate(AN&&... an)
+    ->      operator_factory<sliding_aggregate_tag, AN...> {
+     return operator_factory<sliding_aggregate_tag, AN...>(std::make_tuple(std::forward<AN>(an)...));
+}
+
+}
+
+template<>
+struct member_overload<sliding_aggregate_tag>
+{
+    template<class Observable, class Count, class Monoid,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            std::is_integral<Count>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class SlidingAggregate = rxo::detail::sliding_aggregate_count<SourceValue, rxu::decay_t<Monoid>>,
+        class Value = rxu::value_type_t<SlidingAggregate>>
+    static auto member(Observable&& o, Count count, Count slide, Monoid&& m)
+        -> decltype(o.template lift<Value>(SlidingAggregate(count, slide, std::forward<Monoid>(m)))) {
+        return      o.template lift<Value>(SlidingAggregate(count, slide, std::forward<Monoid>(m)));
+    }
+
+    template<class Observable, class Duration, class Monoid,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            std::is_convertible<Duration, rxsc::scheduler::clock_type::duration>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class SlidingAggregate = rxo::detail::sliding_aggregate_time<SourceValue, rxu::decay_t<Duration>, rxu::decay_t<Monoid>, identity_one_worker>,
+        class Value = rxu::value_type_t<SlidingAggregate>>
+    static auto member(Observable&& o, Duration&& period, Duration&& skip, Monoid&& m)
+        -> decltype(o.template lift<Value>(SlidingAggregate(std::forward<Duration>(period), std::forward<Duration>(skip), std::forward<Monoid>(m), identity_current_thread()))) {
+        return      o.template lift<Value>(SlidingAggregate(std::forward<Duration>(period), std::forward<Duration>(skip), std::forward<Monoid>(m), identity_current_thread()));
+    }
+
+    template<class Observable, class Duration, class Monoid, class Coordination,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            std::is_convertible<Duration, rxsc::scheduler::clock_type::duration>,
+            is_coordination<Coordination>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class SlidingAggregate = rxo::detail::sliding_aggregate_time<SourceValue, rxu::decay_t<Duration>, rxu::decay_t<Monoid>, rxu::decay_t<Coordination>>,
+        class Value = rxu::value_type_t<SlidingAggregate>>
+    static auto member(Observable&& o, Duration&& period, Duration&& skip, Monoid&& m, Coordination&& cn)
+        -> decltype(o.template lift<Value>(SlidingAggregate(std::forward<Duration>(period), std::forward<Duration>(skip), std::forward<Monoid>(m), std::forward<Coordination>(cn)))) {
+        return      o.template lift<Value>(SlidingAggregate(std::forward<Duration>(period), std::forward<Duration>(skip), std::forward<Monoid>(m), std::forward<Coordination>(cn)));
+    }
+
+    template<class... AN>
+    static operators::detail::sliding_aggregate_invalid_t<AN...> member(AN...) {
+        std::terminate();
+        return {};
+        static_assert(sizeof...(AN) == 10000, "sliding_aggregate takes (Count, Count, Monoid) or (Duration, Duration, Monoid, optional Coordination)");
+    }
+};
+
+}
+
+#endif
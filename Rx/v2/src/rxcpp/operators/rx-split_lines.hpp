@@ -0,0 +1,77 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+/*! \file rx-split_lines.hpp
+
+    \brief Split a stream of byte chunks into lines.
+
+    \return  Observable that emits an rxcpp::util::shared_view for each line, without the "\n" or "\r\n" that ends it.
+
+    split_lines() is split_records('\n') that also removes a '\r' at the end of each line.
+    The lines are views into the chunks, so they are only copied when a line spans chunks that are not adjacent in memory.
+
+    \sample
+    \snippet split_records.cpp split_lines sample
+    \snippet output.txt split_lines sample
+*/
+
+#if !defined(RXCPP_OPERATORS_RX_SPLIT_LINES_HPP)
+#define RXCPP_OPERATORS_RX_SPLIT_LINES_HPP
+
+#include "../rx-includes.hpp"
+#include "rx-split_records.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+namespace detail {
+
+template<class... AN>
+struct split_lines_invalid_arguments {};
+
+template<class... AN>
+struct split_lines_invalid : public rxo::operator_base<split_lines_invalid_arguments<AN...>> {
+    using type = observable<split_lines_invalid_arguments<AN...>, split_lines_invalid<AN...>>;
+};
+template<class... AN>
+using split_lines_invalid_t = typename split_lines_invalid<AN...>::type;
+
+}
+
+/*! @copydoc rx-split_lines.hpp
+*/
+template<class... AN>
+auto split_lines(AN&&... an)
+    ->      operator_factory<split_lines_tag, AN...> {
+     return operator_factory<split_lines_tag, AN...>(std::make_tuple(std::forward<AN>(an)...));
+}
+
+}
+
+template<>
+struct member_overload<split_lines_tag>
+{
+    template<class Observable,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            operators::detail::is_splittable<SourceValue>>,
+        class SplitRecords = rxo::detail::split_records<SourceValue>>
+    static auto member(Observable&& o)
+        -> decltype(o.template lift<rxu::shared_view>(SplitRecords('\n', true))) {
+        return      o.template lift<rxu::shared_view>(SplitRecords('\n', true));
+    }
+
+    template<class... AN>
+    static operators::detail::split_lines_invalid_t<AN...> member(AN...) {
+        std::terminate();
+        return {};
+        static_assert(sizeof...(AN) == 10000, "split_lines takes no arguments, and the source must emit contiguous chunks of char sized values");
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,239 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+/*! \file rx-split_records.hpp
+
+    \brief Split a stream of byte chunks into the records that are separated by the delimiter.
+
+    \param delimiter  the byte that ends each record. the delimiter is not part of the emitted records.
+
+    \return  Observable that emits an rxcpp::util::shared_view for each record.
+
+    The source can emit rxcpp::util::shared_view, std::string, std::vector<std::uint8_t>, rxcpp::util::pooled_buffer<std::uint8_t>
+    or any other contiguous container of char sized values. Chunks that are not already a shared_view are moved into shared storage.
+    Each record that fits in a chunk is emitted as a view into that chunk, so it is not copied. A record that spans chunks
+    is extended in place when the chunks are adjacent in memory, as the chunks from rxcpp::sources::mmap_file are.
+    Otherwise only the bytes of that record are copied. The delimiter is found with std::memchr.
+
+    An empty record is emitted between two delimiters. The bytes after the last delimiter are emitted when the source completes.
+
+    \sample
+    \snippet split_records.cpp split_records sample
+    \snippet output.txt split_records sample
+*/
+
+#if !defined(RXCPP_OPERATORS_RX_SPLIT_RECORDS_HPP)
+#define RXCPP_OPERATORS_RX_SPLIT_RECORDS_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+namespace detail {
+
+template<class... AN>
+struct split_records_invalid_arguments {};
+
+template<class... AN>
+struct split_records_invalid : public rxo::operator_base<split_records_invalid_arguments<AN...>> {
+    using type = observable<split_records_invalid_arguments<AN...>, split_records_invalid<AN...>>;
+};
+template<class... AN>
+using split_records_invalid_t = typename split_records_invalid<AN...>::type;
+
+template<class T>
+struct is_splittable
+{
+    struct not_void {};
+    template<class CT>
+    static auto check(int) -> decltype(rxu::make_shared_view(std::declval<CT>()));
+    template<class CT>
+    static not_void check(...);
+
+    static const bool value = std::is_same<decltype(check<rxu::decay_t<T>>(0)), rxu::shared_view>::value;
+};
+
+template<class T>
+struct split_records
+{
+    using source_value_type = rxu::decay_t<T>;
+    using value_type = rxu::shared_view;
+
+    struct split_records_values
+    {
+        split_records_values(char d, bool t)
+            : delimiter(d)
+            , trim_cr(t)
+        {
+        }
+        char delimiter;
+        // split_lines also removes a '\r' before each '\n'
+        bool trim_cr;
+    };
+    split_records_values initial;
+
+    split_records(char delimiter, bool trim_cr)
+        : initial(delimiter, trim_cr)
+    {
+    }
+
+    // the partial record at the end of the last chunk
+    struct split_records_state
+    {
+        split_records_state()
+            : carrying(false)
+        {
+        }
+        // a view that is extended in place while the chunks are adjacent
+        rxu::shared_view pending;
+        // a copy that is used when the next chunk is not adjacent
+        std::string carry;
+        bool carrying;
+    };
+
+    template<class Subscriber>
+    struct split_records_observer
+    {
+        using this_type = split_records_observer<Subscriber>;
+        using dest_type = rxu::decay_t<Subscriber>;
+        using observer_type = observer<source_value_type, this_type>;
+
+        dest_type dest;
+        split_records_values values;
+        std::shared_ptr<split_records_state> state;
+
+        split_records_observer(dest_type d, split_records_values v)
+            : dest(std::move(d))
+            , values(v)
+            , state(rxu::make_shared_state<split_records_state>())
+        {
+        }
+
+        const char* find(const char* first, const char* last) const {
+            return static_cast<const char*>(std::memchr(first, values.delimiter, static_cast<std::size_t>(last - first)));
+        }
+
+        void emit(rxu::shared_view record) const {
+            if (values.trim_cr && !record.empty() && record[record.size() - 1] == '\r') {
+                record = record.substr(0, record.size() - 1);
+            }
+            dest.on_next(std::move(record));
+        }
+
+        void emit_partial() const {
+            auto& st = *state;
+            if (st.carrying) {
+                st.carrying = false;
+                auto record = rxu::make_shared_view(std::move(st.carry));
+                st.carry = std::string();
+                emit(std::move(record));
+            } else {
+                auto record = std::move(st.pending);
+                st.pending = rxu::shared_view();
+                emit(std::move(record));
+            }
+        }
+
+        template<class U>
+        void on_next(U&& v) const {
+            auto chunk = rxu::make_shared_view(std::forward<U>(v));
+            if (chunk.empty()) {
+                return;
+            }
+            auto& st = *state;
+            const char* base = chunk.data();
+            const char* first = base;
+            const char* last = chunk.end();
+            if (st.carrying || !st.pending.empty()) {
+                auto found = find(first, last);
+                auto end = !found ? last : found;
+                if (!st.carrying && st.pending.get_owner() == chunk.get_owner() && st.pending.end() == base) {
+                    st.pending = rxu::shared_view(st.pending.get_owner(), st.pending.data(), st.pending.size() + (end - first));
+                } else {
+                    if (!st.carrying) {
+                        st.carrying = true;
+                        st.carry.assign(st.pending.begin(), st.pending.end());
+                        st.pending = rxu::shared_view();
+                    }
+                    st.carry.append(first, end);
+                }
+                if (!found) {
+                    return;
+                }
+                emit_partial();
+                first = found + 1;
+            }
+            while (first != last && dest.is_subscribed()) {
+                auto found = find(first, last);
+                if (!found) {
+                    st.pending = chunk.substr(first - base);
+                    return;
+                }
+                emit(chunk.substr(first - base, found - first));
+                first = found + 1;
+            }
+        }
+        void on_error(rxu::error_ptr e) const {
+            dest.on_error(e);
+        }
+        void on_completed() const {
+            if (state->carrying || !state->pending.empty()) {
+                emit_partial();
+            }
+            dest.on_completed();
+        }
+
+        static subscriber<source_value_type, observer_type> make(dest_type d, split_records_values v) {
+            auto cs = d.get_subscription();
+            return make_subscriber<source_value_type>(std::move(cs), this_type(std::move(d), std::move(v)));
+        }
+    };
+
+    template<class Subscriber>
+    auto operator()(Subscriber dest) const
+        -> decltype(split_records_observer<Subscriber>::make(std::move(dest), initial)) {
+        return      split_records_observer<Subscriber>::make(std::move(dest), initial);
+    }
+};
+
+}
+
+/*! @copydoc rx-split_records.hpp
+*/
+template<class... AN>
+auto split_records(AN&&... an)
+    ->      operator_factory<split_records_tag, AN...> {
+     return operator_factory<split_records_tag, AN...>(std::make_tuple(std::forward<AN>(an)...));
+}
+
+}
+
+template<>
+struct member_overload<split_records_tag>
+{
+    template<class Observable, class Delimiter,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            operators::detail::is_splittable<SourceValue>,
+            std::is_integral<rxu::decay_t<Delimiter>>>,
+        class SplitRecords = rxo::detail::split_records<SourceValue>>
+    static auto member(Observable&& o, Delimiter&& d)
+        -> decltype(o.template lift<rxu::shared_view>(SplitRecords(static_cast<char>(d), false))) {
+        return      o.template lift<rxu::shared_view>(SplitRecords(static_cast<char>(d), false));
+    }
+
+    template<class... AN>
+    static operators::detail::split_records_invalid_t<AN...> member(AN...) {
+        std::terminate();
+        return {};
+        static_assert(sizeof...(AN) == 10000, "split_records takes (Delimiter), and the source must emit contiguous chunks of char sized values");
+    }
+};
+
+}
+
+#endif
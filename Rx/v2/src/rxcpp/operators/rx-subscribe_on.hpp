@@ -98,7 +98,7 @@ struct subscribe_on : public operator_base<T>
         auto controller = coordinator.get_worker();
 
         // take a copy of the values for each subscription
-        auto state = std::make_shared<subscribe_on_state_type>(initial, std::move(s));
+        auto state = rxu::make_shared_state<subscribe_on_state_type>(initial, std::move(s));
 
         auto sl = state->source_lifetime;
         auto ol = state->out.get_subscription();
@@ -88,7 +88,7 @@ struct take : public operator_base<T>
             output_type out;
         };
         // take a copy of the values for each subscription
-        auto state = std::make_shared<state_type>(initial, s);
+        auto state = rxu::make_shared_state<state_type>(initial, s);
 
         composite_subscription source_lifetime;
 
@@ -119,7 +119,7 @@ struct take_until : public operator_base<T>
         auto coordinator = initial.coordination.create_coordinator(s.get_subscription());
 
         // take a copy of the values for each subscription
-        auto state = std::make_shared<take_until_state_type>(initial, std::move(coordinator), std::move(s));
+        auto state = rxu::make_shared_state<take_until_state_type>(initial, std::move(coordinator), std::move(s));
 
         auto trigger = on_exception(
             [&](){return state->coordinator.in(state->trigger);},
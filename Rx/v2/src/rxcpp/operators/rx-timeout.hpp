@@ -90,7 +90,6 @@ struct timeout
                 , dest(std::move(d))
                 , coordinator(std::move(c))
                 , worker(coordinator.get_worker())
-                , index(0)
             {
             }
 
@@ -98,17 +97,23 @@ struct timeout
             dest_type dest;
             coordinator_type coordinator;
             rxsc::worker worker;
-            mutable std::size_t index;
+            rxsc::deadline_timer timer;
         };
 
         using state_type = std::shared_ptr<timeout_subscriber_values>;
         state_type state;
 
         timeout_observer(composite_subscription cs, dest_type d, timeout_values v, coordinator_type c)
-            : state(std::make_shared<timeout_subscriber_values>(timeout_subscriber_values(std::move(cs), std::move(d), v, std::move(c))))
+            : state(rxu::make_shared_state<timeout_subscriber_values>(timeout_subscriber_values(std::move(cs), std::move(d), v, std::move(c))))
         {
             auto localState = state;
 
+            auto selectedProduce = produce_timeout(localState);
+            if (!selectedProduce) {
+                return;
+            }
+            localState->timer = rxsc::make_deadline_timer(localState->worker, std::move(selectedProduce));
+
             auto disposer = [=](const rxsc::schedulable&){
                 localState->cs.unsubscribe();
                 localState->dest.unsubscribe();
@@ -128,11 +133,8 @@ struct timeout
                 localState->worker.schedule(selectedDisposer.get());
             });
 
-            auto work = [v, localState](const rxsc::schedulable&) {
-                auto new_id = ++localState->index;
-                auto produce_time = localState->worker.now() + localState->period;
-
-                localState->worker.schedule(produce_time, produce_timeout(new_id, localState));
+            auto work = [localState](const rxsc::schedulable&) {
+                localState->timer.arm(localState->period);
             };
             auto selectedWork = on_exception(
                 [&](){return localState->coordinator.act(work);},
@@ -143,9 +145,12 @@ struct timeout
             localState->worker.schedule(selectedWork.get());
         }
 
-        static std::function<void(const rxsc::schedulable&)> produce_timeout(std::size_t id, state_type state) {
-            auto produce = [id, state](const rxsc::schedulable&) {
-                if(id != state->index)
+        static std::function<void(const rxsc::schedulable&)> produce_timeout(state_type state) {
+            // the timer is owned by the state, do not keep the state alive from the timer
+            std::weak_ptr<timeout_subscriber_values> weakState = state;
+            auto produce = [weakState](const rxsc::schedulable&) {
+                auto state = weakState.lock();
+                if (!state)
                     return;
 
                 state->dest.on_error(rxu::make_error_ptr(rxcpp::timeout_error("timeout has occurred")));
@@ -161,27 +166,27 @@ struct timeout
             return std::function<void(const rxsc::schedulable&)>(selectedProduce.get());
         }
 
-        void on_next(const T& v) const {
+        void on_next(T v) const {
             auto localState = state;
-            auto work = [v, localState](const rxsc::schedulable&) {
-                auto new_id = ++localState->index;
+            auto work = [v = std::move(v), localState](const rxsc::schedulable&) mutable {
                 auto produce_time = localState->worker.now() + localState->period;
 
                 localState->dest.on_next(std::move(v));
-                localState->worker.schedule(produce_time, produce_timeout(new_id, localState));
+                localState->timer.arm(produce_time);
             };
             auto selectedWork = on_exception(
-                [&](){return localState->coordinator.act(work);},
+                [&](){return localState->coordinator.act(std::move(work));},
                 localState->dest);
             if (selectedWork.empty()) {
                 return;
             }
-            localState->worker.schedule(selectedWork.get());
+            localState->worker.schedule(std::move(selectedWork.get()));
         }
 
         void on_error(rxu::error_ptr e) const {
             auto localState = state;
             auto work = [e, localState](const rxsc::schedulable&) {
+                localState->timer.cancel();
                 localState->dest.on_error(e);
             };
             auto selectedWork = on_exception(
@@ -196,6 +201,7 @@ struct timeout
         void on_completed() const {
             auto localState = state;
             auto work = [localState](const rxsc::schedulable&) {
+                localState->timer.cancel();
                 localState->dest.on_completed();
             };
             auto selectedWork = on_exception(
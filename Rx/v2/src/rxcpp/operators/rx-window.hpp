@@ -74,45 +74,62 @@ struct window
         using value_type = rxu::decay_t<T>;
         using dest_type = rxu::decay_t<Subscriber>;
         using observer_type = observer<T, this_type>;
+        using window_type = rxcpp::subjects::unicast<T>;
         dest_type dest;
         mutable int cursor;
-        mutable std::deque<rxcpp::subjects::subject<T>> subj;
+        mutable std::deque<typename window_type::subscriber_type> subj;
 
         window_observer(dest_type d, window_values v)
             : window_values(v)
             , dest(std::move(d))
             , cursor(0)
         {
-            subj.push_back(rxcpp::subjects::subject<T>());
-            dest.on_next(subj[0].get_observable().as_dynamic());
+            open_window();
+        }
+        void open_window() const {
+            window_type w;
+            subj.push_back(w.get_subscriber());
+            dest.on_next(w.get_observable().as_dynamic());
         }
         void on_next(const T& v) const {
             for (const auto& s : subj) {
-                s.get_subscriber().on_next(v);
+                s.on_next(v);
             }
-
+            close_and_open();
+        }
+        // the last open window gets the value moved into it
+        void on_next(T&& v) const {
+            if (!subj.empty()) {
+                auto last = subj.end() - 1;
+                for (auto it = subj.begin(); it != last; ++it) {
+                    it->on_next(static_cast<const T&>(v));
+                }
+                last->on_next(std::move(v));
+            }
+            close_and_open();
+        }
+        void close_and_open() const {
             int c = cursor - this->count + 1;
             if (c >= 0 && c % this->skip == 0) {
-                subj[0].get_subscriber().on_completed();
+                subj[0].on_completed();
                 subj.pop_front();
             }
 
             if (++cursor % this->skip == 0) {
-                subj.push_back(rxcpp::subjects::subject<T>());
-                dest.on_next(subj[subj.size() - 1].get_observable().as_dynamic());
+                open_window();
             }
         }
 
         void on_error(rxu::error_ptr e) const {
-            for (auto s : subj) {
-                s.get_subscriber().on_error(e);
+            for (const auto& s : subj) {
+                s.on_error(e);
             }
             dest.on_error(e);
         }
 
         void on_completed() const {
-            for (auto s : subj) {
-                s.get_subscriber().on_completed();
+            for (const auto& s : subj) {
+                s.on_completed();
             }
             dest.on_completed();
         }
@@ -90,6 +90,7 @@ struct window_with_time
         using value_type = rxu::decay_t<T>;
         using dest_type = rxu::decay_t<Subscriber>;
         using observer_type = observer<T, this_type>;
+        using window_type = rxcpp::subjects::unicast<T>;
 
         struct window_with_time_subscriber_values : public window_with_time_values
         {
@@ -106,13 +107,13 @@ struct window_with_time
             dest_type dest;
             coordinator_type coordinator;
             rxsc::worker worker;
-            mutable std::deque<rxcpp::subjects::subject<T>> subj;
+            mutable std::deque<typename window_type::subscriber_type> subj;
             rxsc::scheduler::clock_type::time_point expected;
         };
         std::shared_ptr<window_with_time_subscriber_values> state;
 
         window_with_time_observer(composite_subscription cs, dest_type d, window_with_time_values v, coordinator_type c)
-            : state(std::make_shared<window_with_time_subscriber_values>(window_with_time_subscriber_values(std::move(cs), std::move(d), v, std::move(c))))
+            : state(rxu::make_shared_state<window_with_time_subscriber_values>(window_with_time_subscriber_values(std::move(cs), std::move(d), v, std::move(c))))
         {
             auto localState = state;
 
@@ -143,7 +144,7 @@ struct window_with_time
 
             auto release_window = [localState](const rxsc::schedulable&) {
                 localState->worker.schedule([localState](const rxsc::schedulable&) {
-                    localState->subj[0].get_subscriber().on_completed();
+                    localState->subj[0].on_completed();
                     localState->subj.pop_front();
                 });
             };
@@ -155,8 +156,9 @@ struct window_with_time
             }
 
             auto create_window = [localState, selectedRelease](const rxsc::schedulable&) {
-                localState->subj.push_back(rxcpp::subjects::subject<T>());
-                localState->dest.on_next(localState->subj[localState->subj.size() - 1].get_observable().as_dynamic());
+                window_type w;
+                localState->subj.push_back(w.get_subscriber());
+                localState->dest.on_next(w.get_observable().as_dynamic());
 
                 auto produce_at = localState->expected + localState->period;
                 localState->expected += localState->skip;
@@ -181,25 +183,31 @@ struct window_with_time
 
         void on_next(T v) const {
             auto localState = state;
-            auto work = [v, localState](const rxsc::schedulable&){
-                for (auto s : localState->subj) {
-                    s.get_subscriber().on_next(v);
+            auto work = [v = std::move(v), localState](const rxsc::schedulable&) mutable {
+                if (localState->subj.empty()) {
+                    return;
                 }
+                // copy into all but the newest window, which takes the value
+                auto last = std::prev(localState->subj.end());
+                for (auto s = localState->subj.begin(); s != last; ++s) {
+                    s->on_next(v);
+                }
+                last->on_next(std::move(v));
             };
             auto selectedWork = on_exception(
-                [&](){return localState->coordinator.act(work);},
+                [&](){return localState->coordinator.act(std::move(work));},
                 localState->dest);
             if (selectedWork.empty()) {
                 return;
             }
-            localState->worker.schedule(selectedWork.get());
+            localState->worker.schedule(std::move(selectedWork.get()));
         }
 
         void on_error(rxu::error_ptr e) const {
             auto localState = state;
             auto work = [e, localState](const rxsc::schedulable&){
-                for (auto s : localState->subj) {
-                    s.get_subscriber().on_error(e);
+                for (const auto& s : localState->subj) {
+                    s.on_error(e);
                 }
                 localState->dest.on_error(e);
             };
@@ -215,8 +223,8 @@ struct window_with_time
         void on_completed() const {
             auto localState = state;
             auto work = [localState](const rxsc::schedulable&){
-                for (auto s : localState->subj) {
-                    s.get_subscriber().on_completed();
+                for (const auto& s : localState->subj) {
+                    s.on_completed();
                 }
                 localState->dest.on_completed();
             };
@@ -80,6 +80,7 @@ struct window_with_time_or_count
         using value_type = rxu::decay_t<T>;
         using dest_type = rxu::decay_t<Subscriber>;
         using observer_type = observer<T, this_type>;
+        using window_type = rxcpp::subjects::unicast<T>;
 
         struct window_with_time_or_count_subscriber_values : public window_with_time_or_count_values
         {
@@ -91,6 +92,7 @@ struct window_with_time_or_count
                 , worker(coordinator.get_worker())
                 , cursor(0)
                 , subj_id(0)
+                , subj(window_type().get_subscriber())
             {
             }
             composite_subscription cs;
@@ -99,14 +101,14 @@ struct window_with_time_or_count
             rxsc::worker worker;
             mutable int cursor;
             mutable int subj_id;
-            mutable rxcpp::subjects::subject<T> subj;
+            mutable typename window_type::subscriber_type subj;
         };
 
         using state_type = std::shared_ptr<window_with_time_or_count_subscriber_values>;
         state_type state;
 
         window_with_time_or_count_observer(composite_subscription cs, dest_type d, window_with_time_or_count_values v, coordinator_type c)
-            : state(std::make_shared<window_with_time_or_count_subscriber_values>(window_with_time_or_count_subscriber_values(std::move(cs), std::move(d), std::move(v), std::move(c))))
+            : state(rxu::make_shared_state<window_with_time_or_count_subscriber_values>(window_with_time_or_count_subscriber_values(std::move(cs), std::move(d), std::move(v), std::move(c))))
         {
             auto new_id = state->subj_id;
             auto produce_time = state->worker.now();
@@ -147,9 +149,10 @@ struct window_with_time_or_count
                 if (id != state->subj_id)
                     return;
 
-                state->subj.get_subscriber().on_completed();
-                state->subj = rxcpp::subjects::subject<T>();
-                state->dest.on_next(state->subj.get_observable().as_dynamic());
+                state->subj.on_completed();
+                window_type w;
+                state->subj = w.get_subscriber();
+                state->dest.on_next(w.get_observable().as_dynamic());
                 state->cursor = 0;
                 auto new_id = ++state->subj_id;
                 auto produce_time = expected + state->period;
@@ -169,25 +172,25 @@ struct window_with_time_or_count
 
         void on_next(T v) const {
             auto localState = state;
-            auto work = [v, localState](const rxsc::schedulable& self){
-                localState->subj.get_subscriber().on_next(v);
+            auto work = [v = std::move(v), localState](const rxsc::schedulable& self) mutable {
+                localState->subj.on_next(std::move(v));
                 if (++localState->cursor == localState->count) {
                     release_window(localState->subj_id, localState->worker.now(), localState)(self);
                 }
             };
             auto selectedWork = on_exception(
-                [&](){return localState->coordinator.act(work);},
+                [&](){return localState->coordinator.act(std::move(work));},
                 localState->dest);
             if (selectedWork.empty()) {
                 return;
             }
-            localState->worker.schedule(selectedWork.get());
+            localState->worker.schedule(std::move(selectedWork.get()));
         }
 
         void on_error(rxu::error_ptr e) const {
             auto localState = state;
             auto work = [e, localState](const rxsc::schedulable&){
-                localState->subj.get_subscriber().on_error(e);
+                localState->subj.on_error(e);
                 localState->dest.on_error(e);
             };
             auto selectedWork = on_exception(
@@ -202,7 +205,7 @@ struct window_with_time_or_count
         void on_completed() const {
             auto localState = state;
             auto work = [localState](const rxsc::schedulable&){
-                localState->subj.get_subscriber().on_completed();
+                localState->subj.on_completed();
                 localState->dest.on_completed();
             };
             auto selectedWork = on_exception(
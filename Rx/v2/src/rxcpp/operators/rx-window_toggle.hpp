@@ -86,6 +86,7 @@ struct window_toggle
         using value_type = rxu::decay_t<T>;
         using dest_type = rxu::decay_t<Subscriber>;
         using observer_type = observer<T, this_type>;
+        using window_type = rxcpp::subjects::unicast<T>;
 
         struct window_toggle_subscriber_values : public window_toggle_values
         {
@@ -101,12 +102,12 @@ struct window_toggle
             dest_type dest;
             coordinator_type coordinator;
             rxsc::worker worker;
-            mutable std::list<rxcpp::subjects::subject<T>> subj;
+            mutable std::list<typename window_type::subscriber_type> subj;
         };
         std::shared_ptr<window_toggle_subscriber_values> state;
 
         window_toggle_observer(composite_subscription cs, dest_type d, window_toggle_values v, coordinator_type c)
-            : state(std::make_shared<window_toggle_subscriber_values>(window_toggle_subscriber_values(std::move(cs), std::move(d), v, std::move(c))))
+            : state(rxu::make_shared_state<window_toggle_subscriber_values>(window_toggle_subscriber_values(std::move(cs), std::move(d), v, std::move(c))))
         {
             auto localState = state;
 
@@ -139,8 +140,9 @@ struct window_toggle
                 [localState](const openings_value_type& ov) {
                     auto closer = localState->closingSelector(ov);
 
-                    auto it = localState->subj.insert(localState->subj.end(), rxcpp::subjects::subject<T>());
-                    localState->dest.on_next(it->get_observable().as_dynamic());
+                    window_type w;
+                    auto it = localState->subj.insert(localState->subj.end(), w.get_subscriber());
+                    localState->dest.on_next(w.get_observable().as_dynamic());
 
                     composite_subscription innercs;
 
@@ -154,12 +156,12 @@ struct window_toggle
 
                     auto source = localState->coordinator.in(closer);
 
-                    auto sit = std::make_shared<decltype(it)>(it);
+                    auto sit = rxu::make_shared_state<decltype(it)>(it);
                     auto close = [localState, sit]() {
                         auto it = *sit;
                         *sit = localState->subj.end();
                         if (it != localState->subj.end()) {
-                            it->get_subscriber().on_completed();
+                            it->on_completed();
                             localState->subj.erase(it);
                         }
                     };
@@ -202,27 +204,33 @@ struct window_toggle
             source->subscribe(std::move(selectedSink.get()));
         }
 
-        void on_next(const T& v) const {
+        void on_next(T v) const {
             auto localState = state;
-            auto work = [v, localState](const rxsc::schedulable&){
-                for (const auto& s : localState->subj) {
-                    s.get_subscriber().on_next(v);
+            auto work = [v = std::move(v), localState](const rxsc::schedulable&) mutable {
+                if (localState->subj.empty()) {
+                    return;
+                }
+                // copy into all but the newest window, which takes the value
+                auto last = std::prev(localState->subj.end());
+                for (auto s = localState->subj.begin(); s != last; ++s) {
+                    s->on_next(v);
                 }
+                last->on_next(std::move(v));
             };
             auto selectedWork = on_exception(
-                [&](){return localState->coordinator.act(work);},
+                [&](){return localState->coordinator.act(std::move(work));},
                 localState->dest);
             if (selectedWork.empty()) {
                 return;
             }
-            localState->worker.schedule(selectedWork.get());
+            localState->worker.schedule(std::move(selectedWork.get()));
         }
 
         void on_error(rxu::error_ptr e) const {
             auto localState = state;
             auto work = [e, localState](const rxsc::schedulable&){
-                for (auto s : localState->subj) {
-                    s.get_subscriber().on_error(e);
+                for (const auto& s : localState->subj) {
+                    s.on_error(e);
                 }
                 localState->dest.on_error(e);
             };
@@ -238,8 +246,8 @@ struct window_toggle
         void on_completed() const {
             auto localState = state;
             auto work = [localState](const rxsc::schedulable&){
-                for (auto s : localState->subj) {
-                    s.get_subscriber().on_completed();
+                for (const auto& s : localState->subj) {
+                    s.on_completed();
                 }
                 localState->dest.on_completed();
             };
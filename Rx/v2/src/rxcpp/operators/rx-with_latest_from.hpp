@@ -16,6 +16,9 @@
 
     If aggregation function is omitted, the resulting observable returns tuples of emitted items.
 
+    The aggregation function is passed a copy of each latest value. Wrap it in rxu::by_reference()
+    to pass const references to the latest values instead.
+
     \sample
 
     Neither scheduler nor aggregation function are present:
@@ -167,8 +170,7 @@ struct with_latest_from : public operator_base<rxu::value_type_t<with_latest_fro
                 value.reset(std::forward<decltype(st)>(st));
 
                 if (state->valuesSet == sizeof... (ObservableN) && Index == 0) {
-                    auto values = rxu::surely(state->latest);
-                    state->out.on_next(rxu::apply(std::move(values), state->selector));
+                    state->out.on_next(rxu::apply_latest(state->latest, state->selector));
                 }
             },
         // on_error
@@ -227,7 +229,7 @@ struct with_latest_from : public operator_base<rxu::value_type_t<with_latest_fro
         auto coordinator = initial.coordination.create_coordinator(scbr.get_subscription());
 
         // take a copy of the values for each subscription
-        auto state = std::make_shared<with_latest_from_state_type>(initial, std::move(coordinator), std::move(scbr));
+        auto state = rxu::make_shared_state<with_latest_from_state_type>(initial, std::move(coordinator), std::move(scbr));
 
         subscribe_all(state, typename rxu::values_from<int, sizeof...(ObservableN)>::type());
     }
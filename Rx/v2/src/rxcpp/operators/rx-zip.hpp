@@ -38,10 +38,54 @@
     Both scheduler and aggregation function are present:
     \snippet zip.cpp Coordination+Selector zip sample
     \snippet output.txt Coordination+Selector zip sample
+
+    A zip_limit may follow the scheduler (or be the first argument when there
+    is no scheduler) to bound the number of values that are buffered for each
+    source while waiting for the other sources. When a source exceeds the bound
+    zip either emits a zip_overflow_error or drops the oldest buffered value
+    of that source.
 */
 
 namespace rxcpp {
 
+class zip_overflow_error: public std::runtime_error
+{
+    public:
+        explicit zip_overflow_error(const std::string& msg):
+            std::runtime_error(msg)
+        {}
+};
+
+/// what zip does with a value that arrives when its source is at capacity
+enum class zip_overflow
+{
+    /// terminate with zip_overflow_error
+    error,
+    /// drop the oldest buffered value of that source
+    drop_oldest
+};
+
+/// bounds the number of values zip buffers for each source
+struct zip_limit
+{
+    /// unbounded
+    zip_limit()
+        : capacity((std::numeric_limits<std::size_t>::max)())
+        , policy(zip_overflow::error)
+    {
+    }
+    explicit zip_limit(std::size_t c, zip_overflow p = zip_overflow::error)
+        : capacity(c < 1 ? 1 : c)
+        , policy(p)
+    {
+    }
+    std::size_t capacity;
+    zip_overflow policy;
+};
+
+template<class T>
+using is_zip_limit = std::is_same<rxu::decay_t<T>, zip_limit>;
+
 namespace operators {
 
 namespace detail {
@@ -54,29 +98,26 @@ struct zip_source_state
         : completed(false) 
     {
     }
-    std::list<value_type> values;
+    rxu::ring_buffer<value_type> values;
     bool completed;
 };
 
-struct values_not_empty {
-    template<class Observable>
-    bool operator()(zip_source_state<Observable>& source) const {
-        return !source.values.empty();
-    }
-};
-
-struct source_completed_values_empty {
-    template<class Observable>
-    bool operator()(zip_source_state<Observable>& source) const {
-        return source.completed && source.values.empty();
-    }
-};
-
+// keeps the counts of non-empty sources and of completed and empty
+// sources current, so that zip does not need to scan the sources.
 struct extract_value_front {
+    int& valuesSet;
+    int& completedEmpty;
+
     template<class Observable, class Value = rxu::value_type_t<Observable>>
     Value operator()(zip_source_state<Observable>& source) const {
         auto val = std::move(source.values.front());
         source.values.pop_front();
+        if (source.values.empty()) {
+            --valuesSet;
+            if (source.completed) {
+                ++completedEmpty;
+            }
+        }
         return val;
     }
 };
@@ -149,20 +190,22 @@ struct zip : public operator_base<rxu::value_type_t<zip_traits<Coordination, Sel
 
     struct values
     {
-        values(tuple_source_type o, selector_type s, coordination_type sf)
+        values(tuple_source_type o, selector_type s, coordination_type sf, zip_limit l)
             : source(std::move(o))
             , selector(std::move(s))
             , coordination(std::move(sf))
+            , limit(l)
         {
         }
         tuple_source_type source;
         selector_type selector;
         coordination_type coordination;
+        zip_limit limit;
     };
     values initial;
 
-    zip(coordination_type sf, selector_type s, tuple_source_type ts)
-        : initial(std::move(ts), std::move(s), std::move(sf))
+    zip(coordination_type sf, selector_type s, tuple_source_type ts, zip_limit l = zip_limit())
+        : initial(std::move(ts), std::move(s), std::move(sf), l)
     {
     }
 
@@ -193,11 +236,20 @@ struct zip : public operator_base<rxu::value_type_t<zip_traits<Coordination, Sel
         // on_next
             [state](auto&& st) {
                 auto& values = std::get<Index>(state->pending).values;
+                if (values.empty()) {
+                    ++state->valuesSet;
+                } else if (values.size() >= state->limit.capacity) {
+                    if (state->limit.policy == zip_overflow::error) {
+                        state->out.on_error(rxu::make_error_ptr(zip_overflow_error("zip source exceeded its capacity")));
+                        return;
+                    }
+                    values.pop_front();
+                }
                 values.emplace_back(std::forward<decltype(st)>(st));
-                if (rxu::apply_to_each(state->pending, values_not_empty(), rxu::all_values_true())) {
-                    state->out.on_next(rxu::apply_to_each(state->pending, extract_value_front(), state->selector));
+                if (state->valuesSet == sizeof...(ObservableN)) {
+                    state->out.on_next(rxu::apply_to_each(state->pending, extract_value_front{state->valuesSet, state->completedEmpty}, state->selector));
                 }
-                if (rxu::apply_to_each(state->pending, source_completed_values_empty(), rxu::any_value_true())) {
+                if (state->completedEmpty > 0) {
                     state->out.on_completed();
                 }
             },
@@ -207,8 +259,11 @@ struct zip : public operator_base<rxu::value_type_t<zip_traits<Coordination, Sel
             },
         // on_completed
             [state]() {
-                auto& completed = std::get<Index>(state->pending).completed;
-                completed = true;
+                auto& source = std::get<Index>(state->pending);
+                source.completed = true;
+                if (source.values.empty()) {
+                    ++state->completedEmpty;
+                }
                 if (--state->pendingCompletions == 0) {
                     state->out.on_completed();
                 }
@@ -242,6 +297,7 @@ struct zip : public operator_base<rxu::value_type_t<zip_traits<Coordination, Sel
                 : values(std::move(i))
                 , pendingCompletions(sizeof... (ObservableN))
                 , valuesSet(0)
+                , completedEmpty(0)
                 , coordinator(std::move(coor))
                 , out(std::move(oarg))
             {
@@ -250,7 +306,10 @@ struct zip : public operator_base<rxu::value_type_t<zip_traits<Coordination, Sel
             // on_completed on the output must wait until all the
             // subscriptions have received on_completed
             mutable int pendingCompletions;
+            // the number of sources with buffered values
             mutable int valuesSet;
+            // the number of completed sources without buffered values
+            mutable int completedEmpty;
             mutable tuple_source_values_type pending;
             coordinator_type coordinator;
             output_type out;
@@ -259,7 +318,7 @@ struct zip : public operator_base<rxu::value_type_t<zip_traits<Coordination, Sel
         auto coordinator = initial.coordination.create_coordinator(scbr.get_subscription());
 
         // take a copy of the values for each subscription
-        auto state = std::make_shared<zip_state_type>(initial, std::move(coordinator), std::move(scbr));
+        auto state = rxu::make_shared_state<zip_state_type>(initial, std::move(coordinator), std::move(scbr));
 
         subscribe_all(state, typename rxu::values_from<int, sizeof...(ObservableN)>::type());
     }
@@ -330,11 +389,65 @@ struct member_overload<zip_tag>
         return Result(Zip(std::forward<Coordination>(cn), std::forward<Selector>(s), std::make_tuple(std::forward<Observable>(o), std::forward<ObservableN>(on)...)));
     }
 
+    template<class Observable, class Limit, class... ObservableN,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_zip_limit<Limit>,
+            all_observables<Observable, ObservableN...>>,
+        class Zip = rxo::detail::zip<identity_one_worker, rxu::detail::pack, rxu::decay_t<Observable>, rxu::decay_t<ObservableN>...>,
+        class Value = rxu::value_type_t<Zip>,
+        class Result = observable<Value, Zip>>
+    static Result member(Observable&& o, Limit&& l, ObservableN&&... on)
+    {
+        return Result(Zip(identity_current_thread(), rxu::pack(), std::make_tuple(std::forward<Observable>(o), std::forward<ObservableN>(on)...), std::forward<Limit>(l)));
+    }
+
+    template<class Observable, class Limit, class Selector, class... ObservableN,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_zip_limit<Limit>,
+            operators::detail::is_zip_selector<Selector, Observable, ObservableN...>,
+            all_observables<Observable, ObservableN...>>,
+        class ResolvedSelector = rxu::decay_t<Selector>,
+        class Zip = rxo::detail::zip<identity_one_worker, ResolvedSelector, rxu::decay_t<Observable>, rxu::decay_t<ObservableN>...>,
+        class Value = rxu::value_type_t<Zip>,
+        class Result = observable<Value, Zip>>
+    static Result member(Observable&& o, Limit&& l, Selector&& s, ObservableN&&... on)
+    {
+        return Result(Zip(identity_current_thread(), std::forward<Selector>(s), std::make_tuple(std::forward<Observable>(o), std::forward<ObservableN>(on)...), std::forward<Limit>(l)));
+    }
+
+    template<class Coordination, class Limit, class Observable, class... ObservableN,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_coordination<Coordination>,
+            is_zip_limit<Limit>,
+            all_observables<Observable, ObservableN...>>,
+        class Zip = rxo::detail::zip<Coordination, rxu::detail::pack, rxu::decay_t<Observable>, rxu::decay_t<ObservableN>...>,
+        class Value = rxu::value_type_t<Zip>,
+        class Result = observable<Value, Zip>>
+    static Result member(Observable&& o, Coordination&& cn, Limit&& l, ObservableN&&... on)
+    {
+        return Result(Zip(std::forward<Coordination>(cn), rxu::pack(), std::make_tuple(std::forward<Observable>(o), std::forward<ObservableN>(on)...), std::forward<Limit>(l)));
+    }
+
+    template<class Coordination, class Limit, class Selector, class Observable, class... ObservableN,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_coordination<Coordination>,
+            is_zip_limit<Limit>,
+            operators::detail::is_zip_selector<Selector, Observable, ObservableN...>,
+            all_observables<Observable, ObservableN...>>,
+        class ResolvedSelector = rxu::decay_t<Selector>,
+        class Zip = rxo::detail::zip<Coordination, ResolvedSelector, rxu::decay_t<Observable>, rxu::decay_t<ObservableN>...>,
+        class Value = rxu::value_type_t<Zip>,
+        class Result = observable<Value, Zip>>
+    static Result member(Observable&& o, Coordination&& cn, Limit&& l, Selector&& s, ObservableN&&... on)
+    {
+        return Result(Zip(std::forward<Coordination>(cn), std::forward<Selector>(s), std::make_tuple(std::forward<Observable>(o), std::forward<ObservableN>(on)...), std::forward<Limit>(l)));
+    }
+
     template<class... AN>
     static operators::detail::zip_invalid_t<AN...> member(const AN&...) {
         std::terminate();
         return {};
-        static_assert(sizeof...(AN) == 10000, "zip takes (optional Coordination, optional Selector, required Observable, optional Observable...), Selector takes (Observable::value_type...)");
+        static_assert(sizeof...(AN) == 10000, "zip takes (optional Coordination, optional zip_limit, optional Selector, required Observable, optional Observable...), Selector takes (Observable::value_type...)");
     } 
 };
 
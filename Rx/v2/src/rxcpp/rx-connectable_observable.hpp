@@ -51,7 +51,7 @@ class dynamic_connectable_observable
 
     template<class SO>
     void construct(SO&& source, rxs::tag_source&&) {
-        auto so = std::make_shared<rxu::decay_t<SO>>(std::forward<SO>(source));
+        auto so = rxu::make_shared_state<rxu::decay_t<SO>>(std::forward<SO>(source));
         state->on_connect = [so](composite_subscription cs) mutable {
             so->on_connect(std::move(cs));
         };
@@ -68,7 +68,7 @@ public:
     template<class SOF>
     explicit dynamic_connectable_observable(SOF sof)
         : dynamic_observable<T>(sof)
-        , state(std::make_shared<state_type>())
+        , state(rxu::make_shared_state<state_type>())
     {
         construct(std::move(sof), typename std::conditional_t<is_dynamic_observable<SOF>::value, tag_dynamic_observable, rxs::tag_source>());
     }
@@ -76,7 +76,7 @@ public:
     template<class SF, class CF>
     dynamic_connectable_observable(SF&& sf, CF&& cf)
         : dynamic_observable<T>(std::forward<SF>(sf))
-        , state(std::make_shared<state_type>())
+        , state(rxu::make_shared_state<state_type>())
     {
         state->on_connect = std::forward<CF>(cf);
     }
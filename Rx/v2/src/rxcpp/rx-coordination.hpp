@@ -187,7 +187,7 @@ class serialize_one_worker : public coordination_base
     template<class F>
     struct serialize_action
     {
-        F dest;
+        mutable F dest;
         std::shared_ptr<std::mutex> lock;
         serialize_action(F d, std::shared_ptr<std::mutex> m)
             : dest(std::move(d))
@@ -291,7 +291,7 @@ public:
 
     inline coordinator_type create_coordinator(composite_subscription cs = composite_subscription()) const {
         auto w = factory.create_worker(std::move(cs));
-        std::shared_ptr<std::mutex> lock = std::make_shared<std::mutex>();
+        std::shared_ptr<std::mutex> lock = rxu::make_shared_state<std::mutex>();
         return coordinator_type(input_type(std::move(w), std::move(lock)));
     }
 };
@@ -4,12 +4,28 @@
 
 /*! \file rx-coroutine.hpp
 
-    \brief The proposal to add couroutines to the standard adds `co_await`, `for co_await`, `co_yield` and `co_return`. This file adds `begin(observable<>)` & `end(observable<>)` which enables `for co_await` to work with the `observable<>` type.
-
-    for co_await (auto c : interval(seconds(1), observe_on_event_loop()) | take(3)) {
-        printf("%d\n", c);
-    }
-
+    \brief Use C++20 coroutines with observables and workers.
+
+    - `co_await values.next()` resumes with the next value of `rxcpp::coroutine::values(o)`, or with an empty rxu::maybe when o completes.
+    - `co_await rxcpp::coroutine::completion(o)` resumes when o completes, with the last value.
+    - `rxcpp::coroutine::task<T>` is a lazy coroutine that can be awaited, and `rxcpp::coroutine::from_task(f)` is an observable that
+      runs the task returned by `f()` for each subscription and emits its result.
+    - `rxcpp::coroutine::generator<T>` is a coroutine that emits each `co_yield`, and `rxcpp::coroutine::from_generator(f)` is an observable
+      that runs the generator returned by `f()` for each subscription. The generator is destroyed at the first `co_yield` after the
+      subscription is unsubscribed.
+    - `co_await worker` resumes the coroutine on the worker.
+
+    auto lines = rxcpp::coroutine::from_generator([=]() -> rxcpp::coroutine::generator<int> {
+        for (int i = 0;; ++i) {
+            co_await worker;
+            co_yield i;
+        }
+    });
+
+    All of these coroutines allocate their frames through the same operator new. While a `rxcpp::coroutine::frame_resource`
+    is alive, the frames that are created on that thread are allocated from its `std::pmr::memory_resource`.
+
+    \note only available when the compiler supports C++20 coroutines (RXCPP_USE_COROUTINES).
 */
 
 #if !defined(RXCPP_RX_COROUTINE_HPP)
@@ -17,178 +33,683 @@
 
 #include "rx-includes.hpp"
 
-#ifdef _RESUMABLE_FUNCTIONS_SUPPORTED
+#if RXCPP_USE_COROUTINES
 
-#include <rxcpp/operators/rx-finally.hpp>
-
-#include <experimental/resumable>
+#include <coroutine>
+#include <memory_resource>
 
 namespace rxcpp {
 namespace coroutine {
 
-using namespace std;
-using namespace std::chrono;
-using namespace std::experimental;
+namespace detail {
+
+// every frame is followed by the resource that allocated it, so that operator delete
+// frees it to the same resource after the current resource has changed.
+inline std::size_t frame_tail_offset(std::size_t size) {
+    const std::size_t align = alignof(std::max_align_t);
+    return (size + align - 1) / align * align;
+}
 
-template<typename Source>
-struct co_observable_iterator;
+inline std::pmr::memory_resource*& current_frame_resource() {
+    thread_local std::pmr::memory_resource* resource = nullptr;
+    return resource;
+}
 
-template<typename Source>
-struct co_observable_iterator_state : std::enable_shared_from_this<co_observable_iterator_state<Source>>
+struct promise_allocation
 {
-    using value_type = typename Source::value_type;
+    static void* operator new(std::size_t size) {
+        auto resource = current_frame_resource();
+        auto offset = frame_tail_offset(size);
+        auto bytes = offset + sizeof(std::pmr::memory_resource*);
+        auto frame = !resource ? ::operator new(bytes) : resource->allocate(bytes, alignof(std::max_align_t));
+        new (static_cast<char*>(frame) + offset) std::pmr::memory_resource*(resource);
+        return frame;
+    }
 
-    ~co_observable_iterator_state() {
-        lifetime.unsubscribe();
+    static void operator delete(void* frame, std::size_t size) {
+        auto offset = frame_tail_offset(size);
+        auto resource = *reinterpret_cast<std::pmr::memory_resource**>(static_cast<char*>(frame) + offset);
+        if (!resource) {
+            ::operator delete(frame);
+        } else {
+            resource->deallocate(frame, offset + sizeof(std::pmr::memory_resource*), alignof(std::max_align_t));
+        }
     }
-    explicit co_observable_iterator_state(const Source& o) : o(o) {}
+};
 
-    coroutine_handle<> caller{};
-    composite_subscription lifetime{};
-    const value_type* value{nullptr};
-    exception_ptr error{nullptr};
-    Source o;
+// a coroutine that starts immediately and destroys itself when it finishes
+struct detached
+{
+    struct promise_type : promise_allocation
+    {
+        detached get_return_object() noexcept {
+            return {};
+        }
+        std::suspend_never initial_suspend() noexcept {
+            return {};
+        }
+        std::suspend_never final_suspend() noexcept {
+            return {};
+        }
+        void return_void() noexcept {
+        }
+        void unhandled_exception() noexcept {
+            std::terminate();
+        }
+    };
 };
 
-template<typename Source>
-struct co_observable_inc_awaiter
+}
+
+/// while a frame_resource is alive, the frames of the coroutines in this file that are created on the
+/// same thread are allocated from its memory_resource. the resource must outlive those frames.
+class frame_resource
 {
-    bool await_ready() {
+    std::pmr::memory_resource* previous;
+
+    frame_resource(const frame_resource&);
+    frame_resource& operator=(const frame_resource&);
+
+public:
+    explicit frame_resource(std::pmr::memory_resource* r)
+        : previous(detail::current_frame_resource())
+    {
+        detail::current_frame_resource() = r;
+    }
+    ~frame_resource()
+    {
+        detail::current_frame_resource() = previous;
+    }
+};
+
+template<class T = void>
+class task;
+
+namespace detail {
+
+struct task_final_awaiter
+{
+    bool await_ready() const noexcept {
         return false;
     }
+    template<class Promise>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) const noexcept {
+        auto continuation = h.promise().continuation;
+        return !continuation ? std::noop_coroutine() : continuation;
+    }
+    void await_resume() const noexcept {
+    }
+};
 
-    bool await_suspend(coroutine_handle<> handle) {
-        if (!state->lifetime.is_subscribed()) {return false;}
-        state->caller = handle;
-        return true;
+struct task_promise_base : promise_allocation
+{
+    std::suspend_always initial_suspend() const noexcept {
+        return {};
+    }
+    task_final_awaiter final_suspend() const noexcept {
+        return {};
+    }
+    void unhandled_exception() noexcept {
+        error = rxu::current_exception();
     }
 
-    co_observable_iterator<Source> await_resume();
+    std::coroutine_handle<> continuation;
+    rxu::error_ptr error;
+};
 
-    shared_ptr<co_observable_iterator_state<Source>> state;
+template<class T>
+struct task_promise : task_promise_base
+{
+    task<T> get_return_object() noexcept;
+
+    template<class U>
+    void return_value(U&& u) {
+        value.reset(std::forward<U>(u));
+    }
+
+    rxu::maybe<T> value;
 };
 
-template<typename Source>
-struct co_observable_iterator : public iterator<input_iterator_tag, typename Source::value_type>
+template<>
+struct task_promise<void> : task_promise_base
 {
-    using value_type = typename Source::value_type;
+    task<void> get_return_object() noexcept;
 
-    co_observable_iterator() {}
+    void return_void() noexcept {
+    }
+};
 
-    explicit co_observable_iterator(const Source& o) : state(make_shared<co_observable_iterator_state<Source>>(o)) {}
-    explicit co_observable_iterator(const shared_ptr<co_observable_iterator_state<Source>>& o) : state(o) {}
+}
 
-    co_observable_iterator(co_observable_iterator&&)=default;
-    co_observable_iterator& operator=(co_observable_iterator&&)=default;
+/// a coroutine that starts when it is awaited and resumes the awaiting coroutine with the value of co_return.
+template<class T>
+class task
+{
+public:
+    using value_type = T;
+    using promise_type = detail::task_promise<T>;
+    using handle_type = std::coroutine_handle<promise_type>;
 
-    co_observable_inc_awaiter<Source> operator++()
+    task()
+    {
+    }
+    explicit task(handle_type h)
+        : coroutine(h)
+    {
+    }
+    task(task&& o) noexcept
+        : coroutine(std::exchange(o.coroutine, nullptr))
     {
-        return co_observable_inc_awaiter<Source>{state};
+    }
+    task& operator=(task o) noexcept {
+        std::swap(coroutine, o.coroutine);
+        return *this;
+    }
+    ~task()
+    {
+        if (coroutine) {
+            coroutine.destroy();
+        }
     }
 
-    co_observable_iterator& operator++(int) = delete;
-    // not implementing postincrement
+    bool is_ready() const noexcept {
+        return !coroutine || coroutine.done();
+    }
 
-    bool operator==(co_observable_iterator const &rhs) const
-    {
-        return !!state && !rhs.state && !state->lifetime.is_subscribed();
+    /// resumes with no value once the task has finished. error() and result() are valid afterwards.
+    auto when_ready() const noexcept {
+        struct awaiter
+        {
+            bool await_ready() const noexcept {
+                return !coroutine || coroutine.done();
+            }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) const noexcept {
+                coroutine.promise().continuation = awaiting;
+                return coroutine;
+            }
+            void await_resume() const noexcept {
+            }
+            handle_type coroutine;
+        };
+        return awaiter{coroutine};
     }
 
-    bool operator!=(co_observable_iterator const &rhs) const
+    const rxu::error_ptr& error() const noexcept {
+        return coroutine.promise().error;
+    }
+
+    /// the value of co_return. rethrows the error when the task failed.
+    decltype(auto) result() {
+        if (!!coroutine.promise().error) {
+            rxu::rethrow_exception(coroutine.promise().error);
+        }
+        if constexpr (!std::is_void<T>::value) {
+            return std::move(coroutine.promise().value.get());
+        }
+    }
+
+    auto operator co_await() && noexcept {
+        struct awaiter
+        {
+            bool await_ready() const noexcept {
+                return !self->coroutine || self->coroutine.done();
+            }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) const noexcept {
+                self->coroutine.promise().continuation = awaiting;
+                return self->coroutine;
+            }
+            decltype(auto) await_resume() const {
+                return self->result();
+            }
+            task* self;
+        };
+        return awaiter{this};
+    }
+
+private:
+    handle_type coroutine;
+};
+
+namespace detail {
+
+template<class T>
+task<T> task_promise<T>::get_return_object() noexcept {
+    return task<T>(std::coroutine_handle<task_promise<T>>::from_promise(*this));
+}
+
+inline task<void> task_promise<void>::get_return_object() noexcept {
+    return task<void>(std::coroutine_handle<task_promise<void>>::from_promise(*this));
+}
+
+}
+
+template<class T>
+class generator;
+
+namespace detail {
+
+template<class T>
+struct generator_promise : promise_allocation
+{
+    generator<T> get_return_object() noexcept;
+
+    std::suspend_always initial_suspend() const noexcept {
+        return {};
+    }
+
+    // emits the terminal notification after the frame is destroyed
+    struct final_awaiter
     {
-        return !(*this == rhs);
+        bool await_ready() const noexcept {
+            return false;
+        }
+        void await_suspend(std::coroutine_handle<generator_promise> h) const noexcept {
+            auto out = std::move(h.promise().out);
+            auto error = std::move(h.promise().error);
+            h.destroy();
+            if (!!error) {
+                out.on_error(error);
+            } else {
+                out.on_completed();
+            }
+        }
+        void await_resume() const noexcept {
+        }
+    };
+    final_awaiter final_suspend() const noexcept {
+        return {};
     }
 
-    value_type const &operator*() const
+    // destroys the frame instead of resuming when the subscription has ended
+    struct yield_awaiter
     {
-        return *(state->value);
+        bool await_ready() const noexcept {
+            return !stopped;
+        }
+        void await_suspend(std::coroutine_handle<> h) const noexcept {
+            h.destroy();
+        }
+        void await_resume() const noexcept {
+        }
+        bool stopped;
+    };
+    template<class U>
+    yield_awaiter yield_value(U&& u) {
+        out.on_next(std::forward<U>(u));
+        return yield_awaiter{!out.is_subscribed()};
     }
 
-    value_type const *operator->() const
+    void return_void() noexcept {
+    }
+    void unhandled_exception() noexcept {
+        error = rxu::current_exception();
+    }
+
+    subscriber<T> out = make_subscriber<T>();
+    rxu::error_ptr error;
+};
+
+}
+
+/// a coroutine that emits each co_yield to a subscriber. see from_generator().
+template<class T>
+class generator
+{
+public:
+    using value_type = T;
+    using promise_type = detail::generator_promise<T>;
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    explicit generator(handle_type h)
+        : coroutine(h)
+    {
+    }
+    generator(generator&& o) noexcept
+        : coroutine(std::exchange(o.coroutine, nullptr))
+    {
+    }
+    generator(const generator&) = delete;
+    generator& operator=(const generator&) = delete;
+    ~generator()
     {
-        return std::addressof(operator*());
+        if (coroutine) {
+            coroutine.destroy();
+        }
     }
 
-    shared_ptr<co_observable_iterator_state<Source>> state;
+    /// runs the generator until it suspends. the frame owns itself from now on and is destroyed
+    /// when it finishes or yields after out is unsubscribed.
+    void start(subscriber<T> out) {
+        auto h = std::exchange(coroutine, nullptr);
+        if (!out.is_subscribed()) {
+            h.destroy();
+            return;
+        }
+        h.promise().out = std::move(out);
+        h.resume();
+    }
+
+private:
+    handle_type coroutine;
 };
 
-template<typename Source>
-co_observable_iterator<Source> co_observable_inc_awaiter<Source>::await_resume() {
-    if (!!state->error) {rethrow_exception(state->error);}
-    return co_observable_iterator<Source>{state};
+namespace detail {
+
+template<class T>
+generator<T> generator_promise<T>::get_return_object() noexcept {
+    return generator<T>(std::coroutine_handle<generator_promise<T>>::from_promise(*this));
 }
 
-template<typename Source>
-struct co_observable_iterator_awaiter
+template<class Factory>
+struct from_task : public rxs::source_base<typename decltype(std::declval<Factory&>()())::value_type>
 {
-    using iterator=co_observable_iterator<Source>;
-    using value_type=typename iterator::value_type;
+    using value_type = typename decltype(std::declval<Factory&>()())::value_type;
+
+    Factory factory;
+
+    explicit from_task(Factory f)
+        : factory(std::move(f))
+    {
+    }
 
-    explicit co_observable_iterator_awaiter(const Source& o) : it(o) {
+    template<class Subscriber>
+    static detached run(task<value_type> t, Subscriber o) {
+        co_await t.when_ready();
+        if (!!t.error()) {
+            o.on_error(t.error());
+            co_return;
+        }
+        o.on_next(t.result());
+        o.on_completed();
     }
 
-    bool await_ready() {
-        return false;
+    template<class Subscriber>
+    void on_subscribe(Subscriber o) const {
+        static_assert(is_subscriber<Subscriber>::value, "subscribe must be passed a subscriber");
+        run(factory(), std::move(o));
     }
+};
 
-    void await_suspend(coroutine_handle<> handle) {
-        weak_ptr<co_observable_iterator_state<Source>> wst=it.state;
-        it.state->caller = handle;
-        it.state->o |
-            rxo::finally([wst](){
-                auto st = wst.lock();
-                if (st && !!st->caller) {
-                    auto caller = st->caller;
-                    st->caller = nullptr;
-                    caller();
-                }
-            }) |
-            rxo::subscribe<value_type>(
-                it.state->lifetime,
-                // next
-                [wst](const value_type& v){
-                    auto st = wst.lock();
-                    if (!st || !st->caller) {terminate();}
-                    st->value = addressof(v);
-                    auto caller = st->caller;
-                    st->caller = nullptr;
-                    caller();
+template<class Factory>
+struct from_generator : public rxs::source_base<typename decltype(std::declval<Factory&>()())::value_type>
+{
+    using value_type = typename decltype(std::declval<Factory&>()())::value_type;
+
+    Factory factory;
+
+    explicit from_generator(Factory f)
+        : factory(std::move(f))
+    {
+    }
+
+    template<class Subscriber>
+    void on_subscribe(Subscriber o) const {
+        static_assert(is_subscriber<Subscriber>::value, "subscribe must be passed a subscriber");
+        factory().start(o.as_dynamic());
+    }
+};
+
+template<class T>
+struct values_state
+{
+    std::mutex lock;
+    std::deque<T> queue;
+    bool done = false;
+    rxu::error_ptr error;
+    std::coroutine_handle<> waiter;
+    composite_subscription lifetime;
+
+    std::coroutine_handle<> take_waiter() {
+        return std::exchange(waiter, nullptr);
+    }
+};
+
+}
+
+/// runs the task returned by f() for each subscription and emits the value of its co_return.
+/// the task keeps running when the subscription ends before it finishes.
+template<class Factory>
+auto from_task(Factory f)
+    ->      observable<typename detail::from_task<Factory>::value_type, detail::from_task<Factory>> {
+    return  observable<typename detail::from_task<Factory>::value_type, detail::from_task<Factory>>(
+                                                                        detail::from_task<Factory>(std::move(f)));
+}
+
+/// runs the generator returned by f() for each subscription.
+/// a generator that is unsubscribed while it is suspended on a worker that is also unsubscribed is never destroyed.
+template<class Factory>
+auto from_generator(Factory f)
+    ->      observable<typename detail::from_generator<Factory>::value_type, detail::from_generator<Factory>> {
+    return  observable<typename detail::from_generator<Factory>::value_type, detail::from_generator<Factory>>(
+                                                                            detail::from_generator<Factory>(std::move(f)));
+}
+
+/// the values of an observable, one co_await at a time. the observable is subscribed by the first next()
+/// and unsubscribed when this is destroyed. values that arrive while the coroutine is not waiting are queued.
+/// the coroutine resumes on the thread that emits the value.
+template<class T>
+class async_values
+{
+    using state_type = detail::values_state<T>;
+
+    std::shared_ptr<state_type> state;
+    std::function<void()> start;
+
+public:
+    template<class Observable>
+    explicit async_values(Observable o)
+        : state(rxu::make_shared_state<state_type>())
+    {
+        std::weak_ptr<state_type> weak = state;
+        start = [o, weak](){
+            auto st = weak.lock();
+            if (!st) {
+                return;
+            }
+            o.subscribe(
+                st->lifetime,
+                [weak](const T& v){
+                    auto st = weak.lock();
+                    if (!st) {
+                        return;
+                    }
+                    std::unique_lock<std::mutex> guard(st->lock);
+                    st->queue.push_back(v);
+                    auto waiter = st->take_waiter();
+                    guard.unlock();
+                    if (waiter) {
+                        waiter.resume();
+                    }
                 },
-                // error
-                [wst](exception_ptr e){
-                    auto st = wst.lock();
-                    if (!st || !st->caller) {terminate();}
+                [weak](rxu::error_ptr e){
+                    auto st = weak.lock();
+                    if (!st) {
+                        return;
+                    }
+                    std::unique_lock<std::mutex> guard(st->lock);
+                    st->done = true;
                     st->error = e;
-                    auto caller = st->caller;
-                    st->caller = nullptr;
-                    caller();
+                    auto waiter = st->take_waiter();
+                    guard.unlock();
+                    if (waiter) {
+                        waiter.resume();
+                    }
+                },
+                [weak](){
+                    auto st = weak.lock();
+                    if (!st) {
+                        return;
+                    }
+                    std::unique_lock<std::mutex> guard(st->lock);
+                    st->done = true;
+                    auto waiter = st->take_waiter();
+                    guard.unlock();
+                    if (waiter) {
+                        waiter.resume();
+                    }
                 });
+        };
+    }
+    async_values(async_values&&) = default;
+    async_values& operator=(async_values&&) = default;
+    ~async_values()
+    {
+        if (state) {
+            state->lifetime.unsubscribe();
+        }
+    }
+
+    /// resumes with the next value, or with an empty maybe once the observable has completed.
+    /// rethrows the error of the observable.
+    auto next() {
+        if (start) {
+            auto subscribe = std::move(start);
+            start = nullptr;
+            subscribe();
+        }
+        struct awaiter
+        {
+            bool await_ready() const {
+                std::unique_lock<std::mutex> guard(state->lock);
+                return !state->queue.empty() || state->done;
+            }
+            bool await_suspend(std::coroutine_handle<> h) const {
+                std::unique_lock<std::mutex> guard(state->lock);
+                if (!state->queue.empty() || state->done) {
+                    return false;
+                }
+                state->waiter = h;
+                return true;
+            }
+            rxu::maybe<T> await_resume() const {
+                std::unique_lock<std::mutex> guard(state->lock);
+                rxu::maybe<T> result;
+                if (!state->queue.empty()) {
+                    result.reset(std::move(state->queue.front()));
+                    state->queue.pop_front();
+                } else if (!!state->error) {
+                    auto error = state->error;
+                    guard.unlock();
+                    rxu::rethrow_exception(error);
+                }
+                return result;
+            }
+            std::shared_ptr<state_type> state;
+        };
+        return awaiter{state};
+    }
+};
+
+/*! @copydoc rx-coroutine.hpp
+ */
+template<class T, class SourceOperator>
+async_values<T> values(const observable<T, SourceOperator>& o) {
+    return async_values<T>(o);
+}
+
+namespace detail {
+
+template<class Observable>
+struct completion_awaiter
+{
+    using value_type = rxu::value_type_t<Observable>;
+
+    enum : int {waiting, suspended, completed};
+
+    explicit completion_awaiter(Observable o)
+        : source(std::move(o))
+        , progress(waiting)
+    {
+    }
+    completion_awaiter(const completion_awaiter& o)
+        : source(o.source)
+        , progress(waiting)
+    {
+    }
+    ~completion_awaiter()
+    {
+        lifetime.unsubscribe();
+    }
+
+    bool await_ready() const noexcept {
+        return false;
+    }
+    bool await_suspend(std::coroutine_handle<> h) {
+        awaiting = h;
+        source.subscribe(
+            lifetime,
+            [this](const value_type& v){
+                last.reset(v);
+            },
+            [this](rxu::error_ptr e){
+                error = e;
+                finish();
+            },
+            [this](){
+                finish();
+            });
+        // the source may have completed on this thread already
+        return progress.exchange(suspended) != completed;
+    }
+    rxu::maybe<value_type> await_resume() {
+        if (!!error) {
+            rxu::rethrow_exception(error);
+        }
+        return std::move(last);
     }
 
-    iterator await_resume() {
-        if (!!it.state->error) {rethrow_exception(it.state->error);}
-        return std::move(it);
+    void finish() {
+        if (progress.exchange(completed) == suspended) {
+            awaiting.resume();
+        }
     }
 
-    iterator it;
+    Observable source;
+    composite_subscription lifetime;
+    std::coroutine_handle<> awaiting;
+    std::atomic<int> progress;
+    rxu::maybe<value_type> last;
+    rxu::error_ptr error;
 };
 
 }
+
+/// resumes with the last value once o has completed, or with an empty maybe when o completes without values.
+/// rethrows the error of o.
+template<class T, class SourceOperator>
+auto completion(const observable<T, SourceOperator>& o)
+    ->      detail::completion_awaiter<observable<T, SourceOperator>> {
+    return  detail::completion_awaiter<observable<T, SourceOperator>>(o);
+}
+
 }
 
-namespace std
+namespace schedulers {
+
+namespace detail {
+
+struct worker_awaiter
 {
+    bool await_ready() const noexcept {
+        return false;
+    }
+    void await_suspend(std::coroutine_handle<> h) const {
+        w.schedule([h](const schedulable&){
+            h.resume();
+        });
+    }
+    void await_resume() const noexcept {
+    }
+    worker w;
+};
+
+}
 
-template<typename T, typename SourceOperator>
-auto begin(const rxcpp::observable<T, SourceOperator>& o)
-    ->      rxcpp::coroutine::co_observable_iterator_awaiter<rxcpp::observable<T, SourceOperator>> {
-    return  rxcpp::coroutine::co_observable_iterator_awaiter<rxcpp::observable<T, SourceOperator>>{o};
+/// `co_await w` resumes the coroutine on the worker w.
+inline detail::worker_awaiter operator co_await(const worker& w) {
+    return detail::worker_awaiter{w};
 }
 
-template<typename T, typename SourceOperator>
-auto end(const rxcpp::observable<T, SourceOperator>&)
-    ->      rxcpp::coroutine::co_observable_iterator<rxcpp::observable<T, SourceOperator>> {
-    return  rxcpp::coroutine::co_observable_iterator<rxcpp::observable<T, SourceOperator>>{};
 }
 
 }
@@ -59,7 +59,7 @@ private:
 
     template<class SO>
     void construct(SO&& source, const rxs::tag_source&) {
-        auto so = std::make_shared<rxu::decay_t<SO>>(std::forward<SO>(source));
+        auto so = rxu::make_shared_state<rxu::decay_t<SO>>(std::forward<SO>(source));
         state->on_get_key = [so]() mutable {
             return so->on_get_key();
         };
@@ -74,7 +74,7 @@ public:
     template<class SOF>
     explicit dynamic_grouped_observable(SOF sof)
         : dynamic_observable<T>(sof)
-        , state(std::make_shared<state_type>())
+        , state(rxu::make_shared_state<state_type>())
     {
         construct(std::move(sof), typename std::conditional_t<is_dynamic_grouped_observable<SOF>::value, tag_dynamic_grouped_observable, rxs::tag_source>());
     }
@@ -82,7 +82,7 @@ public:
     template<class SF, class CF>
     dynamic_grouped_observable(SF&& sf, CF&& cf)
         : dynamic_observable<T>(std::forward<SF>(sf))
-        , state(std::make_shared<state_type>())
+        , state(rxu::make_shared_state<state_type>())
     {
         state->on_connect = std::forward<CF>(cf);
     }
@@ -101,6 +101,16 @@
 #define RXCPP_ON_ANDROID
 #endif
 
+#if defined(__linux__)
+#define RXCPP_ON_LINUX
+#endif
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define RXCPP_USE_COROUTINES 1
+#endif
+#endif
+
 #if defined(RXCPP_FORCE_USE_VARIADIC_TEMPLATES)
 #undef RXCPP_USE_VARIADIC_TEMPLATES
 #define RXCPP_USE_VARIADIC_TEMPLATES RXCPP_FORCE_USE_VARIADIC_TEMPLATES
@@ -146,6 +156,16 @@
 #define RXCPP_ON_ANDROID RXCPP_FORCE_ON_ANDROID
 #endif
 
+#if defined(RXCPP_FORCE_USE_COROUTINES)
+#undef RXCPP_USE_COROUTINES
+#define RXCPP_USE_COROUTINES RXCPP_FORCE_USE_COROUTINES
+#endif
+
+#if defined(RXCPP_FORCE_ON_LINUX)
+#undef RXCPP_ON_LINUX
+#define RXCPP_ON_LINUX RXCPP_FORCE_ON_LINUX
+#endif
+
 #if defined(_MSC_VER) && !RXCPP_USE_VARIADIC_TEMPLATES
 // resolve args needs enough to store all the possible resolved args
 #define _VARIADIC_MAX 10
@@ -165,6 +185,7 @@
 #include <stdlib.h>
 
 #include <cstddef>
+#include <cstring>
 
 #include <string>
 
@@ -187,11 +208,13 @@
 #include <list>
 #include <queue>
 #include <chrono>
+#include <cmath>
 #include <condition_variable>
 #include <initializer_list>
 #include <typeinfo>
 #include <tuple>
 #include <unordered_set>
+#include <unordered_map>
 #include <type_traits>
 #include <utility>
 
@@ -199,6 +222,18 @@
 #include <pthread.h>
 #endif
 
+#if defined(RXCPP_ON_LINUX)
+#include <cerrno>
+#include <system_error>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#endif
+
 #include "rx-util.hpp"
 #include "rx-predef.hpp"
 #include "rx-subscription.hpp"
@@ -228,19 +263,27 @@
 #include "operators/rx-debounce.hpp"
 #include "operators/rx-delay.hpp"
 #include "operators/rx-distinct.hpp"
+#include "operators/rx-distinct_bloom.hpp"
 #include "operators/rx-distinct_until_changed.hpp"
+#include "operators/rx-distinct_within.hpp"
 #include "operators/rx-element_at.hpp"
 #include "operators/rx-filter.hpp"
 #include "operators/rx-finally.hpp"
 #include "operators/rx-flat_map.hpp"
 #include "operators/rx-group_by.hpp"
 #include "operators/rx-ignore_elements.hpp"
+#include "operators/rx-join.hpp"
 #include "operators/rx-map.hpp"
 #include "operators/rx-merge.hpp"
 #include "operators/rx-merge_delay_error.hpp"
+#include "operators/rx-merge_partitions.hpp"
 #include "operators/rx-observe_on.hpp"
 #include "operators/rx-on_error_resume_next.hpp"
+#include "operators/rx-ordered_merge.hpp"
 #include "operators/rx-pairwise.hpp"
+#include "operators/rx-parallel_reduce.hpp"
+#include "operators/rx-parallel_scan.hpp"
+#include "operators/rx-partition.hpp"
 #include "operators/rx-reduce.hpp"
 #include "operators/rx-repeat.hpp"
 #include "operators/rx-replay.hpp"
@@ -252,6 +295,9 @@
 #include "operators/rx-skip_while.hpp"
 #include "operators/rx-skip_last.hpp"
 #include "operators/rx-skip_until.hpp"
+#include "operators/rx-sliding_aggregate.hpp"
+#include "operators/rx-split_lines.hpp"
+#include "operators/rx-split_records.hpp"
 #include "operators/rx-start_with.hpp"
 #include "operators/rx-subscribe_on.hpp"
 #include "operators/rx-switch_if_empty.hpp"
@@ -36,30 +36,36 @@ template<class T>
 class dynamic_observable
     : public rxs::source_base<T>
 {
-    struct state_type
-        : public std::enable_shared_from_this<state_type>
-    {
-        using onsubscribe_type = std::function<void(subscriber < T > )>;
+    using onsubscribe_type = void(*)(void*, subscriber<T>);
 
-        onsubscribe_type on_subscribe;
-    };
-    std::shared_ptr<state_type> state;
+    // the source is shared by the copies, so copies compare equal
+    std::shared_ptr<void> state;
+    onsubscribe_type onsubscribe;
 
     template<class U>
     friend bool operator==(const dynamic_observable<U>&, const dynamic_observable<U>&);
 
+    template<class SO>
+    static void subscribe_source(void* so, subscriber<T> o) {
+        static_cast<SO*>(so)->on_subscribe(std::move(o));
+    }
     template<class SO>
     void construct(SO&& source, rxs::tag_source&&) {
-        rxu::decay_t<SO> so = std::forward<SO>(source);
-        state->on_subscribe = [so](subscriber<T> o) mutable {
-            so.on_subscribe(std::move(o));
-        };
+        using source_type = rxu::decay_t<SO>;
+        state = rxu::make_shared_state<source_type>(std::forward<SO>(source));
+        onsubscribe = &subscribe_source<source_type>;
     }
 
     struct tag_function {};
     template<class F>
+    static void subscribe_function(void* f, subscriber<T> o) {
+        (*static_cast<F*>(f))(std::move(o));
+    }
+    template<class F>
     void construct(F&& f, tag_function&&) {
-        state->on_subscribe = std::forward<F>(f);
+        using function_type = rxu::decay_t<F>;
+        state = rxu::make_shared_state<function_type>(std::forward<F>(f));
+        onsubscribe = &subscribe_function<function_type>;
     }
 
 public:
@@ -67,25 +73,26 @@ public:
     using dynamic_observable_tag = tag_dynamic_observable;
 
     dynamic_observable()
+        : onsubscribe(nullptr)
     {
     }
 
     template<class SOF>
     explicit dynamic_observable(SOF&& sof, typename std::enable_if<!is_dynamic_observable<SOF>::value, void**>::type = 0)
-        : state(std::make_shared<state_type>())
+        : onsubscribe(nullptr)
     {
         construct(std::forward<SOF>(sof),
                   typename std::conditional_t<rxs::is_source<SOF>::value || rxo::is_operator<SOF>::value, rxs::tag_source, tag_function>());
     }
 
     void on_subscribe(subscriber<T> o) const {
-        state->on_subscribe(std::move(o));
+        onsubscribe(state.get(), std::move(o));
     }
 
     template<class Subscriber>
     typename std::enable_if<is_subscriber<Subscriber>::value, void>::type
     on_subscribe(Subscriber o) const {
-        state->on_subscribe(o.as_dynamic());
+        onsubscribe(state.get(), o.as_dynamic());
     }
 };
 
@@ -151,6 +158,46 @@ struct resolve_observable<false, void, SO>
     }
 };
 
+// the values of iterate() over an array of arithmetic values are known without a
+// subscription, so blocking_observable can reduce them directly with the kernels in
+// rx-util.hpp. only identity_one_worker, which is used by iterate() and from(), is
+// recognized because it does not change the values or their order.
+template<class Observable>
+struct contiguous_source : public std::false_type {};
+
+template<class T, class Allocator>
+struct contiguous_source<observable<T, rxs::detail::iterate<std::vector<T, Allocator>, identity_one_worker>>>
+    : public std::integral_constant<bool, std::is_arithmetic<T>::value && !std::is_same<T, bool>::value>
+{
+    template<class Source>
+    static std::pair<const T*, const T*> values(const Source& o) {
+        const auto& c = *o.source_operator.initial.collection_ptr;
+        return std::make_pair(c.data(), c.data() + c.size());
+    }
+};
+
+template<class T, std::size_t Size>
+struct contiguous_source<observable<T, rxs::detail::iterate<std::array<T, Size>, identity_one_worker>>>
+    : public std::is_arithmetic<T>
+{
+    template<class Source>
+    static std::pair<const T*, const T*> values(const Source& o) {
+        const auto& c = *o.source_operator.initial.collection_ptr;
+        return std::make_pair(c.data(), c.data() + c.size());
+    }
+};
+
+template<class T>
+struct contiguous_source<observable<T, rxs::detail::iterate<std::initializer_list<T>, identity_one_worker>>>
+    : public std::is_arithmetic<T>
+{
+    template<class Source>
+    static std::pair<const T*, const T*> values(const Source& o) {
+        const auto& c = *o.source_operator.initial.collection_ptr;
+        return std::make_pair(c.begin(), c.end());
+    }
+};
+
 }
 
 template<class Selector, class Default, template<class... TN> class SO, class... AN>
@@ -332,10 +379,7 @@ public:
         \snippet output.txt blocking count error sample
     */
     int count() const {
-        int result = 0;
-        source.count().as_blocking().subscribe_with_rethrow(
-            [&](int v){result = v;});
-        return result;
+        return count(detail::contiguous_source<observable_type>());
     }
 
     /*! Return the sum of all items emitted by this blocking_observable, or throw an std::runtime_error exception if it emits no items.
@@ -356,7 +400,7 @@ public:
         \snippet output.txt blocking sum error sample
     */
     T sum() const {
-        return source.sum().as_blocking().last();
+        return sum(detail::contiguous_source<observable_type>());
     }
 
     /*! Return the average value of all items emitted by this blocking_observable, or throw an std::runtime_error exception if it emits no items.
@@ -377,7 +421,7 @@ public:
         \snippet output.txt blocking average error sample
     */
     double average() const {
-        return source.average().as_blocking().last();
+        return average(detail::contiguous_source<observable_type>());
     }
 
     /*! Return the max of all items emitted by this blocking_observable, or throw an std::runtime_error exception if it emits no items.
@@ -398,7 +442,7 @@ public:
     \snippet output.txt blocking max error sample
 */
     T max() const {
-        return source.max().as_blocking().last();
+        return max(detail::contiguous_source<observable_type>());
     }
 
     /*! Return the min of all items emitted by this blocking_observable, or throw an std::runtime_error exception if it emits no items.
@@ -419,8 +463,66 @@ public:
     \snippet output.txt blocking min error sample
 */
     T min() const {
+        return min(detail::contiguous_source<observable_type>());
+    }
+
+private:
+    int count(std::false_type) const {
+        int result = 0;
+        source.count().as_blocking().subscribe_with_rethrow(
+            [&](int v){result = v;});
+        return result;
+    }
+    int count(std::true_type) const {
+        auto values = detail::contiguous_source<observable_type>::values(source);
+        return static_cast<int>(values.second - values.first);
+    }
+
+    T sum(std::false_type) const {
+        return source.sum().as_blocking().last();
+    }
+    T sum(std::true_type) const {
+        auto values = detail::contiguous_source<observable_type>::values(source);
+        if (values.first == values.second) {
+            rxu::throw_exception(rxcpp::empty_error("sum() requires a stream with at least one value"));
+        }
+        return rxu::sum_of(values.first, values.second);
+    }
+
+    double average(std::false_type) const {
+        return source.average().as_blocking().last();
+    }
+    double average(std::true_type) const {
+        auto values = detail::contiguous_source<observable_type>::values(source);
+        if (values.first == values.second) {
+            rxu::throw_exception(rxcpp::empty_error("average() requires a stream with at least one value"));
+        }
+        // integers are added as double so that the total does not overflow
+        using total_type = typename std::conditional<std::is_floating_point<T>::value, T, double>::type;
+        return static_cast<double>(rxu::sum_of<T, total_type>(values.first, values.second)) / (values.second - values.first);
+    }
+
+    T max(std::false_type) const {
+        return source.max().as_blocking().last();
+    }
+    T max(std::true_type) const {
+        auto values = detail::contiguous_source<observable_type>::values(source);
+        if (values.first == values.second) {
+            rxu::throw_exception(rxcpp::empty_error("max() requires a stream with at least one value"));
+        }
+        return rxu::max_of(values.first, values.second);
+    }
+
+    T min(std::false_type) const {
         return source.min().as_blocking().last();
     }
+    T min(std::true_type) const {
+        auto values = detail::contiguous_source<observable_type>::values(source);
+        if (values.first == values.second) {
+            rxu::throw_exception(rxcpp::empty_error("min() requires a stream with at least one value"));
+        }
+        return rxu::min_of(values.first, values.second);
+    }
 };
 
 namespace detail {
@@ -881,6 +983,17 @@ public:
         return  observable_member(distinct_tag{},                *this, std::forward<AN>(an)...);
     }
 
+    /*! @copydoc rx-distinct_bloom.hpp
+     */
+    template<class... AN>
+    auto distinct_bloom(AN&&... an) const
+    /// \cond SHOW_SERVICE_MEMBERS
+    -> decltype(observable_member(distinct_bloom_tag{}, std::declval<this_type>(), std::forward<AN>(an)...))
+    /// \endcond
+    {
+        return  observable_member(distinct_bloom_tag{},                *this, std::forward<AN>(an)...);
+    }
+
     /*! @copydoc rx-distinct_until_changed.hpp
      */
     template<class... AN>
@@ -892,6 +1005,17 @@ public:
         return  observable_member(distinct_until_changed_tag{},                *this, std::forward<AN>(an)...);
     }
 
+    /*! @copydoc rx-distinct_within.hpp
+     */
+    template<class... AN>
+    auto distinct_within(AN&&... an) const
+    /// \cond SHOW_SERVICE_MEMBERS
+    -> decltype(observable_member(distinct_within_tag{}, std::declval<this_type>(), std::forward<AN>(an)...))
+    /// \endcond
+    {
+        return  observable_member(distinct_within_tag{},                *this, std::forward<AN>(an)...);
+    }
+
     /*! @copydoc rx-element_at.hpp
      */
     template<class... AN>
@@ -958,6 +1082,17 @@ public:
         return  observable_member(buffer_count_tag{},                *this, std::forward<AN>(an)...);
     }
 
+    /*! @copydoc rx-buffer_count.hpp
+     */
+    template<class... AN>
+    auto buffer_pooled(AN&&... an) const
+    /// \cond SHOW_SERVICE_MEMBERS
+    -> decltype(observable_member(buffer_pooled_tag{}, std::declval<this_type>(), std::forward<AN>(an)...))
+    /// \endcond
+    {
+        return  observable_member(buffer_pooled_tag{},                *this, std::forward<AN>(an)...);
+    }
+
     /*! @copydoc rx-buffer_time.hpp
      */
     template<class... AN>
@@ -1013,6 +1148,28 @@ public:
             return      observable_member(merge_delay_error_tag{},                *this, std::forward<AN>(an)...);
     }
 
+    /*! @copydoc rx-merge_partitions.hpp
+     */
+    template<class... AN>
+    auto merge_partitions(AN&&... an) const
+        /// \cond SHOW_SERVICE_MEMBERS
+        -> decltype(observable_member(merge_partitions_tag{}, std::declval<this_type>(), std::forward<AN>(an)...))
+        /// \endcond
+    {
+        return      observable_member(merge_partitions_tag{},                *this, std::forward<AN>(an)...);
+    }
+
+    /*! @copydoc rx-ordered_merge.hpp
+     */
+    template<class... AN>
+    auto ordered_merge(AN&&... an) const
+    /// \cond SHOW_SERVICE_MEMBERS
+    -> decltype(observable_member(ordered_merge_tag{}, std::declval<this_type>(), std::forward<AN>(an)...))
+    /// \endcond
+    {
+        return  observable_member(ordered_merge_tag{},                *this, std::forward<AN>(an)...);
+    }
+
     /*! @copydoc rx-amb.hpp
      */
     template<class... AN>
@@ -1102,6 +1259,17 @@ public:
         return      observable_member(combine_latest_tag{},                *this, std::forward<AN>(an)...);
     }
 
+    /*! @copydoc rx-combine_latest.hpp
+     */
+    template<class... AN>
+    auto combine_latest_changed(AN... an) const
+        /// \cond SHOW_SERVICE_MEMBERS
+        -> decltype(observable_member(combine_latest_changed_tag{}, std::declval<this_type>(), std::forward<AN>(an)...))
+        /// \endcond
+    {
+        return      observable_member(combine_latest_changed_tag{},                *this, std::forward<AN>(an)...);
+    }
+
     /*! @copydoc rx-zip.hpp
      */
     template<class... AN>
@@ -1135,6 +1303,17 @@ public:
         return  observable_member(ignore_elements_tag{},                *this, std::forward<AN>(an)...);
     }
 
+    /*! @copydoc rx-join.hpp
+     */
+    template<class... AN>
+    auto join(AN&&... an) const
+        /// \cond SHOW_SERVICE_MEMBERS
+        -> decltype(observable_member(join_tag{}, std::declval<this_type>(), std::forward<AN>(an)...))
+        /// \endcond
+    {
+        return      observable_member(join_tag{},                *this, std::forward<AN>(an)...);
+    }
+
     /*! @copydoc rx-muticast.hpp
      */
     template<class... AN>
@@ -1307,6 +1486,54 @@ public:
         static_assert(sizeof...(AN) == 0, "min() was passed too many arguments.");
     }
 
+    /*! @copydoc rxcpp::operators::sum_all
+     */
+    template<class... AN>
+    auto sum_all(AN**...) const
+        /// \cond SHOW_SERVICE_MEMBERS
+        -> decltype(observable_member(delayed_type<sum_all_tag, AN...>::value(), std::declval<this_type>()))
+        /// \endcond
+    {
+        return      observable_member(delayed_type<sum_all_tag, AN...>::value(),                *this);
+        static_assert(sizeof...(AN) == 0, "sum_all() was passed too many arguments.");
+    }
+
+    /*! @copydoc rxcpp::operators::average_all
+     */
+    template<class... AN>
+    auto average_all(AN**...) const
+        /// \cond SHOW_SERVICE_MEMBERS
+        -> decltype(observable_member(delayed_type<average_all_tag, AN...>::value(), std::declval<this_type>()))
+        /// \endcond
+    {
+        return      observable_member(delayed_type<average_all_tag, AN...>::value(),                *this);
+        static_assert(sizeof...(AN) == 0, "average_all() was passed too many arguments.");
+    }
+
+    /*! @copydoc rxcpp::operators::max_all
+     */
+    template<class... AN>
+    auto max_all(AN**...) const
+        /// \cond SHOW_SERVICE_MEMBERS
+        -> decltype(observable_member(delayed_type<max_all_tag, AN...>::value(), std::declval<this_type>()))
+        /// \endcond
+    {
+        return      observable_member(delayed_type<max_all_tag, AN...>::value(),                *this);
+        static_assert(sizeof...(AN) == 0, "max_all() was passed too many arguments.");
+    }
+
+    /*! @copydoc rxcpp::operators::min_all
+     */
+    template<class... AN>
+    auto min_all(AN**...) const
+        /// \cond SHOW_SERVICE_MEMBERS
+        -> decltype(observable_member(delayed_type<min_all_tag, AN...>::value(), std::declval<this_type>()))
+        /// \endcond
+    {
+        return      observable_member(delayed_type<min_all_tag, AN...>::value(),                *this);
+        static_assert(sizeof...(AN) == 0, "min_all() was passed too many arguments.");
+    }
+
     /*! @copydoc rx-scan.hpp
     */
     template<class... AN>
@@ -1329,6 +1556,17 @@ public:
         return      observable_member(sample_with_time_tag{},                *this, std::forward<AN>(an)...);
     }
 
+    /*! @copydoc rx-sliding_aggregate.hpp
+    */
+    template<class... AN>
+    auto sliding_aggregate(AN&&... an) const
+        /// \cond SHOW_SERVICE_MEMBERS
+        -> decltype(observable_member(sliding_aggregate_tag{}, std::declval<this_type>(), std::forward<AN>(an)...))
+        /// \endcond
+    {
+        return      observable_member(sliding_aggregate_tag{},                *this, std::forward<AN>(an)...);
+    }
+
     /*! @copydoc rx-skip.hpp
     */
     template<class... AN>
@@ -1439,6 +1677,28 @@ public:
         return      observable_member(retry_tag{},                *(this_type*)this, std::forward<AN>(an)...);
     }
 
+    /*! @copydoc rx-split_lines.hpp
+     */
+    template<class... AN>
+    auto split_lines(AN&&... an) const
+        /// \cond SHOW_SERVICE_MEMBERS
+        -> decltype(observable_member(split_lines_tag{}, std::declval<this_type>(), std::forward<AN>(an)...))
+        /// \endcond
+    {
+        return      observable_member(split_lines_tag{},                *this, std::forward<AN>(an)...);
+    }
+
+    /*! @copydoc rx-split_records.hpp
+     */
+    template<class... AN>
+    auto split_records(AN&&... an) const
+        /// \cond SHOW_SERVICE_MEMBERS
+        -> decltype(observable_member(split_records_tag{}, std::declval<this_type>(), std::forward<AN>(an)...))
+        /// \endcond
+    {
+        return      observable_member(split_records_tag{},                *this, std::forward<AN>(an)...);
+    }
+
     /*! @copydoc rx-start_with.hpp
      */
     template<class... AN>
@@ -1450,6 +1710,39 @@ public:
         return      observable_member(start_with_tag{},                *this, std::forward<AN>(an)...);
     }
 
+    /*! @copydoc rx-parallel_reduce.hpp
+    */
+    template<class... AN>
+    auto parallel_reduce(AN&&... an) const
+        /// \cond SHOW_SERVICE_MEMBERS
+        -> decltype(observable_member(parallel_reduce_tag{}, std::declval<this_type>(), std::forward<AN>(an)...))
+        /// \endcond
+    {
+        return      observable_member(parallel_reduce_tag{},                *this, std::forward<AN>(an)...);
+    }
+
+    /*! @copydoc rx-parallel_scan.hpp
+    */
+    template<class... AN>
+    auto parallel_scan(AN&&... an) const
+        /// \cond SHOW_SERVICE_MEMBERS
+        -> decltype(observable_member(parallel_scan_tag{}, std::declval<this_type>(), std::forward<AN>(an)...))
+        /// \endcond
+    {
+        return      observable_member(parallel_scan_tag{},                *this, std::forward<AN>(an)...);
+    }
+
+    /*! @copydoc rx-partition.hpp
+     */
+    template<class... AN>
+    auto partition(AN&&... an) const
+        /// \cond SHOW_SERVICE_MEMBERS
+        -> decltype(observable_member(partition_tag{}, std::declval<this_type>(), std::forward<AN>(an)...))
+        /// \endcond
+    {
+        return      observable_member(partition_tag{},                *this, std::forward<AN>(an)...);
+    }
+
     /*! @copydoc rx-pairwise.hpp
      */
     template<class... AN>
@@ -214,7 +214,11 @@ public:
         , oncompleted(o.oncompleted)
     {
     }
-    observer(this_type&& o)
+    observer(this_type&& o) noexcept(
+            std::is_nothrow_move_constructible<state_t>::value &&
+            std::is_nothrow_move_constructible<on_next_t>::value &&
+            std::is_nothrow_move_constructible<on_error_t>::value &&
+            std::is_nothrow_move_constructible<on_completed_t>::value)
         : state(std::move(o.state))
         , onnext(std::move(o.onnext))
         , onerror(std::move(o.onerror))
@@ -294,7 +298,10 @@ public:
         , oncompleted(o.oncompleted)
     {
     }
-    observer(this_type&& o)
+    observer(this_type&& o) noexcept(
+            std::is_nothrow_move_constructible<on_next_t>::value &&
+            std::is_nothrow_move_constructible<on_error_t>::value &&
+            std::is_nothrow_move_constructible<on_completed_t>::value)
         : onnext(std::move(o.onnext))
         , onerror(std::move(o.onerror))
         , oncompleted(std::move(o.oncompleted))
@@ -326,43 +333,41 @@ public:
 namespace detail
 {
 
+// the functions that call an observer kept in an erased_storage
 template<class T>
-struct virtual_observer : public std::enable_shared_from_this<virtual_observer<T>>
+struct observer_vtable
 {
-    virtual ~virtual_observer() {}
-    virtual void on_next(const T&) const {};
-    virtual void on_next(T&&) const {};
-    virtual void on_error(rxu::error_ptr) const {};
-    virtual void on_completed() const {};
+    void (*on_next_copy)(const void*, const T&);
+    void (*on_next_move)(const void*, T&&);
+    void (*on_error)(const void*, rxu::error_ptr);
+    void (*on_completed)(const void*);
 };
 
 template<class T, class Observer>
-struct specific_observer : public virtual_observer<T>
+struct specific_observer
 {
-    explicit specific_observer(Observer o)
-        : destination(std::move(o))
-    {
+    static void on_next_copy(const void* o, const T& t) {
+        static_cast<const Observer*>(o)->on_next(t);
     }
-
-    Observer destination;
-    void on_next(const T& t) const override {
-        destination.on_next(t);
+    static void on_next_move(const void* o, T&& t) {
+        static_cast<const Observer*>(o)->on_next(std::move(t));
     }
-    void on_next(T&& t) const override{
-        destination.on_next(std::move(t));
+    static void on_error(const void* o, rxu::error_ptr e) {
+        static_cast<const Observer*>(o)->on_error(e);
     }
-    void on_error(rxu::error_ptr e) const override{
-        destination.on_error(e);
+    static void on_completed(const void* o) {
+        static_cast<const Observer*>(o)->on_completed();
     }
-    void on_completed() const override {
-        destination.on_completed();
+    static const observer_vtable<T>* vtable() {
+        static const observer_vtable<T> instance = {&on_next_copy, &on_next_move, &on_error, &on_completed};
+        return &instance;
     }
 };
 
 }
 
 /*!
-    \brief consumes values from an observable using type-forgetting (shared allocated state with virtual methods)
+    \brief consumes values from an observable using type-forgetting (small observers are stored inline, larger ones in shared allocated state)
 
     \tparam T            - the type of value in the stream
 
@@ -378,55 +383,71 @@ public:
 private:
     using this_type = observer<T, void, void, void, void>;
     using base_type = observer_base<T>;
-    using virtual_observer = detail::virtual_observer<T>;
+    using vtable_type = detail::observer_vtable<T>;
 
-    std::shared_ptr<virtual_observer> destination;
+    rxu::erased_storage<> destination;
+    const vtable_type* vtable;
+    // the address of the observer in destination, which changes when destination is copied or moved
+    void* target;
 
-    template<class Observer>
-    static auto make_destination(Observer o)
-        -> std::shared_ptr<virtual_observer> {
-        return std::make_shared<detail::specific_observer<T, Observer>>(std::move(o));
+    void next(const T& t) const {
+        vtable->on_next_copy(target, t);
+    }
+    void next(T&& t) const {
+        vtable->on_next_move(target, std::move(t));
     }
 
 public:
     observer()
+        : vtable(nullptr)
+        , target(nullptr)
     {
     }
     observer(const this_type& o)
         : destination(o.destination)
+        , vtable(o.vtable)
+        , target(destination.get())
     {
     }
-    observer(this_type&& o)
+    observer(this_type&& o) RXCPP_NOEXCEPT
         : destination(std::move(o.destination))
+        , vtable(o.vtable)
+        , target(destination.get())
     {
+        o.vtable = nullptr;
+        o.target = nullptr;
     }
 
     template<class Observer>
     explicit observer(Observer o)
-        : destination(make_destination(std::move(o)))
+        : destination(std::move(o))
+        , vtable(detail::specific_observer<T, Observer>::vtable())
+        , target(destination.get())
     {
     }
 
     this_type& operator=(this_type o) {
         destination = std::move(o.destination);
+        vtable = o.vtable;
+        target = destination.get();
         return *this;
     }
 
     // perfect forwarding delays the copy of the value.
     template<class V>
     void on_next(V&& v) const {
-        if (destination) {
-            destination->on_next(std::forward<V>(v));
+        if (vtable) {
+            next(std::forward<V>(v));
         }
     }
     void on_error(rxu::error_ptr e) const {
-        if (destination) {
-            destination->on_error(e);
+        if (vtable) {
+            vtable->on_error(target, e);
         }
     }
     void on_completed() const {
-        if (destination) {
-            destination->on_completed();
+        if (vtable) {
+            vtable->on_completed(target);
         }
     }
 
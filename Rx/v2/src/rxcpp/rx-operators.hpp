@@ -133,6 +133,13 @@ struct buffer_count_tag {
     };
 };
 
+struct buffer_pooled_tag {
+    template<class Included>
+    struct include_header{
+        static_assert(Included::value, "missing include: please #include <rxcpp/operators/rx-buffer_count.hpp>");
+    };
+};
+
 struct buffer_with_time_tag {
     template<class Included>
     struct include_header{
@@ -154,6 +161,13 @@ struct combine_latest_tag {
     };
 };
 
+struct combine_latest_changed_tag {
+    template<class Included>
+    struct include_header{
+        static_assert(Included::value, "missing include: please #include <rxcpp/operators/rx-combine_latest.hpp>");
+    };
+};
+
 struct concat_tag {
     template<class Included>
     struct include_header{
@@ -196,6 +210,13 @@ struct distinct_tag {
     };
 };
 
+struct distinct_bloom_tag {
+    template<class Included>
+    struct include_header{
+        static_assert(Included::value, "missing include: please #include <rxcpp/operators/rx-distinct_bloom.hpp>");
+    };
+};
+
 struct distinct_until_changed_tag {
     template<class Included>
     struct include_header{
@@ -203,6 +224,13 @@ struct distinct_until_changed_tag {
     };
 };
 
+struct distinct_within_tag {
+    template<class Included>
+    struct include_header{
+        static_assert(Included::value, "missing include: please #include <rxcpp/operators/rx-distinct_within.hpp>");
+    };
+};
+
 struct element_at_tag {
     template<class Included>
     struct include_header{
@@ -245,6 +273,13 @@ struct ignore_elements_tag {
     };
 };
 
+struct join_tag {
+    template<class Included>
+    struct include_header{
+        static_assert(Included::value, "missing include: please #include <rxcpp/operators/rx-join.hpp>");
+    };
+};
+
 struct map_tag {
     template<class Included>
     struct include_header{
@@ -265,6 +300,13 @@ struct merge_delay_error_tag {
     };
 };
 
+struct merge_partitions_tag {
+    template<class Included>
+    struct include_header{
+        static_assert(Included::value, "missing include: please #include <rxcpp/operators/rx-merge_partitions.hpp>");
+    };
+};
+
 struct multicast_tag {
     template<class Included>
     struct include_header{
@@ -305,6 +347,10 @@ struct sum_tag : reduce_tag {};
 struct average_tag : reduce_tag {};
 struct min_tag : reduce_tag {};
 struct max_tag : reduce_tag {};
+struct sum_all_tag : reduce_tag {};
+struct average_all_tag : reduce_tag {};
+struct min_all_tag : reduce_tag {};
+struct max_all_tag : reduce_tag {};
 
 struct ref_count_tag {
     template<class Included>
@@ -313,6 +359,13 @@ struct ref_count_tag {
     };
 };
 
+struct ordered_merge_tag {
+    template<class Included>
+    struct include_header{
+        static_assert(Included::value, "missing include: please #include <rxcpp/operators/rx-ordered_merge.hpp>");
+    };
+};
+
 struct pairwise_tag {
     template<class Included>
     struct include_header{
@@ -320,6 +373,27 @@ struct pairwise_tag {
     };
 };
 
+struct parallel_reduce_tag {
+    template<class Included>
+    struct include_header{
+        static_assert(Included::value, "missing include: please #include <rxcpp/operators/rx-parallel_reduce.hpp>");
+    };
+};
+
+struct parallel_scan_tag {
+    template<class Included>
+    struct include_header{
+        static_assert(Included::value, "missing include: please #include <rxcpp/operators/rx-parallel_scan.hpp>");
+    };
+};
+
+struct partition_tag {
+    template<class Included>
+    struct include_header{
+        static_assert(Included::value, "missing include: please #include <rxcpp/operators/rx-partition.hpp>");
+    };
+};
+
 struct publish_tag {
     template<class Included>
     struct include_header{
@@ -398,6 +472,27 @@ struct skip_until_tag {
     };
 };
 
+struct sliding_aggregate_tag {
+    template<class Included>
+    struct include_header{
+        static_assert(Included::value, "missing include: please #include <rxcpp/operators/rx-sliding_aggregate.hpp>");
+    };
+};
+
+struct split_lines_tag {
+    template<class Included>
+    struct include_header{
+        static_assert(Included::value, "missing include: please #include <rxcpp/operators/rx-split_lines.hpp>");
+    };
+};
+
+struct split_records_tag {
+    template<class Included>
+    struct include_header{
+        static_assert(Included::value, "missing include: please #include <rxcpp/operators/rx-split_records.hpp>");
+    };
+};
+
 struct start_with_tag {
     template<class Included>
     struct include_header{
@@ -17,7 +17,7 @@ class scheduler_interface;
 namespace detail {
 
 class action_type;
-    using action_ptr = std::shared_ptr<action_type>;
+    using action_ptr = rxu::intrusive_ptr<action_type>;
 
     using worker_interface_ptr = std::shared_ptr<worker_interface>;
     using const_worker_interface_ptr = std::shared_ptr<const worker_interface>;
@@ -29,7 +29,7 @@ class action_type;
     using const_scheduler_interface_ptr = std::shared_ptr<const scheduler_interface>;
 
 inline action_ptr shared_empty() {
-    static action_ptr shared_empty = std::make_shared<detail::action_type>();
+    static action_ptr shared_empty = rxu::make_intrusive_state<detail::action_type>();
     return shared_empty;
 }
 
@@ -652,7 +652,7 @@ struct current_thread;
 namespace detail {
 
 class action_type
-    : public std::enable_shared_from_this<action_type>
+    : public rxu::intrusive_ref_counted<>
 {
     using this_type = action_type;
 
@@ -681,7 +681,6 @@ public:
 };
 
 class action_tailrecurser
-    : public std::enable_shared_from_this<action_type>
 {
     using this_type = action_type;
 
@@ -735,7 +734,7 @@ template<class F>
 inline action make_action(F&& f) {
     static_assert(detail::is_action_function<F>::value, "action function must be void(schedulable)");
     auto fn = std::forward<F>(f);
-    return action(std::make_shared<detail::action_type>(detail::action_tailrecurser(fn)));
+    return action(rxu::make_intrusive_state<detail::action_type>(detail::action_tailrecurser(std::move(fn))));
 }
 
 // copy
@@ -846,7 +845,7 @@ auto worker::schedule_periodically(clock_type::time_point initial, clock_type::d
 template<class... ArgN>
 void worker::schedule_periodically_rebind(clock_type::time_point initial, clock_type::duration period, const schedulable& scbl, ArgN&&... an) const {
     auto keepAlive = *this;
-    auto target = std::make_shared<clock_type::time_point>(initial);
+    auto target = rxu::make_shared_state<clock_type::time_point>(initial);
     auto activity = make_schedulable(scbl, keepAlive, std::forward<ArgN>(an)...);
     auto periodic = make_schedulable(
         activity,
@@ -865,6 +864,122 @@ void worker::schedule_periodically_rebind(clock_type::time_point initial, clock_
     trace_activity().schedule_when_return(*inner.get());
 }
 
+/// deadline_timer calls a function once a deadline on a worker has passed.
+/// the deadline can be moved with arm() any number of times. at most one
+/// item is live in the worker queue for each timer: moving the deadline
+/// later is O(1) and does not allocate, the queued item re-checks the
+/// deadline when it runs and re-queues itself if the deadline was moved.
+/// arm() and cancel() must be called from actions running on the worker.
+class deadline_timer
+{
+    using this_type = deadline_timer;
+
+public:
+    using clock_type = scheduler_base::clock_type;
+    using function_type = std::function<void(const schedulable&)>;
+
+private:
+    struct timer_state_type
+    {
+        timer_state_type(worker w, function_type f)
+            : controller(std::move(w))
+            , f(std::move(f))
+            , generation(0)
+            , armed(false)
+            , queued(false)
+        {
+        }
+        worker controller;
+        function_type f;
+        schedulable entry;
+        std::size_t generation;
+        clock_type::time_point due;
+        clock_type::time_point deadline;
+        bool armed;
+        bool queued;
+    };
+    std::shared_ptr<timer_state_type> state;
+
+    static schedulable make_entry(const std::shared_ptr<timer_state_type>& state) {
+        std::weak_ptr<timer_state_type> weak = state;
+        auto id = state->generation;
+        return make_schedulable(state->controller, [weak, id](const schedulable& self) {
+            auto st = weak.lock();
+            if (!st || id != st->generation) {
+                // the timer was destroyed or this item was abandoned for an earlier deadline
+                return;
+            }
+            st->queued = false;
+            if (!st->armed) {
+                return;
+            }
+            if (st->controller.now() < st->deadline) {
+                // the deadline moved while this item was queued
+                st->due = st->deadline;
+                st->queued = true;
+                st->controller.schedule(st->due, self);
+                return;
+            }
+            st->armed = false;
+            st->f(self);
+        });
+    }
+
+public:
+    deadline_timer()
+    {
+    }
+    deadline_timer(worker w, function_type f)
+        : state(rxu::make_shared_state<timer_state_type>(std::move(w), std::move(f)))
+    {
+        state->entry = make_entry(state);
+    }
+
+    /// true when the function will be called at the deadline
+    inline bool is_armed() const {
+        return !!state && state->armed;
+    }
+
+    /// return the current deadline
+    inline clock_type::time_point deadline() const {
+        return state->deadline;
+    }
+
+    /// call the function at the specified time, replacing any previous deadline.
+    inline void arm(clock_type::time_point when) const {
+        state->deadline = when;
+        state->armed = true;
+        if (state->queued) {
+            if (state->due <= when) {
+                // the queued item will re-queue itself for the new deadline
+                return;
+            }
+            // abandon the queued item, it would run too late
+            ++state->generation;
+            state->entry = make_entry(state);
+        }
+        state->due = when;
+        state->queued = true;
+        state->controller.schedule(when, state->entry);
+    }
+
+    /// call the function after the specified delay from now, replacing any previous deadline.
+    inline void arm(clock_type::duration delay) const {
+        arm(state->controller.now() + delay);
+    }
+
+    /// do not call the function. the queued item, if any, is left to expire.
+    inline void cancel() const {
+        if (!!state) {
+            state->armed = false;
+        }
+    }
+};
+
+inline deadline_timer make_deadline_timer(worker w, deadline_timer::function_type f) {
+    return deadline_timer(std::move(w), std::move(f));
+}
+
 namespace detail {
 
 template<class TimePoint>
@@ -948,6 +1063,7 @@ namespace rxsc=schedulers;
 
 #include "schedulers/rx-currentthread.hpp"
 #include "schedulers/rx-runloop.hpp"
+#include "schedulers/rx-epollreactor.hpp"
 #include "schedulers/rx-newthread.hpp"
 #include "schedulers/rx-eventloop.hpp"
 #include "schedulers/rx-immediate.hpp"
@@ -45,5 +45,7 @@ namespace rxs=sources;
 #include "sources/rx-error.hpp"
 #include "sources/rx-scope.hpp"
 #include "sources/rx-timer.hpp"
+#include "sources/rx-from_fd.hpp"
+#include "sources/rx-mmap_file.hpp"
 
 #endif
@@ -110,7 +110,7 @@ public:
         , id(o.id)
     {
     }
-    subscriber(this_type&& o)
+    subscriber(this_type&& o) noexcept(std::is_nothrow_move_constructible<observer_type>::value)
         : lifetime(std::move(o.lifetime))
         , destination(std::move(o.destination))
         , id(std::move(o.id))
@@ -66,7 +66,7 @@ public:
 
 class subscription : public subscription_base
 {
-    class base_subscription_state : public std::enable_shared_from_this<base_subscription_state>
+    class base_subscription_state : public rxu::intrusive_ref_counted<>
     {
         base_subscription_state();
     public:
@@ -81,7 +81,7 @@ class subscription : public subscription_base
         std::atomic<bool> issubscribed;
     };
 public:
-    using weak_state_type = std::weak_ptr<base_subscription_state>;
+    using weak_state_type = rxu::intrusive_weak_ptr<base_subscription_state>;
 
 private:
     template<class I>
@@ -96,15 +96,19 @@ private:
         virtual void unsubscribe() {
             if (issubscribed.exchange(false)) {
                 trace_activity().unsubscribe_enter(*this);
-                inner.unsubscribe();
+                inner->unsubscribe();
                 trace_activity().unsubscribe_return(*this);
             }
         }
-        inner_t inner;
+        // weak references may keep the state after the last strong reference is gone
+        virtual void release() {
+            inner.reset();
+        }
+        rxu::detail::maybe<inner_t> inner;
     };
 
 protected:
-    std::shared_ptr<base_subscription_state> state;
+    rxu::intrusive_ptr<base_subscription_state> state;
 
     friend bool operator<(const subscription&, const subscription&);
     friend bool operator==(const subscription&, const subscription&);
@@ -118,7 +122,7 @@ private:
         }
     }
 
-    explicit subscription(std::shared_ptr<base_subscription_state> s)
+    explicit subscription(rxu::intrusive_ptr<base_subscription_state> s)
         : state(std::move(s))
     {
         if (!state) {
@@ -128,7 +132,7 @@ private:
 public:
 
     subscription()
-        : state(std::make_shared<base_subscription_state>(false))
+        : state(rxu::make_intrusive_state<base_subscription_state>(false))
     {
         if (!state) {
             std::terminate();
@@ -136,7 +140,7 @@ public:
     }
     template<class U>
     explicit subscription(U u, typename std::enable_if<!is_subscription<U>::value, void**>::type = nullptr)
-        : state(std::make_shared<subscription_state<U>>(std::move(u)))
+        : state(rxu::make_intrusive_state<subscription_state<U>>(std::move(u)))
     {
         if (!state) {
             std::terminate();
@@ -158,7 +162,7 @@ public:
             std::terminate();
         }
     }
-    subscription(subscription&& o)
+    subscription(subscription&& o) RXCPP_NOEXCEPT
         : state(std::move(o.state))
     {
         if (!state) {
@@ -243,7 +247,7 @@ class composite_subscription_inner
 {
 private:
     using weak_subscription = subscription::weak_state_type;
-    struct composite_subscription_state : public std::enable_shared_from_this<composite_subscription_state>
+    struct composite_subscription_state : public rxu::intrusive_ref_counted<>
     {
         // invariant: cannot access this data without the lock held.
         std::set<subscription> subscriptions;
@@ -270,6 +274,12 @@ private:
         {
         }
 
+        // weak references may keep the state after the last strong reference is gone.
+        // the lock is not needed, nothing else can reach the subscriptions now.
+        virtual void release() {
+            subscriptions.clear();
+        }
+
         // Atomically add 's' to the set of subscriptions.
         //
         // If unsubscribe() has already occurred, this immediately
@@ -381,18 +391,18 @@ private:
     };
 
 public:
-    using shared_state_type = std::shared_ptr<composite_subscription_state>;
+    using shared_state_type = rxu::intrusive_ptr<composite_subscription_state>;
 
 protected:
     mutable shared_state_type state;
 
 public:
     composite_subscription_inner()
-        : state(std::make_shared<composite_subscription_state>())
+        : state(rxu::make_intrusive_state<composite_subscription_state>())
     {
     }
     composite_subscription_inner(tag_composite_subscription_empty et)
-        : state(std::make_shared<composite_subscription_state>(et))
+        : state(rxu::make_intrusive_state<composite_subscription_state>(et))
     {
     }
 
@@ -403,7 +413,7 @@ public:
             std::terminate();
         }
     }
-    composite_subscription_inner(composite_subscription_inner&& o)
+    composite_subscription_inner(composite_subscription_inner&& o) RXCPP_NOEXCEPT
         : state(std::move(o.state))
     {
         if (!state) {
@@ -483,7 +493,7 @@ public:
         , subscription(static_cast<const subscription&>(o))
     {
     }
-    composite_subscription(composite_subscription&& o)
+    composite_subscription(composite_subscription&& o) RXCPP_NOEXCEPT
         : inner_type(std::move(o))
         , subscription(std::move(static_cast<subscription&>(o)))
     {
@@ -559,13 +569,13 @@ public:
 
     resource()
         : lifetime(composite_subscription())
-        , value(std::make_shared<rxu::detail::maybe<T>>())
+        , value(rxu::make_shared_state<rxu::detail::maybe<T>>())
     {
     }
 
     explicit resource(T t, composite_subscription cs = composite_subscription())
         : lifetime(std::move(cs))
-        , value(std::make_shared<rxu::detail::maybe<T>>(rxu::detail::maybe<T>(std::move(t))))
+        , value(rxu::make_shared_state<rxu::detail::maybe<T>>(rxu::detail::maybe<T>(std::move(t))))
     {
         auto localValue = value;
         lifetime.add(
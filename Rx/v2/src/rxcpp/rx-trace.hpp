@@ -15,7 +15,15 @@ struct trace_id
 {
     static inline trace_id make_next_id_subscriber() {
         static std::atomic<unsigned long> id(0xB0000000);
-        return trace_id{++id};
+        // each thread reserves a block of ids so that threads do not contend on the counter
+        const unsigned long block = 256;
+        static thread_local unsigned long next = 0;
+        static thread_local unsigned long last = 0;
+        if (next == last) {
+            next = id.fetch_add(block) + 1;
+            last = next + block;
+        }
+        return trace_id{next++};
     }
     unsigned long id;
 };
@@ -697,8 +697,1308 @@ public:
     }
 };
 
+/// fifo queue in one contiguous allocation. the capacity is a power of
+/// two and doubles when full, so push_back and pop_front do not allocate
+/// once the queue has reached its working size.
+template <class T>
+class ring_buffer
+{
+    using storage_type = typename std::aligned_storage<sizeof(T), std::alignment_of<T>::value>::type;
+
+    std::unique_ptr<storage_type[]> storage;
+    std::size_t mask;
+    std::size_t head;
+    std::size_t count;
+
+    T* at(std::size_t i) {
+        return reinterpret_cast<T*>(&storage[(head + i) & mask]);
+    }
+    const T* at(std::size_t i) const {
+        return reinterpret_cast<const T*>(&storage[(head + i) & mask]);
+    }
+
+    void grow(std::size_t minimum) {
+        std::size_t next = !storage ? 8 : mask + 1;
+        while (next < minimum) {
+            next *= 2;
+        }
+        std::unique_ptr<storage_type[]> replacement(new storage_type[next]);
+        for (std::size_t i = 0; i != count; ++i) {
+            new (reinterpret_cast<T*>(&replacement[i])) T(std::move(*at(i)));
+            at(i)->~T();
+        }
+        storage = std::move(replacement);
+        mask = next - 1;
+        head = 0;
+    }
+
+public:
+    using value_type = T;
+
+    ring_buffer()
+        : mask(0)
+        , head(0)
+        , count(0)
+    {
+    }
+    explicit ring_buffer(std::size_t initial)
+        : mask(0)
+        , head(0)
+        , count(0)
+    {
+        reserve(initial);
+    }
+    ring_buffer(const ring_buffer& other)
+        : mask(0)
+        , head(0)
+        , count(0)
+    {
+        reserve(other.count);
+        for (std::size_t i = 0; i != other.count; ++i) {
+            emplace_back(*other.at(i));
+        }
+    }
+    ring_buffer(ring_buffer&& other)
+        : storage(std::move(other.storage))
+        , mask(other.mask)
+        , head(other.head)
+        , count(other.count)
+    {
+        other.mask = 0;
+        other.head = 0;
+        other.count = 0;
+    }
+    ring_buffer& operator=(ring_buffer other) {
+        clear();
+        storage = std::move(other.storage);
+        mask = other.mask;
+        head = other.head;
+        count = other.count;
+        other.mask = 0;
+        other.head = 0;
+        other.count = 0;
+        return *this;
+    }
+    ~ring_buffer()
+    {
+        clear();
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+    std::size_t size() const {
+        return count;
+    }
+    std::size_t capacity() const {
+        return !storage ? 0 : mask + 1;
+    }
+
+    void reserve(std::size_t n) {
+        if (n > capacity()) {
+            grow(n);
+        }
+    }
+
+    T& front() {
+        if (count == 0) std::terminate();
+        return *at(0);
+    }
+    const T& front() const {
+        if (count == 0) std::terminate();
+        return *at(0);
+    }
+    T& back() {
+        if (count == 0) std::terminate();
+        return *at(count - 1);
+    }
+    const T& back() const {
+        if (count == 0) std::terminate();
+        return *at(count - 1);
+    }
+    T& operator[](std::size_t i) {
+        return *at(i);
+    }
+    const T& operator[](std::size_t i) const {
+        return *at(i);
+    }
+
+    template<class... VN>
+    T& emplace_back(VN&&... vn) {
+        if (count == capacity()) {
+            grow(count + 1);
+        }
+        auto p = new (at(count)) T(std::forward<VN>(vn)...);
+        ++count;
+        return *p;
+    }
+    void push_back(const T& v) {
+        emplace_back(v);
+    }
+    void push_back(T&& v) {
+        emplace_back(std::move(v));
+    }
+
+    void pop_front() {
+        if (count == 0) std::terminate();
+        at(0)->~T();
+        head = (head + 1) & mask;
+        --count;
+    }
+
+    void clear() {
+        while (count != 0) {
+            pop_front();
+        }
+        head = 0;
+    }
+};
+
+}
+using detail::maybe;
+using detail::ring_buffer;
+
+template<class T>
+class pooled_buffer;
+
+/// recycles the storage of std::vector<T> buffers so that a steady stream
+/// of buffers of the same size does not allocate. pooled_buffer returns its
+/// storage here when it is destroyed. at most 'retain' free buffers are kept.
+template<class T>
+class buffer_pool
+{
+    using this_type = buffer_pool<T>;
+    buffer_pool(const this_type&);
+    this_type& operator=(const this_type&);
+
+    std::size_t reserved;
+    std::size_t retain;
+    std::mutex lock;
+    std::vector<std::vector<T>> free;
+
+public:
+    explicit buffer_pool(std::size_t reserved, std::size_t retain = 16)
+        : reserved(reserved)
+        , retain(retain)
+    {
+    }
+
+    /// take a cleared buffer with at least the reserved capacity
+    std::vector<T> take() {
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            if (!free.empty()) {
+                auto result = std::move(free.back());
+                free.pop_back();
+                return result;
+            }
+        }
+        std::vector<T> result;
+        result.reserve(reserved);
+        return result;
+    }
+
+    /// return the storage of a buffer to the pool
+    void give(std::vector<T>&& v) {
+        v.clear();
+        std::unique_lock<std::mutex> guard(lock);
+        if (free.size() < retain) {
+            free.push_back(std::move(v));
+        }
+    }
+};
+
+/// a std::vector<T> whose storage is returned to a buffer_pool when it is
+/// destroyed or released. copies take their storage from the same pool.
+template<class T>
+class pooled_buffer
+{
+    using this_type = pooled_buffer<T>;
+    using pool_ptr = std::shared_ptr<buffer_pool<T>>;
+
+    pool_ptr pool;
+    std::vector<T> storage;
+
+public:
+    using value_type = T;
+    using size_type = typename std::vector<T>::size_type;
+    using iterator = typename std::vector<T>::iterator;
+    using const_iterator = typename std::vector<T>::const_iterator;
+
+    pooled_buffer()
+    {
+    }
+    explicit pooled_buffer(pool_ptr p)
+        : pool(std::move(p))
+        , storage(pool->take())
+    {
+    }
+    pooled_buffer(const this_type& o)
+        : pool(o.pool)
+        , storage(!pool ? std::vector<T>() : pool->take())
+    {
+        storage.insert(storage.end(), o.storage.begin(), o.storage.end());
+    }
+    pooled_buffer(this_type&& o)
+        : pool(std::move(o.pool))
+        , storage(std::move(o.storage))
+    {
+        o.pool.reset();
+        o.storage.clear();
+    }
+    this_type& operator=(this_type o) {
+        release();
+        pool = std::move(o.pool);
+        storage = std::move(o.storage);
+        o.pool.reset();
+        return *this;
+    }
+    ~pooled_buffer()
+    {
+        release();
+    }
+
+    /// return the storage to the pool. the buffer is empty afterwards.
+    void release() {
+        if (!!pool) {
+            pool->give(std::move(storage));
+            pool.reset();
+        }
+        storage.clear();
+    }
+
+    /// take the storage out of the pool
+    std::vector<T> detach() {
+        pool.reset();
+        return std::move(storage);
+    }
+
+    const std::vector<T>& get() const {
+        return storage;
+    }
+
+    bool empty() const {
+        return storage.empty();
+    }
+    size_type size() const {
+        return storage.size();
+    }
+    size_type capacity() const {
+        return storage.capacity();
+    }
+    const T* data() const {
+        return storage.data();
+    }
+    T* data() {
+        return storage.data();
+    }
+
+    iterator begin() {
+        return storage.begin();
+    }
+    const_iterator begin() const {
+        return storage.begin();
+    }
+    iterator end() {
+        return storage.end();
+    }
+    const_iterator end() const {
+        return storage.end();
+    }
+
+    T& operator[](size_type i) {
+        return storage[i];
+    }
+    const T& operator[](size_type i) const {
+        return storage[i];
+    }
+
+    void resize(size_type n) {
+        storage.resize(n);
+    }
+
+    template<class... VN>
+    void emplace_back(VN&&... vn) {
+        storage.emplace_back(std::forward<VN>(vn)...);
+    }
+    void push_back(const T& v) {
+        storage.push_back(v);
+    }
+    void push_back(T&& v) {
+        storage.push_back(std::move(v));
+    }
+};
+
+template<class T>
+inline bool operator==(const pooled_buffer<T>& lhs, const pooled_buffer<T>& rhs) {
+    return lhs.get() == rhs.get();
+}
+template<class T>
+inline bool operator!=(const pooled_buffer<T>& lhs, const pooled_buffer<T>& rhs) {
+    return !(lhs == rhs);
+}
+
+/// a read-only range of chars that keeps the storage that it points into
+/// alive. copies and substr() share the storage, so slicing never copies.
+class shared_view
+{
+    std::shared_ptr<const void> owner;
+    const char* first;
+    std::size_t count;
+
+public:
+    using value_type = char;
+    using size_type = std::size_t;
+    using const_iterator = const char*;
+    using iterator = const_iterator;
+
+    static const size_type npos = static_cast<size_type>(-1);
+
+    shared_view()
+        : first(nullptr)
+        , count(0)
+    {
+    }
+    shared_view(std::shared_ptr<const void> o, const char* f, size_type n)
+        : owner(std::move(o))
+        , first(f)
+        , count(n)
+    {
+    }
+
+    /// the storage that this view points into
+    const std::shared_ptr<const void>& get_owner() const {
+        return owner;
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+    size_type size() const {
+        return count;
+    }
+    const char* data() const {
+        return first;
+    }
+    const_iterator begin() const {
+        return first;
+    }
+    const_iterator end() const {
+        return first + count;
+    }
+    char operator[](size_type i) const {
+        return first[i];
+    }
+
+    /// a view of [pos, pos + n) that shares the storage of this view
+    shared_view substr(size_type pos, size_type n = npos) const {
+        pos = (std::min)(pos, count);
+        return shared_view(owner, first + pos, (std::min)(n, count - pos));
+    }
+
+    std::string str() const {
+        return std::string(first, count);
+    }
+};
+
+inline bool operator==(const shared_view& lhs, const shared_view& rhs) {
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+inline bool operator!=(const shared_view& lhs, const shared_view& rhs) {
+    return !(lhs == rhs);
+}
+inline bool operator==(const shared_view& lhs, const std::string& rhs) {
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+inline bool operator==(const std::string& lhs, const shared_view& rhs) {
+    return rhs == lhs;
+}
+inline bool operator!=(const shared_view& lhs, const std::string& rhs) {
+    return !(lhs == rhs);
+}
+inline bool operator!=(const std::string& lhs, const shared_view& rhs) {
+    return !(rhs == lhs);
+}
+
+inline shared_view make_shared_view(shared_view v) {
+    return v;
+}
+/// moves a contiguous container of char sized values, such as std::string,
+/// std::vector<std::uint8_t> or pooled_buffer<std::uint8_t>, into shared
+/// storage and returns a view of all of it.
+template<class Container,
+    class Decayed = decay_t<Container>,
+    class Enabled = typename std::enable_if<
+        !std::is_same<Decayed, shared_view>::value &&
+        sizeof(typename Decayed::value_type) == 1>::type>
+shared_view make_shared_view(Container&& c) {
+    auto storage = std::make_shared<Decayed>(std::forward<Container>(c));
+    auto first = reinterpret_cast<const char*>(storage->data());
+    auto count = storage->size();
+    return shared_view(std::move(storage), first, count);
+}
+
+namespace detail {
+
+// blocks of up to thread_cache_classes * thread_cache_granule bytes are cached.
+const std::size_t thread_cache_granule = 16;
+const std::size_t thread_cache_classes = 32;
+// the most free blocks that one thread keeps for each size
+const std::size_t thread_cache_depth = 256;
+
+// free lists of blocks for each size class, one set per thread. a block can be
+// freed on any thread, since every block of a size class has the same size.
+// a template so that the thread_local is only instantiated when it is used.
+template<class Tag = void>
+class thread_cache
+{
+    struct free_block
+    {
+        free_block* next;
+    };
+    free_block* heads[thread_cache_classes];
+    std::size_t counts[thread_cache_classes];
+
+    thread_cache()
+    {
+        std::fill(std::begin(heads), std::end(heads), nullptr);
+        std::fill(std::begin(counts), std::end(counts), std::size_t(0));
+    }
+    ~thread_cache()
+    {
+        for (auto head : heads) {
+            while (head) {
+                auto next = head->next;
+                ::operator delete(head);
+                head = next;
+            }
+        }
+        destroyed() = true;
+    }
+
+    static bool& destroyed() {
+        // trivially destructible, so it is still valid while the other thread_locals are destroyed
+        static thread_local bool gone = false;
+        return gone;
+    }
+
+    static std::size_t size_class(std::size_t bytes) {
+        return (bytes + thread_cache_granule - 1) / thread_cache_granule - 1;
+    }
+
+public:
+    /// the cache of this thread, or null once it has been destroyed at thread exit
+    static thread_cache* current() {
+        if (destroyed()) {
+            return nullptr;
+        }
+        static thread_local thread_cache cache;
+        return &cache;
+    }
+
+    static void* allocate(std::size_t bytes) {
+        auto c = size_class(bytes);
+        if (bytes == 0 || c >= thread_cache_classes) {
+            return ::operator new(bytes);
+        }
+        auto cache = current();
+        if (cache && cache->heads[c]) {
+            auto block = cache->heads[c];
+            cache->heads[c] = block->next;
+            --cache->counts[c];
+            return block;
+        }
+        return ::operator new((c + 1) * thread_cache_granule);
+    }
+
+    static void deallocate(void* p, std::size_t bytes) {
+        auto c = size_class(bytes);
+        auto cache = (bytes == 0 || c >= thread_cache_classes) ? nullptr : current();
+        if (!cache || cache->counts[c] == thread_cache_depth) {
+            ::operator delete(p);
+            return;
+        }
+        auto block = static_cast<free_block*>(p);
+        block->next = cache->heads[c];
+        cache->heads[c] = block;
+        ++cache->counts[c];
+    }
+};
+
+}
+
+/// an allocator that keeps a cache of small free blocks on each thread, so that
+/// short lived subscriptions reuse memory without contending on the heap.
+/// the cached blocks are released when the thread exits.
+template<class T>
+class thread_cache_allocator
+{
+public:
+    using value_type = T;
+
+    thread_cache_allocator()
+    {
+    }
+    template<class U>
+    thread_cache_allocator(const thread_cache_allocator<U>&)
+    {
+    }
+
+    T* allocate(std::size_t n) {
+        if (alignof(T) > detail::thread_cache_granule) {
+            return std::allocator<T>().allocate(n);
+        }
+        return static_cast<T*>(detail::thread_cache<>::allocate(n * sizeof(T)));
+    }
+    void deallocate(T* p, std::size_t n) {
+        if (alignof(T) > detail::thread_cache_granule) {
+            std::allocator<T>().deallocate(p, n);
+            return;
+        }
+        detail::thread_cache<>::deallocate(p, n * sizeof(T));
+    }
+};
+
+template<class T, class U>
+inline bool operator==(const thread_cache_allocator<T>&, const thread_cache_allocator<U>&) {
+    return true;
+}
+template<class T, class U>
+inline bool operator!=(const thread_cache_allocator<T>&, const thread_cache_allocator<U>&) {
+    return false;
+}
+
+//
+// the allocator used for the state that the parts of a subscription share, such as
+// the composite_subscription state, the operator and subject states and the scheduler actions.
+// define RXCPP_STATE_ALLOCATOR to an allocator template, the same way in every translation unit,
+// to replace std::allocator. for example:
+//
+// #define RXCPP_STATE_ALLOCATOR rxcpp::util::thread_cache_allocator
+//
+#if !defined(RXCPP_STATE_ALLOCATOR)
+#define RXCPP_STATE_ALLOCATOR std::allocator
+#endif
+
+template<class T>
+using state_allocator = RXCPP_STATE_ALLOCATOR<T>;
+
+template<class T, class... AN>
+inline std::shared_ptr<T> make_shared_state(AN&&... an) {
+    return std::allocate_shared<T>(state_allocator<T>(), std::forward<AN>(an)...);
+}
+
+//
+// reference counts for the state of subscriptions, subjects and actions.
+// the counts are kept in the state itself, so there is no separate control block
+// and no weak reference from enable_shared_from_this.
+// the policy is part of the type of the state. the states of subscriptions, subjects
+// and actions cross threads through the schedulers, so they always use atomic_ref_count.
+// local_ref_count is for state that never leaves the thread that created it.
+//
+
+/// reference counts that may be changed from any thread
+struct atomic_ref_count
+{
+    using type = std::atomic<long>;
+
+    static void increment(type& c) {
+        c.fetch_add(1, std::memory_order_relaxed);
+    }
+    static bool decrement(type& c) {
+        return c.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
+    static bool increment_nonzero(type& c) {
+        auto count = c.load(std::memory_order_relaxed);
+        while (count != 0) {
+            if (c.compare_exchange_weak(count, count + 1, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+/// reference counts that are only changed from the thread that created the state
+struct local_ref_count
+{
+    using type = long;
+
+    static void increment(type& c) {
+        ++c;
+    }
+    static bool decrement(type& c) {
+        return --c == 0;
+    }
+    static bool increment_nonzero(type& c) {
+        if (c == 0) {
+            return false;
+        }
+        ++c;
+        return true;
+    }
+};
+
+#if defined(RXCPP_NON_ATOMIC_REFCOUNT)
+#error RXCPP_NON_ATOMIC_REFCOUNT was removed. derive single thread state from rxcpp::util::intrusive_ref_counted<rxcpp::util::local_ref_count> instead.
+#endif
+
+namespace detail {
+
+struct tag_adopt_ref {};
+
+}
+
+template<class T>
+class intrusive_ptr;
+template<class T>
+class intrusive_weak_ptr;
+
+/// base for state that is shared by intrusive_ptr and intrusive_weak_ptr.
+/// when the last intrusive_ptr is gone, release() is called to drop anything that the
+/// state refers to. the state itself is destroyed when the last intrusive_weak_ptr is gone.
+/// RefCount is atomic_ref_count or local_ref_count.
+template<class RefCount = atomic_ref_count>
+class intrusive_ref_counted
+{
+    template<class T>
+    friend class intrusive_ptr;
+    template<class T>
+    friend class intrusive_weak_ptr;
+
+    using ref_count_type = typename RefCount::type;
+
+    // the number of intrusive_ptr
+    mutable ref_count_type strong;
+    // the number of intrusive_weak_ptr, plus one while strong is not zero
+    mutable ref_count_type weak;
+
+    intrusive_ref_counted(const intrusive_ref_counted&);
+    intrusive_ref_counted& operator=(const intrusive_ref_counted&);
+
+    void add_ref() const {
+        RefCount::increment(strong);
+    }
+    bool try_add_ref() const {
+        return RefCount::increment_nonzero(strong);
+    }
+    void release_ref() const {
+        if (RefCount::decrement(strong)) {
+            const_cast<intrusive_ref_counted*>(this)->release();
+            release_weak();
+        }
+    }
+    void add_weak() const {
+        RefCount::increment(weak);
+    }
+    void release_weak() const {
+        if (RefCount::decrement(weak)) {
+            const_cast<intrusive_ref_counted*>(this)->destroy();
+        }
+    }
+
+protected:
+    intrusive_ref_counted()
+        : strong(0)
+        , weak(1)
+    {
+    }
+    virtual ~intrusive_ref_counted()
+    {
+    }
+
+    /// called when the last intrusive_ptr is gone
+    virtual void release() {
+    }
+    /// called when the last intrusive_weak_ptr is gone
+    virtual void destroy() {
+        delete this;
+    }
+};
+
+/// a strong reference to an intrusive_ref_counted state
+template<class T>
+class intrusive_ptr
+{
+    template<class U>
+    friend class intrusive_ptr;
+
+    T* p;
+
+public:
+    using element_type = T;
+
+    intrusive_ptr()
+        : p(nullptr)
+    {
+    }
+    explicit intrusive_ptr(T* t)
+        : p(t)
+    {
+        if (p) {
+            p->add_ref();
+        }
+    }
+    intrusive_ptr(T* t, detail::tag_adopt_ref)
+        : p(t)
+    {
+    }
+    intrusive_ptr(const intrusive_ptr& o)
+        : intrusive_ptr(o.p)
+    {
+    }
+    intrusive_ptr(intrusive_ptr&& o) RXCPP_NOEXCEPT
+        : p(o.p)
+    {
+        o.p = nullptr;
+    }
+    template<class U, class = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+    intrusive_ptr(const intrusive_ptr<U>& o)
+        : intrusive_ptr(o.p)
+    {
+    }
+    template<class U, class = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+    intrusive_ptr(intrusive_ptr<U>&& o) RXCPP_NOEXCEPT
+        : p(o.p)
+    {
+        o.p = nullptr;
+    }
+    ~intrusive_ptr()
+    {
+        if (p) {
+            p->release_ref();
+        }
+    }
+    intrusive_ptr& operator=(intrusive_ptr o) RXCPP_NOEXCEPT {
+        std::swap(p, o.p);
+        return *this;
+    }
+
+    void reset() {
+        intrusive_ptr().swap(*this);
+    }
+    void swap(intrusive_ptr& o) RXCPP_NOEXCEPT {
+        std::swap(p, o.p);
+    }
+
+    T* get() const {
+        return p;
+    }
+    T& operator*() const {
+        return *p;
+    }
+    T* operator->() const {
+        return p;
+    }
+    explicit operator bool() const {
+        return p != nullptr;
+    }
+};
+
+template<class T, class U>
+inline bool operator==(const intrusive_ptr<T>& lhs, const intrusive_ptr<U>& rhs) {
+    return lhs.get() == rhs.get();
+}
+template<class T, class U>
+inline bool operator!=(const intrusive_ptr<T>& lhs, const intrusive_ptr<U>& rhs) {
+    return lhs.get() != rhs.get();
+}
+template<class T>
+inline bool operator<(const intrusive_ptr<T>& lhs, const intrusive_ptr<T>& rhs) {
+    return std::less<T*>()(lhs.get(), rhs.get());
+}
+
+/// a weak reference to an intrusive_ref_counted state.
+/// lock() returns an empty intrusive_ptr once the last intrusive_ptr is gone.
+template<class T>
+class intrusive_weak_ptr
+{
+    T* p;
+
+public:
+    using element_type = T;
+
+    intrusive_weak_ptr()
+        : p(nullptr)
+    {
+    }
+    template<class U, class = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+    intrusive_weak_ptr(const intrusive_ptr<U>& o)
+        : p(o.get())
+    {
+        if (p) {
+            p->add_weak();
+        }
+    }
+    intrusive_weak_ptr(const intrusive_weak_ptr& o)
+        : p(o.p)
+    {
+        if (p) {
+            p->add_weak();
+        }
+    }
+    intrusive_weak_ptr(intrusive_weak_ptr&& o) RXCPP_NOEXCEPT
+        : p(o.p)
+    {
+        o.p = nullptr;
+    }
+    ~intrusive_weak_ptr()
+    {
+        if (p) {
+            p->release_weak();
+        }
+    }
+    intrusive_weak_ptr& operator=(intrusive_weak_ptr o) RXCPP_NOEXCEPT {
+        std::swap(p, o.p);
+        return *this;
+    }
+
+    void reset() {
+        intrusive_weak_ptr().swap(*this);
+    }
+    void swap(intrusive_weak_ptr& o) RXCPP_NOEXCEPT {
+        std::swap(p, o.p);
+    }
+
+    intrusive_ptr<T> lock() const {
+        if (p && p->try_add_ref()) {
+            return intrusive_ptr<T>(p, detail::tag_adopt_ref());
+        }
+        return intrusive_ptr<T>();
+    }
+    bool expired() const {
+        return !lock();
+    }
+};
+
+namespace detail {
+
+// frees the state with the state allocator
+template<class T>
+class allocated_state final : public T
+{
+public:
+    template<class... AN>
+    explicit allocated_state(AN&&... an)
+        : T(std::forward<AN>(an)...)
+    {
+    }
+
+private:
+    using allocator_type = typename std::allocator_traits<state_allocator<T>>::template rebind_alloc<allocated_state>;
+    using allocator_traits = std::allocator_traits<allocator_type>;
+
+    void destroy() override {
+        allocator_type a;
+        this->~allocated_state();
+        allocator_traits::deallocate(a, this, 1);
+    }
+
+    friend struct allocated_state_factory;
+};
+
+struct allocated_state_factory
+{
+    template<class T, class... AN>
+    static allocated_state<T>* create(AN&&... an) {
+        using state_type = allocated_state<T>;
+        typename state_type::allocator_type a;
+        auto p = state_type::allocator_traits::allocate(a, 1);
+        // returns the block if the constructor throws
+        struct guard_type
+        {
+            typename state_type::allocator_type& a;
+            state_type* p;
+            ~guard_type()
+            {
+                if (p) {
+                    state_type::allocator_traits::deallocate(a, p, 1);
+                }
+            }
+        } guard{a, p};
+        ::new (static_cast<void*>(p)) state_type(std::forward<AN>(an)...);
+        guard.p = nullptr;
+        return p;
+    }
+};
+
+}
+
+template<class T, class... AN>
+inline intrusive_ptr<T> make_intrusive_state(AN&&... an) {
+    return intrusive_ptr<T>(detail::allocated_state_factory::create<T>(std::forward<AN>(an)...));
+}
+
+namespace detail {
+
+// values of at most this size are kept inline by erased_storage
+const std::size_t erased_inline_size = 8 * sizeof(void*);
+
+}
+
+/// type-erased storage for one value.
+/// values that are small and cannot throw when moved are kept inline and copied with
+/// the storage. other values are allocated once and shared by the copies.
+template<std::size_t Size = detail::erased_inline_size>
+class erased_storage
+{
+    using shared_type = std::shared_ptr<void>;
+
+    static_assert(Size >= sizeof(shared_type), "erased_storage must have room for a shared_ptr");
+
+    template<class V>
+    struct is_inline
+    {
+        static const bool value = !std::is_same_v<V, erased_storage> &&
+            sizeof(V) <= Size &&
+            alignof(V) <= alignof(std::max_align_t) &&
+            std::is_nothrow_move_constructible<V>::value;
+    };
+
+    // copies, moves and destroys a value that is kept inline
+    struct manager_type
+    {
+        void (*copy)(const void*, void*);
+        void (*move)(void*, void*);
+        void (*destroy)(void*);
+    };
+
+    template<class V>
+    struct inline_manager
+    {
+        static void copy(const void* from, void* to) {
+            ::new (to) V(*static_cast<const V*>(from));
+        }
+        static void move(void* from, void* to) {
+            ::new (to) V(std::move(*static_cast<V*>(from)));
+            static_cast<V*>(from)->~V();
+        }
+        static void destroy(void* p) {
+            static_cast<V*>(p)->~V();
+        }
+        static const manager_type* instance() {
+            static const manager_type manager = {&copy, &move, &destroy};
+            return &manager;
+        }
+    };
+
+    // holds the value when manager is set, otherwise holds a shared_type
+    typename std::aligned_storage<Size, alignof(std::max_align_t)>::type buffer;
+    const manager_type* manager;
+
+    void* address() const {
+        return const_cast<void*>(static_cast<const void*>(&buffer));
+    }
+    shared_type& shared() const {
+        return *static_cast<shared_type*>(address());
+    }
+
+    void construct_from(const erased_storage& o) {
+        if (o.manager) {
+            o.manager->copy(o.address(), address());
+        } else {
+            ::new (address()) shared_type(o.shared());
+        }
+        manager = o.manager;
+    }
+    void construct_from(erased_storage&& o) {
+        if (o.manager) {
+            o.manager->move(o.address(), address());
+            ::new (o.address()) shared_type();
+        } else {
+            ::new (address()) shared_type(std::move(o.shared()));
+        }
+        manager = o.manager;
+        o.manager = nullptr;
+    }
+    void destroy() {
+        if (manager) {
+            manager->destroy(address());
+        } else {
+            shared().~shared_type();
+        }
+    }
+
+public:
+    erased_storage()
+        : manager(nullptr)
+    {
+        ::new (address()) shared_type();
+    }
+
+    template<class V>
+    explicit erased_storage(V v, typename std::enable_if<is_inline<V>::value, void**>::type = nullptr)
+        : manager(inline_manager<V>::instance())
+    {
+        ::new (address()) V(std::move(v));
+    }
+    template<class V>
+    explicit erased_storage(V v, typename std::enable_if<!std::is_same_v<V, erased_storage> && !is_inline<V>::value, void**>::type = nullptr)
+        : manager(nullptr)
+    {
+        ::new (address()) shared_type(make_shared_state<V>(std::move(v)));
+    }
+
+    erased_storage(const erased_storage& o)
+    {
+        construct_from(o);
+    }
+    erased_storage(erased_storage&& o) RXCPP_NOEXCEPT
+    {
+        construct_from(std::move(o));
+    }
+    ~erased_storage()
+    {
+        destroy();
+    }
+
+    erased_storage& operator=(erased_storage o) RXCPP_NOEXCEPT {
+        destroy();
+        construct_from(std::move(o));
+        return *this;
+    }
+
+    /// the address of the stored value, or null when there is no value
+    void* get() const {
+        return manager ? address() : shared().get();
+    }
+};
+
+/// unbounded queue with any number of producers and a single consumer.
+/// push is wait-free: one exchange and one store. values are stored in the
+/// nodes and nodes are allocated with the state allocator.
+/// pop and empty must only be called from one thread at a time.
+template<class T>
+class mpsc_queue
+{
+    struct node
+    {
+        node()
+            : next(nullptr)
+        {
+        }
+        std::atomic<node*> next;
+        detail::maybe<T> value;
+    };
+
+    using allocator_type = typename std::allocator_traits<state_allocator<T>>::template rebind_alloc<node>;
+    using allocator_traits = std::allocator_traits<allocator_type>;
+
+    // producers and the consumer write to different cache lines
+    alignas(64) std::atomic<node*> head;
+    alignas(64) node* tail;
+
+    static node* make_node() {
+        allocator_type a;
+        auto n = allocator_traits::allocate(a, 1);
+        ::new (static_cast<void*>(n)) node();
+        return n;
+    }
+    static void destroy_node(node* n) {
+        allocator_type a;
+        n->~node();
+        allocator_traits::deallocate(a, n, 1);
+    }
+
+public:
+    mpsc_queue()
+        : head(nullptr)
+        , tail(nullptr)
+    {
+        // the consumer always owns one node whose value has been taken
+        auto stub = make_node();
+        head.store(stub, std::memory_order_relaxed);
+        tail = stub;
+    }
+    ~mpsc_queue() {
+        while (tail) {
+            auto next = tail->next.load(std::memory_order_relaxed);
+            destroy_node(tail);
+            tail = next;
+        }
+    }
+    mpsc_queue(const mpsc_queue&) = delete;
+    mpsc_queue& operator=(const mpsc_queue&) = delete;
+
+    template<class V>
+    void push(V&& v) {
+        auto n = make_node();
+        // returns the node if the value constructor throws
+        struct guard_type
+        {
+            node* n;
+            ~guard_type()
+            {
+                if (n) {
+                    destroy_node(n);
+                }
+            }
+        } guard{n};
+        n->value.reset(std::forward<V>(v));
+        guard.n = nullptr;
+        auto prev = head.exchange(n, std::memory_order_acq_rel);
+        // the node is visible to the consumer once it is linked.
+        // seq_cst pairs with the check in empty()
+        prev->next.store(n, std::memory_order_seq_cst);
+    }
+
+    /// returns an empty maybe when no linked value is available
+    detail::maybe<T> pop() {
+        auto next = tail->next.load(std::memory_order_acquire);
+        if (!next) {
+            return detail::maybe<T>();
+        }
+        detail::maybe<T> result(std::move(next->value.get()));
+        next->value.reset();
+        destroy_node(tail);
+        tail = next;
+        return result;
+    }
+
+    bool empty() const {
+        return tail->next.load(std::memory_order_seq_cst) == nullptr;
+    }
+};
+
+/// a trivially copyable value with one writer at a time and any number of readers.
+/// readers never block: they copy the value and retry only if a write overlapped
+/// the copy. the value is held in atomic words so that the racing copy is defined.
+template<class T>
+class seqlock
+{
+    static_assert(std::is_trivially_copyable<T>::value, "seqlock requires a trivially copyable value");
+
+    using word_type = std::uintptr_t;
+    static const std::size_t word_count = (sizeof(T) + sizeof(word_type) - 1) / sizeof(word_type);
+
+    std::atomic<unsigned> sequence;
+    std::atomic<word_type> words[word_count];
+
+public:
+    explicit seqlock(const T& v)
+        : sequence(0)
+    {
+        store(v);
+    }
+    seqlock(const seqlock&) = delete;
+    seqlock& operator=(const seqlock&) = delete;
+
+    /// writers must be serialized by the caller
+    void store(const T& v) {
+        word_type buffer[word_count] = {};
+        std::memcpy(buffer, std::addressof(v), sizeof(T));
+        auto s = sequence.load(std::memory_order_relaxed);
+        // an odd sequence marks a write in progress
+        sequence.store(s + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i != word_count; ++i) {
+            words[i].store(buffer[i], std::memory_order_relaxed);
+        }
+        sequence.store(s + 2, std::memory_order_release);
+    }
+
+    T load() const {
+        word_type buffer[word_count];
+        for (;;) {
+            auto before = sequence.load(std::memory_order_acquire);
+            if (before & 1) {
+                continue;
+            }
+            for (std::size_t i = 0; i != word_count; ++i) {
+                buffer[i] = words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence.load(std::memory_order_relaxed) == before) {
+                break;
+            }
+        }
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type result;
+        std::memcpy(std::addressof(result), buffer, sizeof(T));
+        return *reinterpret_cast<T*>(std::addressof(result));
+    }
+};
+
+namespace detail {
+// the number of independent accumulators used by the reductions below.
+// separate accumulators break the dependency between iterations so that
+// the compiler can keep them in vector registers.
+const std::size_t reduce_lanes = 8;
+}
+
+/// add the arithmetic values in [first, last) as R.
+/// floating point values are not added in sequential order, so the result
+/// may differ from a loop in the last bits.
+template<class T, class R = T>
+inline typename std::enable_if<std::is_arithmetic<T>::value, R>::type
+sum_of(const T* first, const T* last) {
+    const std::size_t lanes = detail::reduce_lanes;
+    const std::size_t n = static_cast<std::size_t>(last - first);
+    R partial[lanes] = {};
+    std::size_t i = 0;
+    for (; i + lanes <= n; i += lanes) {
+        for (std::size_t l = 0; l != lanes; ++l) {
+            partial[l] += static_cast<R>(first[i + l]);
+        }
+    }
+    R result = R();
+    for (std::size_t l = 0; l != lanes; ++l) {
+        result += partial[l];
+    }
+    for (; i != n; ++i) {
+        result += static_cast<R>(first[i]);
+    }
+    return result;
+}
+
+/// the smallest of the arithmetic values in [first, last), which must not be empty.
+/// as in min() and max(), a value that does not compare, such as NaN, is skipped unless it is first.
+template<class T>
+inline typename std::enable_if<std::is_arithmetic<T>::value, T>::type
+min_of(const T* first, const T* last) {
+    const std::size_t lanes = detail::reduce_lanes;
+    const std::size_t n = static_cast<std::size_t>(last - first);
+    T partial[lanes];
+    std::fill(partial, partial + lanes, first[0]);
+    std::size_t i = 0;
+    for (; i + lanes <= n; i += lanes) {
+        for (std::size_t l = 0; l != lanes; ++l) {
+            partial[l] = first[i + l] < partial[l] ? first[i + l] : partial[l];
+        }
+    }
+    T result = partial[0];
+    for (std::size_t l = 1; l != lanes; ++l) {
+        result = partial[l] < result ? partial[l] : result;
+    }
+    for (; i != n; ++i) {
+        result = first[i] < result ? first[i] : result;
+    }
+    return result;
+}
+
+/// the largest of the arithmetic values in [first, last), which must not be empty.
+/// as in min() and max(), a value that does not compare, such as NaN, is skipped unless it is first.
+template<class T>
+inline typename std::enable_if<std::is_arithmetic<T>::value, T>::type
+max_of(const T* first, const T* last) {
+    const std::size_t lanes = detail::reduce_lanes;
+    const std::size_t n = static_cast<std::size_t>(last - first);
+    T partial[lanes];
+    std::fill(partial, partial + lanes, first[0]);
+    std::size_t i = 0;
+    for (; i + lanes <= n; i += lanes) {
+        for (std::size_t l = 0; l != lanes; ++l) {
+            partial[l] = partial[l] < first[i + l] ? first[i + l] : partial[l];
+        }
+    }
+    T result = partial[0];
+    for (std::size_t l = 1; l != lanes; ++l) {
+        result = result < partial[l] ? partial[l] : result;
+    }
+    for (; i != n; ++i) {
+        result = result < first[i] ? first[i] : result;
+    }
+    return result;
 }
-using detail::maybe;
 
 namespace detail {
     struct surely
@@ -717,6 +2017,59 @@ inline auto surely(const std::tuple<T...>& tpl)
     return      apply(tpl, detail::surely());
 }
 
+namespace detail {
+    template<class F, class... T, int... IndexN>
+    auto apply_surely(const std::tuple<T...>& tpl, values<int, IndexN...>, F& f)
+        -> decltype(f(std::get<IndexN>(tpl).get()...)) {
+        return      f(std::get<IndexN>(tpl).get()...);
+    }
+}
+
+/// call f with a const reference to the value held by each maybe in the tuple
+template<class F, class... T>
+inline auto apply_surely(const std::tuple<T...>& tpl, F& f)
+    -> decltype(detail::apply_surely(tpl, typename values_from<int, sizeof...(T)>::type(), f)) {
+    return      detail::apply_surely(tpl, typename values_from<int, sizeof...(T)>::type(), f);
+}
+
+/// a selector for combine_latest and with_latest_from that is called with const
+/// references to the latest values instead of with copies of them. see by_reference()
+template<class F>
+struct by_reference_selector
+{
+    explicit by_reference_selector(F f)
+        : selector(std::move(f))
+    {
+    }
+    template<class... AN>
+    auto operator()(const AN&... an)
+        -> decltype(std::declval<F&>()(an...)) {
+        return      selector(an...);
+    }
+    F selector;
+};
+
+/// opt in to passing const references to the latest values to a combine_latest or
+/// with_latest_from selector. other selectors are passed copies.
+template<class F>
+inline by_reference_selector<decay_t<F>> by_reference(F&& f) {
+    return by_reference_selector<decay_t<F>>(std::forward<F>(f));
+}
+
+/// call f with copies of the values held by each maybe in the tuple
+template<class F, class... T>
+inline auto apply_latest(const std::tuple<T...>& tpl, F& f)
+    -> decltype(apply(surely(tpl), f)) {
+    auto values = surely(tpl);
+    return      apply(std::move(values), f);
+}
+/// call the selector with const references to the values held by each maybe in the tuple
+template<class F, class... T>
+inline auto apply_latest(const std::tuple<T...>& tpl, by_reference_selector<F>& f)
+    -> decltype(apply_surely(tpl, f.selector)) {
+    return      apply_surely(tpl, f.selector);
+}
+
 namespace detail {
 
 template<typename Function>
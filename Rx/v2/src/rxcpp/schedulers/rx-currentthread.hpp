@@ -13,6 +13,109 @@ namespace schedulers {
 
 namespace detail {
 
+// a trampoline queue. items scheduled for now are appended to a fifo lane
+// that is already in (when, ordinal) order. items scheduled for a time go
+// through the priority queue. the two lanes share the ordinal so the
+// merged order is the same as a single priority queue.
+class trampoline_queue {
+public:
+    using item_type = time_schedulable<scheduler_base::clock_type::time_point>;
+    using elem_type = std::pair<item_type, int64_t>;
+    using container_type = std::vector<elem_type>;
+    using const_reference = const item_type &;
+
+private:
+    struct compare_elem
+    {
+        bool operator()(const elem_type& lhs, const elem_type& rhs) const {
+            if (lhs.first.when == rhs.first.when) {
+                return lhs.second > rhs.second;
+            }
+            else {
+                return lhs.first.when > rhs.first.when;
+            }
+        }
+    };
+
+    using queue_type = std::priority_queue<elem_type, container_type, compare_elem>;
+
+    container_type immediate;
+    std::size_t front;
+
+    queue_type timed;
+
+    int64_t ordinal;
+
+    bool is_immediate_next() const {
+        if (front == immediate.size()) {
+            return false;
+        }
+        return timed.empty() || !compare_elem()(immediate[front], timed.top());
+    }
+
+    void pop_immediate() {
+        ++front;
+        if (front == immediate.size()) {
+            // keep the capacity for the next burst
+            immediate.clear();
+            front = 0;
+        } else if (front >= 64 && front * 2 >= immediate.size()) {
+            // a lane that never drains is compacted
+            immediate.erase(immediate.begin(), immediate.begin() + front);
+            front = 0;
+        }
+    }
+
+public:
+
+    trampoline_queue()
+        : front(0)
+        , ordinal(0)
+    {
+    }
+
+    bool empty() const {
+        return front == immediate.size() && timed.empty();
+    }
+
+    /// true when the next item was scheduled for now and needs no wait.
+    bool is_ready() const {
+        return is_immediate_next();
+    }
+
+    const_reference top() const {
+        return is_immediate_next() ? immediate[front].first : timed.top().first;
+    }
+
+    void pop() {
+        if (is_immediate_next()) {
+            pop_immediate();
+        } else {
+            timed.pop();
+        }
+    }
+
+    /// removes the next item and returns its schedulable.
+    schedulable take() {
+        if (is_immediate_next()) {
+            auto what = std::move(immediate[front].first.what);
+            pop_immediate();
+            return what;
+        }
+        auto what = timed.top().first.what;
+        timed.pop();
+        return what;
+    }
+
+    void push(item_type&& value) {
+        timed.push(elem_type(std::move(value), ordinal++));
+    }
+
+    void push_immediate(item_type&& value) {
+        immediate.emplace_back(std::move(value), ordinal++);
+    }
+};
+
 struct action_queue
 {
     using this_type = action_queue;
@@ -21,7 +124,7 @@ struct action_queue
     using item_type = time_schedulable<clock::time_point>;
 
 private:
-    using queue_item_time = schedulable_queue<item_type::time_point_type>;
+    using queue_item_time = trampoline_queue;
 
 public:
     struct current_thread_queue_type {
@@ -48,6 +151,13 @@ public:
     static bool owned() {
         return !!current_thread_queue();
     }
+    static current_thread_queue_type* get_queue() {
+#if defined(RXCPP_THREAD_LOCAL)
+        return current_thread_queue();
+#else
+        return current_thread_queue().get();
+#endif
+    }
     static const std::shared_ptr<worker_interface>& get_worker_interface() {
         return current_thread_queue()->w;
     }
@@ -143,22 +253,38 @@ private:
         derecurser(const this_type&);
     public:
         derecurser()
+            : queue(nullptr)
         {
         }
         virtual ~derecurser()
         {
         }
 
+        // the queue of the thread that owns this derecurser. it is set once
+        // the queue is published so that each schedule does not look up
+        // the thread local again.
+        queue_type::current_thread_queue_type* queue;
+
         virtual clock_type::time_point now() const {
             return clock_type::now();
         }
 
         virtual void schedule(const schedulable& scbl) const {
-            queue_type::push(queue_type::item_type(now(), scbl));
+            if (!scbl.is_subscribed()) {
+                return;
+            }
+            queue->q.push_immediate(queue_type::item_type(now(), scbl));
+            // disallow recursion
+            queue->r.reset(false);
         }
 
         virtual void schedule(clock_type::time_point when, const schedulable& scbl) const {
-            queue_type::push(queue_type::item_type(when, scbl));
+            if (!scbl.is_subscribed()) {
+                return;
+            }
+            queue->q.push(queue_type::item_type(when, scbl));
+            // disallow recursion
+            queue->r.reset(false);
         }
     };
 
@@ -167,6 +293,45 @@ private:
     private:
         using this_type = current_thread;
         current_worker(const this_type&);
+
+        static void run(const schedulable& scbl) {
+            queue_type::current_thread_queue_type* state = nullptr;
+            {
+                // take ownership
+                auto derecurse = rxu::make_shared_state<derecurser>();
+                auto& d = *derecurse;
+                queue_type::ensure(std::move(derecurse));
+                state = queue_type::get_queue();
+                d.queue = state;
+            }
+            // release ownership
+            RXCPP_UNWIND_AUTO([]{
+                queue_type::destroy();
+            });
+
+            const auto& recursor = state->r.get_recurse();
+            if (scbl.is_subscribed()) {
+                scbl(recursor);
+            }
+
+            // loop until queue is empty
+            while (!state->q.empty()) {
+                if (!state->q.is_ready()) {
+                    std::this_thread::sleep_until(state->q.top().when);
+                }
+
+                auto what = state->q.take();
+                if (state->q.empty()) {
+                    // allow recursion
+                    state->r.reset(true);
+                }
+
+                if (what.is_subscribed()) {
+                    what(recursor);
+                }
+            }
+        }
+
     public:
         current_worker()
         {
@@ -180,57 +345,34 @@ private:
         }
 
         virtual void schedule(const schedulable& scbl) const {
-            schedule(now(), scbl);
-        }
-
-        virtual void schedule(clock_type::time_point when, const schedulable& scbl) const {
             if (!scbl.is_subscribed()) {
                 return;
             }
 
-            {
-                // check ownership
-                if (queue_type::owned()) {
-                    // already has an owner - delegate
-                    queue_type::get_worker_interface()->schedule(when, scbl);
-                    return;
-                }
-
-                // take ownership
-                queue_type::ensure(std::make_shared<derecurser>());
-            }
-            // release ownership
-            RXCPP_UNWIND_AUTO([]{
-                queue_type::destroy();
-            });
-
-            const auto& recursor = queue_type::get_recursion().get_recurse();
-            std::this_thread::sleep_until(when);
-            if (scbl.is_subscribed()) {
-                scbl(recursor);
-            }
-            if (queue_type::empty()) {
+            // check ownership
+            if (queue_type::owned()) {
+                // already has an owner - delegate
+                queue_type::get_worker_interface()->schedule(scbl);
                 return;
             }
 
-            // loop until queue is empty
-            for (
-                auto next = queue_type::top().when;
-                (std::this_thread::sleep_until(next), true);
-                next = queue_type::top().when
-            ) {
-                auto what = queue_type::top().what;
-
-                queue_type::pop();
+            run(scbl);
+        }
 
-                if (what.is_subscribed()) {
-                    what(recursor);
-                }
+        virtual void schedule(clock_type::time_point when, const schedulable& scbl) const {
+            if (!scbl.is_subscribed()) {
+                return;
+            }
 
-                if (queue_type::empty()) {
-                    break;
-                }
+            // check ownership
+            if (queue_type::owned()) {
+                // already has an owner - delegate
+                queue_type::get_worker_interface()->schedule(when, scbl);
+                return;
             }
+
+            std::this_thread::sleep_until(when);
+            run(scbl);
         }
     };
 
@@ -238,7 +380,7 @@ private:
 
 public:
     current_thread()
-        : wi(std::make_shared<current_worker>())
+        : wi(rxu::make_shared_state<current_worker>())
     {
     }
     virtual ~current_thread()
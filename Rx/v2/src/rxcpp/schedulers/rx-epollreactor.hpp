@@ -0,0 +1,203 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_RX_SCHEDULER_EPOLL_REACTOR_HPP)
+#define RXCPP_RX_SCHEDULER_EPOLL_REACTOR_HPP
+
+#include "../rx-includes.hpp"
+
+#if defined(RXCPP_ON_LINUX)
+
+namespace rxcpp {
+
+namespace schedulers {
+
+namespace detail {
+
+struct epoll_reactor_state
+{
+    using callback_type = std::function<void(std::uint32_t)>;
+
+    // the ids below first_watch_id belong to the run_loop_fd descriptors
+    static const std::uint64_t wake_id = 0;
+    static const std::uint64_t timer_id = 1;
+    static const std::uint64_t first_watch_id = 2;
+
+    epoll_reactor_state()
+        : epoll(epoll_create1(EPOLL_CLOEXEC))
+        , next_id(first_watch_id)
+        , running(true)
+    {
+        if (epoll < 0) {
+            rxu::throw_exception(std::system_error(errno, std::system_category(), "epoll_reactor epoll_create1"));
+        }
+    }
+    ~epoll_reactor_state()
+    {
+        ::close(epoll);
+    }
+
+    void add(int fd, std::uint32_t events, std::uint64_t id) {
+        epoll_event ev = {};
+        ev.events = events;
+        ev.data.u64 = id;
+        if (epoll_ctl(epoll, EPOLL_CTL_ADD, fd, &ev) != 0) {
+            rxu::throw_exception(std::system_error(errno, std::system_category(), "epoll_reactor epoll_ctl"));
+        }
+    }
+
+    // called on the reactor thread until it is stopped
+    void run(std::promise<scheduler>& started) {
+        run_loop rl;
+        run_loop_fd fds(rl);
+        add(fds.wake_fd(), EPOLLIN, wake_id);
+        add(fds.timer_fd(), EPOLLIN, timer_id);
+        started.set_value(rl.get_scheduler());
+
+        const int batch = 64;
+        epoll_event events[batch];
+        while (running) {
+            int n = epoll_wait(epoll, events, batch, -1);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                std::terminate();
+            }
+            bool due = false;
+            for (int i = 0; i != n; ++i) {
+                auto id = events[i].data.u64;
+                if (id < first_watch_id) {
+                    due = true;
+                    continue;
+                }
+                std::shared_ptr<callback_type> callback;
+                {
+                    std::unique_lock<std::mutex> guard(lock);
+                    auto found = watches.find(id);
+                    if (found == watches.end()) {
+                        // removed after epoll_wait returned
+                        continue;
+                    }
+                    callback = found->second;
+                }
+                (*callback)(events[i].events);
+            }
+            if (due) {
+                fds.dispatch();
+            }
+        }
+    }
+
+    int epoll;
+    std::mutex lock;
+    std::unordered_map<std::uint64_t, std::shared_ptr<callback_type>> watches;
+    std::uint64_t next_id;
+    // only used on the reactor thread
+    bool running;
+};
+
+}
+
+/// epoll_reactor waits on one thread for all the descriptors that are watched and calls
+/// the callback for each one that is ready. the same thread runs the items scheduled on
+/// get_scheduler(). copies share the thread, which stops when the last copy is destroyed
+/// and nothing is watched.
+class epoll_reactor
+{
+    using state_type = detail::epoll_reactor_state;
+
+    struct owner_type
+    {
+        owner_type()
+            : state(std::make_shared<state_type>())
+        {
+            std::promise<scheduler> started;
+            auto ready = started.get_future();
+            auto keepAlive = state;
+            thread = std::thread([keepAlive](std::promise<scheduler> p){
+                keepAlive->run(p);
+            }, std::move(started));
+            sc = ready.get();
+        }
+        ~owner_type()
+        {
+            auto keepAlive = state;
+            sc.create_worker().schedule([keepAlive](const schedulable&){
+                keepAlive->running = false;
+            });
+            if (thread.get_id() == std::this_thread::get_id()) {
+                // the last copy was released by a callback on the reactor thread
+                thread.detach();
+            } else {
+                thread.join();
+            }
+        }
+        std::shared_ptr<state_type> state;
+        std::thread thread;
+        scheduler sc;
+    };
+
+    std::shared_ptr<owner_type> owner;
+
+public:
+    using callback_type = state_type::callback_type;
+
+    epoll_reactor()
+        : owner(std::make_shared<owner_type>())
+    {
+    }
+
+    /// the scheduler that runs items on the reactor thread
+    scheduler get_scheduler() const {
+        return owner->sc;
+    }
+
+    /// call f on the reactor thread with the ready events each time that fd is ready for
+    /// the requested events, until the returned subscription is unsubscribed.
+    /// a descriptor can only be watched once at a time.
+    composite_subscription watch(int fd, std::uint32_t events, callback_type f) const {
+        auto state = owner->state;
+        auto callback = std::make_shared<callback_type>(std::move(f));
+        std::uint64_t id = 0;
+        {
+            std::unique_lock<std::mutex> guard(state->lock);
+            id = state->next_id++;
+            state->watches.emplace(id, std::move(callback));
+        }
+        epoll_event ev = {};
+        ev.events = events;
+        ev.data.u64 = id;
+        if (epoll_ctl(state->epoll, EPOLL_CTL_ADD, fd, &ev) != 0) {
+            auto error = errno;
+            {
+                std::unique_lock<std::mutex> guard(state->lock);
+                state->watches.erase(id);
+            }
+            rxu::throw_exception(std::system_error(error, std::system_category(), "epoll_reactor watch"));
+        }
+        composite_subscription cs;
+        // the reactor is kept running while the descriptor is watched
+        auto keepAlive = owner;
+        cs.add([keepAlive, fd, id](){
+            auto& st = *keepAlive->state;
+            epoll_ctl(st.epoll, EPOLL_CTL_DEL, fd, nullptr);
+            std::unique_lock<std::mutex> guard(st.lock);
+            st.watches.erase(id);
+        });
+        return cs;
+    }
+};
+
+inline epoll_reactor make_epoll_reactor() {
+    return epoll_reactor();
+}
+
+}
+
+}
+
+#endif
+
+#endif
@@ -13,36 +13,136 @@ namespace schedulers {
 
 struct event_loop : public scheduler_interface
 {
+public:
+    /// the load on one of the loops, see get_load()
+    struct loop_load
+    {
+        /// the number of workers placed on the loop
+        std::size_t workers;
+        /// the number of actions scheduled that have not finished
+        std::size_t queued;
+        /// the number of actions that have run
+        std::size_t actions;
+        /// the time spent running actions, zero unless sample_busy is set
+        clock_type::duration busy;
+    };
+
 private:
     using this_type = event_loop;
     event_loop(const this_type&);
 
+    struct loop_state
+    {
+        loop_state(worker w, std::shared_ptr<detail::thread_load> l)
+            : controller(std::move(w))
+            , counts(std::move(l))
+            , workers(0)
+        {
+        }
+
+        worker controller;
+        // queued, actions and busy are kept by the thread that runs the loop
+        std::shared_ptr<detail::thread_load> counts;
+        std::atomic<std::size_t> workers;
+
+        std::size_t load() const {
+            return workers + counts->queued;
+        }
+        bool is_less_loaded(const loop_state& other) const {
+            auto l = load();
+            auto r = other.load();
+            if (l != r) {
+                return l < r;
+            }
+            return counts->busy < other.counts->busy;
+        }
+    };
+
     struct loop_worker : public worker_interface
     {
     private:
         using this_type = loop_worker;
         loop_worker(const this_type&);
 
-        using queue_item_time = detail::schedulable_queue<typename clock_type::time_point>;
+        struct worker_state
+        {
+            explicit worker_state(loop_state& l)
+                : loop(&l)
+                , pending(0)
+            {
+            }
+
+            std::mutex lock;
+            // the loop that runs the actions. it only changes while
+            // nothing is pending.
+            loop_state* loop;
+            // only counted when the event_loop rebalances
+            std::atomic<std::size_t> pending;
 
-        using item_type = queue_item_time::item_type;
+            // called when an action finishes. it does nothing when the
+            // pending actions were already dropped by the lifetime.
+            void release() {
+                auto p = pending.load();
+                while (p != 0 && !pending.compare_exchange_weak(p, p - 1)) {
+                }
+            }
+        };
 
         composite_subscription lifetime;
-        worker controller;
-        std::shared_ptr<const scheduler_interface> alive;
+        std::shared_ptr<const event_loop> alive;
+        std::shared_ptr<worker_state> state;
+
+        // moves an idle worker to a less loaded loop
+        loop_state* acquire() const {
+            std::unique_lock<std::mutex> guard(state->lock);
+            if (!lifetime.is_subscribed()) {
+                return nullptr;
+            }
+            if (state->pending == 0) {
+                // the worker is idle so the order of its actions is kept
+                // when the next one runs on another loop.
+                auto& candidate = alive->choose();
+                if (candidate.load() + 1 < state->loop->load()) {
+                    --state->loop->workers;
+                    ++candidate.workers;
+                    state->loop = &candidate;
+                }
+            }
+            ++state->pending;
+            return state->loop;
+        }
+
+        // runs the action with the caller's schedulable, so that
+        // reschedules come back through acquire()
+        action make_pending_action(const schedulable& scbl) const {
+            auto ws = state;
+            return action(rxu::make_intrusive_state<detail::action_type>(
+                [ws, scbl](const schedulable&, const recurse& r){
+                    RXCPP_UNWIND_AUTO([&](){
+                        ws->release();
+                    });
+                    scbl(r);
+                }));
+        }
 
     public:
         virtual ~loop_worker()
         {
         }
-        loop_worker(composite_subscription cs, worker w, std::shared_ptr<const scheduler_interface> alive)
+        loop_worker(composite_subscription cs, loop_state& loop, std::shared_ptr<const event_loop> alive)
             : lifetime(cs)
-            , controller(w)
-            , alive(alive)
+            , alive(std::move(alive))
+            , state(std::make_shared<worker_state>(loop))
         {
-            auto token = controller.add(cs);
-            cs.add([token, w](){
+            auto w = loop.controller;
+            auto token = w.add(cs);
+            auto ws = state;
+            cs.add([token, w, ws](){
                 w.remove(token);
+                // the pending actions are dropped by the loop
+                std::unique_lock<std::mutex> guard(ws->lock);
+                ws->pending = 0;
+                --ws->loop->workers;
             });
         }
 
@@ -51,42 +151,90 @@ private:
         }
 
         virtual void schedule(const schedulable& scbl) const {
-            controller.schedule(lifetime, scbl.get_action());
+            if (!alive->rebalance) {
+                state->loop->controller.schedule(lifetime, scbl.get_action());
+                return;
+            }
+            auto loop = acquire();
+            if (loop) {
+                loop->controller.schedule(lifetime, make_pending_action(scbl));
+            }
         }
 
         virtual void schedule(clock_type::time_point when, const schedulable& scbl) const {
-            controller.schedule(when, lifetime, scbl.get_action());
+            if (!alive->rebalance) {
+                state->loop->controller.schedule(when, lifetime, scbl.get_action());
+                return;
+            }
+            auto loop = acquire();
+            if (loop) {
+                loop->controller.schedule(when, lifetime, make_pending_action(scbl));
+            }
         }
     };
 
     mutable thread_factory factory;
-    scheduler newthread;
+    std::shared_ptr<new_thread> newthread;
     mutable std::atomic<std::size_t> count;
+    bool rebalance;
+    bool sample_busy;
     composite_subscription loops_lifetime;
-    std::vector<worker> loops;
+    std::vector<std::unique_ptr<loop_state>> loops;
+
+    void start_loops() {
+        auto remaining = std::max(std::thread::hardware_concurrency(), unsigned(4));
+        while (remaining--) {
+            auto counts = std::make_shared<detail::thread_load>(sample_busy);
+            loops.emplace_back(new loop_state(newthread->create_worker(loops_lifetime, counts), counts));
+        }
+    }
+
+    // power of two choices - the less loaded of two loops
+    loop_state& choose() const {
+        auto n = loops.size();
+        auto seed = ++count;
+        auto& first = *loops[seed % n];
+        if (n == 1) {
+            return first;
+        }
+        auto offset = 1 + static_cast<std::size_t>((seed * 0x9E3779B97F4A7C15ull) >> 32) % (n - 1);
+        auto& second = *loops[(seed + offset) % n];
+        return second.is_less_loaded(first) ? second : first;
+    }
 
 public:
     event_loop()
         : factory([](std::function<void()> start){
             return std::thread(std::move(start));
         })
-        , newthread(make_new_thread())
+        , newthread(std::make_shared<new_thread>(factory))
         , count(0)
+        , rebalance(false)
+        , sample_busy(false)
     {
-        auto remaining = std::max(std::thread::hardware_concurrency(), unsigned(4));
-        while (remaining--) {
-            loops.push_back(newthread.create_worker(loops_lifetime));
-        }
+        start_loops();
     }
     explicit event_loop(thread_factory tf)
         : factory(tf)
-        , newthread(make_new_thread(tf))
+        , newthread(std::make_shared<new_thread>(tf))
         , count(0)
+        , rebalance(false)
+        , sample_busy(false)
     {
-        auto remaining = std::max(std::thread::hardware_concurrency(), unsigned(4));
-        while (remaining--) {
-            loops.push_back(newthread.create_worker(loops_lifetime));
-        }
+        start_loops();
+    }
+    /// when rebalance is true a worker that has no pending actions is moved
+    /// to a less loaded loop when the next action is scheduled.
+    /// when sample_busy is true each loop reads the clock around every action
+    /// to report the time spent running actions.
+    event_loop(thread_factory tf, bool rebalance, bool sample_busy = false)
+        : factory(tf)
+        , newthread(std::make_shared<new_thread>(tf))
+        , count(0)
+        , rebalance(rebalance)
+        , sample_busy(sample_busy)
+    {
+        start_loops();
     }
     virtual ~event_loop()
     {
@@ -97,8 +245,25 @@ public:
         return clock_type::now();
     }
 
+    /// the load on each loop. the values are read without a lock, each one is
+    /// current but they are not a consistent snapshot.
+    std::vector<loop_load> get_load() const {
+        std::vector<loop_load> result;
+        result.reserve(loops.size());
+        for (auto& loop : loops) {
+            result.push_back(loop_load{
+                loop->workers,
+                loop->counts->queued,
+                loop->counts->actions,
+                clock_type::duration(loop->counts->busy)});
+        }
+        return result;
+    }
+
     virtual worker create_worker(composite_subscription cs) const {
-        return worker(cs, std::make_shared<loop_worker>(cs, loops[++count % loops.size()], this->shared_from_this()));
+        auto& loop = choose();
+        ++loop.workers;
+        return worker(cs, rxu::make_shared_state<loop_worker>(cs, loop, std::static_pointer_cast<const event_loop>(this->shared_from_this())));
     }
 };
 
@@ -109,6 +274,9 @@ inline scheduler make_event_loop() {
 inline scheduler make_event_loop(thread_factory tf) {
     return make_scheduler<event_loop>(tf);
 }
+inline scheduler make_event_loop(thread_factory tf, bool rebalance, bool sample_busy = false) {
+    return make_scheduler<event_loop>(tf, rebalance, sample_busy);
+}
 
 }
 
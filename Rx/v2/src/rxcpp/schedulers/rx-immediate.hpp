@@ -56,7 +56,7 @@ private:
 
 public:
     immediate()
-        : wi(std::make_shared<immediate_worker>())
+        : wi(rxu::make_shared_state<immediate_worker>())
     {
     }
     virtual ~immediate()
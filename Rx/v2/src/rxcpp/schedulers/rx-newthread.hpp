@@ -13,6 +13,33 @@ namespace schedulers {
 
 using thread_factory = std::function<std::thread(std::function<void()>)>;
 
+namespace detail {
+
+// the load on a new_thread worker. the worker keeps the counts itself so that
+// actions are queued and run without a wrapper. used by event_loop.
+struct thread_load
+{
+    using clock_type = scheduler_base::clock_type;
+
+    explicit thread_load(bool sample_busy)
+        : queued(0)
+        , actions(0)
+        , busy(0)
+        , sample_busy(sample_busy)
+    {
+    }
+
+    // actions that are queued or running
+    std::atomic<std::size_t> queued;
+    // actions that have run
+    std::atomic<std::size_t> actions;
+    // time spent running actions, only kept when sample_busy is set
+    std::atomic<clock_type::rep> busy;
+    const bool sample_busy;
+};
+
+}
+
 struct new_thread : public scheduler_interface
 {
 private:
@@ -38,12 +65,14 @@ private:
             {
             }
 
-            explicit new_worker_state(composite_subscription cs)
+            new_worker_state(composite_subscription cs, std::shared_ptr<detail::thread_load> load)
                 : lifetime(cs)
+                , load(std::move(load))
             {
             }
 
             composite_subscription lifetime;
+            std::shared_ptr<detail::thread_load> load;
             mutable std::mutex lock;
             mutable std::condition_variable wake;
             mutable queue_item_time q;
@@ -63,8 +92,8 @@ private:
         {
         }
 
-        new_worker(composite_subscription cs, thread_factory& tf)
-            : state(std::make_shared<new_worker_state>(cs))
+        new_worker(composite_subscription cs, thread_factory& tf, std::shared_ptr<detail::thread_load> load)
+            : state(rxu::make_shared_state<new_worker_state>(cs, std::move(load)))
         {
             auto keepAlive = state;
 
@@ -87,7 +116,7 @@ private:
             state->worker = tf([keepAlive](){
 
                 // take ownership
-                queue_type::ensure(std::make_shared<new_worker>(keepAlive));
+                queue_type::ensure(rxu::make_shared_state<new_worker>(keepAlive));
                 // release ownership
                 RXCPP_UNWIND_AUTO([]{
                     queue_type::destroy();
@@ -106,6 +135,9 @@ private:
                     auto& peek = keepAlive->q.top();
                     if (!peek.what.is_subscribed()) {
                         keepAlive->q.pop();
+                        if (keepAlive->load) {
+                            --keepAlive->load->queued;
+                        }
                         continue;
                     }
                     auto when = peek.when;
@@ -117,6 +149,23 @@ private:
                     keepAlive->q.pop();
                     keepAlive->r.reset(keepAlive->q.empty());
                     guard.unlock();
+                    if (!keepAlive->load) {
+                        what(keepAlive->r.get_recurse());
+                        continue;
+                    }
+                    auto& load = *keepAlive->load;
+                    RXCPP_UNWIND_AUTO([&](){
+                        --load.queued;
+                        ++load.actions;
+                    });
+                    if (!load.sample_busy) {
+                        what(keepAlive->r.get_recurse());
+                        continue;
+                    }
+                    auto start = clock_type::now();
+                    RXCPP_UNWIND_AUTO([&](){
+                        load.busy += (clock_type::now() - start).count();
+                    });
                     what(keepAlive->r.get_recurse());
                 }
             });
@@ -135,6 +184,9 @@ private:
                 std::unique_lock<std::mutex> guard(state->lock);
                 state->q.push(new_worker_state::item_type(when, scbl));
                 state->r.reset(false);
+                if (state->load) {
+                    ++state->load->queued;
+                }
             }
             state->wake.notify_one();
         }
@@ -162,7 +214,12 @@ public:
     }
 
     virtual worker create_worker(composite_subscription cs) const {
-        return worker(cs, std::make_shared<new_worker>(cs, factory));
+        return worker(cs, rxu::make_shared_state<new_worker>(cs, factory, nullptr));
+    }
+
+    /// a worker that keeps its counts in load
+    worker create_worker(composite_subscription cs, std::shared_ptr<detail::thread_load> load) const {
+        return worker(cs, rxu::make_shared_state<new_worker>(cs, factory, std::move(load)));
     }
 };
 
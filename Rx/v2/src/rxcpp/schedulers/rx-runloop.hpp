@@ -13,6 +13,10 @@ namespace schedulers {
 
 namespace detail {
 
+// the most items that dispatch_all takes under one lock.
+// the lock is released while they run, so other threads can schedule.
+const std::size_t run_loop_batch = 64;
+
 struct run_loop_state : public std::enable_shared_from_this<run_loop_state>
 {
     using clock_type = scheduler::clock_type;
@@ -35,6 +39,8 @@ struct run_loop_state : public std::enable_shared_from_this<run_loop_state>
     mutable queue_item_time q;
     recursion r;
     std::function<void(clock_type::time_point)> notify_earlier_wakeup;
+    // reused by dispatch_n to hold the items that are taken under one lock
+    std::vector<schedulable> ready;
 };
 
 }
@@ -192,6 +198,61 @@ public:
         what(state->r.get_recurse());
     }
 
+    /// run up to n of the items that are due, taking the lock once.
+    /// returns the number of items that were run.
+    std::size_t dispatch_n(std::size_t n) const {
+        std::vector<schedulable> batch;
+        {
+            std::unique_lock<std::mutex> guard(state->lock);
+            batch.swap(state->ready);
+            auto now = clock_type::now();
+            while (batch.size() < n && !state->q.empty()) {
+                auto& peek = state->q.top();
+                if (peek.what.is_subscribed()) {
+                    if (now < peek.when) {
+                        break;
+                    }
+                    batch.push_back(peek.what);
+                }
+                state->q.pop();
+            }
+            // only a single item may tail-recurse, otherwise it would run ahead of the rest of the batch
+            state->r.reset(batch.size() == 1 && state->q.empty());
+        }
+        for (auto& what : batch) {
+            what(state->r.get_recurse());
+        }
+        auto ran = batch.size();
+        batch.clear();
+        {
+            std::unique_lock<std::mutex> guard(state->lock);
+            if (state->ready.capacity() < batch.capacity()) {
+                batch.swap(state->ready);
+            }
+        }
+        return ran;
+    }
+
+    /// run the items that are due, in batches, until none are due or the deadline has passed.
+    /// items that are scheduled for now while this runs are also run.
+    /// returns the number of items that were run.
+    std::size_t dispatch_all(clock_type::time_point deadline = clock_type::time_point::max()) const {
+        std::size_t ran = 0;
+        for (;;) {
+            auto batch = dispatch_n(detail::run_loop_batch);
+            ran += batch;
+            if (batch == 0 || !(clock_type::now() < deadline)) {
+                return ran;
+            }
+        }
+    }
+
+    /// the time that the first item in the queue is due, or time_point::max() when the queue is empty.
+    clock_type::time_point next_due() const {
+        std::unique_lock<std::mutex> guard(state->lock);
+        return state->q.empty() ? clock_type::time_point::max() : state->q.top().when;
+    }
+
     scheduler get_scheduler() const {
         return make_scheduler(sc);
     }
@@ -206,6 +267,116 @@ inline scheduler make_run_loop(const run_loop& r) {
     return r.get_scheduler();
 }
 
+#if defined(RXCPP_ON_LINUX)
+
+/// run_loop_fd connects a run_loop to a reactor, such as epoll, with an eventfd and a timerfd.
+/// add both descriptors to the reactor for reading and call dispatch() when either is readable.
+/// wake_fd() becomes readable when an item is scheduled from any thread that is due before the
+/// items already in the run_loop. timer_fd() becomes readable when the first item in the run_loop is due.
+/// the run_loop must outlive the run_loop_fd.
+class run_loop_fd
+{
+    using this_type = run_loop_fd;
+    run_loop_fd(const this_type&);
+    this_type& operator=(const this_type&);
+
+    run_loop& loop;
+    int wake;
+    int timer;
+    // true after wake was signalled until dispatch() clears it
+    std::atomic<bool> woken;
+    // the deadline that the timer is armed for
+    run_loop::clock_type::time_point armed;
+
+    void arm(run_loop::clock_type::time_point due) {
+        if (due == armed) {
+            return;
+        }
+        armed = due;
+        itimerspec spec = {};
+        if (due != run_loop::clock_type::time_point::max()) {
+            // steady_clock is CLOCK_MONOTONIC. a deadline that has passed must not be zero, which disarms the timer.
+            auto ns = (std::max)(std::chrono::duration_cast<std::chrono::nanoseconds>(due.time_since_epoch()).count(), std::chrono::nanoseconds::rep(1));
+            spec.it_value.tv_sec = static_cast<time_t>(ns / 1000000000);
+            spec.it_value.tv_nsec = static_cast<long>(ns % 1000000000);
+        }
+        if (timerfd_settime(timer, TFD_TIMER_ABSTIME, &spec, nullptr) != 0) {
+            rxu::throw_exception(std::system_error(errno, std::system_category(), "run_loop_fd timerfd_settime"));
+        }
+    }
+
+    // returns true when the descriptor was readable
+    static bool drain(int fd) {
+        std::uint64_t count = 0;
+        for (;;) {
+            if (::read(fd, &count, sizeof(count)) >= 0) {
+                return true;
+            }
+            if (errno != EINTR) {
+                return false;
+            }
+        }
+    }
+
+public:
+    explicit run_loop_fd(run_loop& rl)
+        : loop(rl)
+        , wake(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+        , timer(timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC))
+        , woken(false)
+        , armed(run_loop::clock_type::time_point::max())
+    {
+        if (wake < 0 || timer < 0) {
+            auto error = errno;
+            if (wake >= 0) ::close(wake);
+            if (timer >= 0) ::close(timer);
+            rxu::throw_exception(std::system_error(error, std::system_category(), "run_loop_fd"));
+        }
+        loop.set_notify_earlier_wakeup([this](run_loop::clock_type::time_point){
+            // called with the run_loop lock held. one write is enough until dispatch() runs
+            if (!woken.exchange(true)) {
+                std::uint64_t one = 1;
+                while (::write(wake, &one, sizeof(one)) < 0 && errno == EINTR) {
+                }
+            }
+        });
+        arm(loop.next_due());
+    }
+    ~run_loop_fd()
+    {
+        loop.set_notify_earlier_wakeup(nullptr);
+        ::close(wake);
+        ::close(timer);
+    }
+
+    /// the descriptor that is readable when an earlier item has been scheduled
+    int wake_fd() const {
+        return wake;
+    }
+
+    /// the descriptor that is readable when the first item is due
+    int timer_fd() const {
+        return timer;
+    }
+
+    /// run the items that are due until none are due or the deadline has passed,
+    /// then arm the timer for the next item. returns the number of items that were run.
+    std::size_t dispatch(run_loop::clock_type::time_point deadline = run_loop::clock_type::time_point::max()) {
+        drain(wake);
+        // after the read, so that an item scheduled from here on signals wake again
+        woken = false;
+        if (drain(timer)) {
+            // the timer has fired and is no longer armed
+            armed = run_loop::clock_type::time_point::max();
+        }
+        auto ran = loop.dispatch_all(deadline);
+        arm(loop.next_due());
+        return ran;
+    }
+};
+
+#endif
+
 }
 
 }
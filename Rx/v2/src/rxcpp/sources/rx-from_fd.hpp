@@ -0,0 +1,142 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_SOURCES_RX_FROM_FD_HPP)
+#define RXCPP_SOURCES_RX_FROM_FD_HPP
+
+#include "../rx-includes.hpp"
+
+/*! \file rx-from_fd.hpp
+
+    \brief Returns an observable that emits the bytes read from a file descriptor, as they arrive, in buffers of up to buffer_size bytes.
+
+    \param  fd           the descriptor to read, such as a socket or the read end of a pipe.
+    \param  buffer_size  the largest number of bytes emitted in one buffer.
+    \param  reactor      the epoll_reactor that waits for the descriptor to become readable.
+
+    \return  Observable that emits rxcpp::util::pooled_buffer<std::uint8_t> on the reactor thread and completes when read returns 0.
+
+    The descriptor is switched to non-blocking mode when the observable is subscribed and is read on the reactor thread
+    each time that it is readable. Unsubscribing removes the descriptor from the reactor. The descriptor is never closed.
+    The buffers are taken from a pool that is shared by one subscription, so a buffer that is released before the next
+    read does not allocate.
+
+    One reactor thread can watch thousands of descriptors. Each wakeup reads at most a few buffers from a descriptor before
+    moving to the next ready one, so a busy descriptor does not starve the others.
+
+    \note only available on linux.
+
+    \sample
+    \snippet from_fd.cpp from_fd sample
+    \snippet output.txt from_fd sample
+*/
+
+#if defined(RXCPP_ON_LINUX)
+
+namespace rxcpp {
+
+namespace sources {
+
+namespace detail {
+
+// the number of reads for one descriptor each time that it is reported ready
+const int from_fd_reads_per_wakeup = 4;
+
+template<class Reactor>
+struct from_fd : public source_base<rxu::pooled_buffer<std::uint8_t>>
+{
+    using buffer_type = rxu::pooled_buffer<std::uint8_t>;
+    using pool_type = rxu::buffer_pool<std::uint8_t>;
+    using reactor_type = rxu::decay_t<Reactor>;
+
+    struct from_fd_initial_type
+    {
+        from_fd_initial_type(int fd, std::size_t size, reactor_type r)
+            : fd(fd)
+            , buffer_size(size)
+            , reactor(std::move(r))
+        {
+        }
+        int fd;
+        std::size_t buffer_size;
+        reactor_type reactor;
+    };
+    from_fd_initial_type initial;
+
+    from_fd(int fd, std::size_t size, reactor_type r)
+        : initial(fd, size, std::move(r))
+    {
+    }
+
+    template<class Subscriber>
+    static void read_ready(const Subscriber& o, int fd, std::size_t size, const std::shared_ptr<pool_type>& pool) {
+        for (int reads = 0; reads != from_fd_reads_per_wakeup && o.is_subscribed(); ++reads) {
+            buffer_type buffer(pool);
+            buffer.resize(size);
+            auto n = ::read(fd, buffer.data(), size);
+            if (n > 0) {
+                buffer.resize(static_cast<std::size_t>(n));
+                o.on_next(std::move(buffer));
+            } else if (n == 0) {
+                o.on_completed();
+                return;
+            } else if (errno == EINTR) {
+                continue;
+            } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return;
+            } else {
+                o.on_error(rxu::make_error_ptr(std::system_error(errno, std::system_category(), "from_fd read")));
+                return;
+            }
+        }
+    }
+
+    template<class Subscriber>
+    void on_subscribe(Subscriber o) const {
+        static_assert(is_subscriber<Subscriber>::value, "subscribe must be passed a subscriber");
+
+        const int fd = initial.fd;
+        const std::size_t size = initial.buffer_size;
+
+        int flags = ::fcntl(fd, F_GETFL);
+        if (flags < 0 || ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+            o.on_error(rxu::make_error_ptr(std::system_error(errno, std::system_category(), "from_fd fcntl")));
+            return;
+        }
+
+        auto pool = std::make_shared<pool_type>(size);
+
+        auto registration = on_exception(
+            [&](){
+                return initial.reactor.watch(fd, EPOLLIN, [o, fd, size, pool](std::uint32_t){
+                    read_ready(o, fd, size, pool);
+                });
+            },
+            o);
+        if (registration.empty()) {
+            return;
+        }
+        o.add(registration.get());
+    }
+};
+
+}
+
+/*! @copydoc rx-from_fd.hpp
+ */
+template<class Reactor>
+auto from_fd(int fd, std::size_t buffer_size, Reactor reactor)
+    ->  typename std::enable_if<std::is_same<rxu::decay_t<Reactor>, rxsc::epoll_reactor>::value,
+            observable<rxu::pooled_buffer<std::uint8_t>, detail::from_fd<Reactor>>>::type {
+    return  observable<rxu::pooled_buffer<std::uint8_t>, detail::from_fd<Reactor>>(
+                                                            detail::from_fd<Reactor>(fd, buffer_size, std::move(reactor)));
+}
+
+}
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,140 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_SOURCES_RX_MMAP_FILE_HPP)
+#define RXCPP_SOURCES_RX_MMAP_FILE_HPP
+
+#include "../rx-includes.hpp"
+
+/*! \file rx-mmap_file.hpp
+
+    \brief Returns an observable that maps a file into memory and emits views of consecutive chunks of it.
+
+    \param  path        the path of the file to map.
+    \param  chunk_size  the largest number of bytes in one view (optional).
+
+    \return  Observable that emits rxcpp::util::shared_view chunks that point into the mapped file, then completes.
+
+    The file is mapped when the observable is subscribed and unmapped when the last view into it is destroyed.
+    The chunks are emitted on the thread that subscribes and the bytes are not copied. The chunks are contiguous,
+    so split_records and split_lines can join a record that spans two chunks without copying it.
+
+    \note only available on linux.
+
+    \sample
+    \snippet mmap_file.cpp mmap_file sample
+    \snippet output.txt mmap_file sample
+*/
+
+#if defined(RXCPP_ON_LINUX)
+
+namespace rxcpp {
+
+namespace sources {
+
+namespace detail {
+
+const std::size_t mmap_file_chunk_size = 1 << 20;
+
+// unmaps the file when the last view into it is destroyed
+struct mapped_file
+{
+    mapped_file(void* a, std::size_t s)
+        : address(a)
+        , size(s)
+    {
+    }
+    ~mapped_file()
+    {
+        ::munmap(address, size);
+    }
+    void* address;
+    std::size_t size;
+};
+
+struct mmap_file : public source_base<rxu::shared_view>
+{
+    struct mmap_file_initial_type
+    {
+        mmap_file_initial_type(std::string p, std::size_t c)
+            : path(std::move(p))
+            , chunk_size(c == 0 ? mmap_file_chunk_size : c)
+        {
+        }
+        std::string path;
+        std::size_t chunk_size;
+    };
+    mmap_file_initial_type initial;
+
+    mmap_file(std::string p, std::size_t c)
+        : initial(std::move(p), c)
+    {
+    }
+
+    template<class Subscriber>
+    static void on_system_error(const Subscriber& o, int error, const char* what) {
+        o.on_error(rxu::make_error_ptr(std::system_error(error, std::system_category(), what)));
+    }
+
+    template<class Subscriber>
+    void on_subscribe(Subscriber o) const {
+        static_assert(is_subscriber<Subscriber>::value, "subscribe must be passed a subscriber");
+
+        int fd = ::open(initial.path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            on_system_error(o, errno, "mmap_file open");
+            return;
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            auto error = errno;
+            ::close(fd);
+            on_system_error(o, error, "mmap_file fstat");
+            return;
+        }
+        auto size = static_cast<std::size_t>(st.st_size);
+        if (size == 0) {
+            // an empty file cannot be mapped
+            ::close(fd);
+            o.on_completed();
+            return;
+        }
+        void* address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        auto error = errno;
+        // the mapping stays valid after the descriptor is closed
+        ::close(fd);
+        if (address == MAP_FAILED) {
+            on_system_error(o, error, "mmap_file mmap");
+            return;
+        }
+        ::madvise(address, size, MADV_SEQUENTIAL);
+        auto mapping = std::make_shared<mapped_file>(address, size);
+
+        auto first = static_cast<const char*>(address);
+        for (std::size_t offset = 0; offset < size && o.is_subscribed(); offset += initial.chunk_size) {
+            o.on_next(rxu::shared_view(mapping, first + offset, (std::min)(initial.chunk_size, size - offset)));
+        }
+        o.on_completed();
+    }
+};
+
+}
+
+/*! @copydoc rx-mmap_file.hpp
+ */
+template<class Path>
+auto mmap_file(Path&& path, std::size_t chunk_size = detail::mmap_file_chunk_size)
+    ->  typename std::enable_if<std::is_convertible<Path, std::string>::value,
+            observable<rxu::shared_view, detail::mmap_file>>::type {
+    return  observable<rxu::shared_view, detail::mmap_file>(
+                                            detail::mmap_file(std::string(std::forward<Path>(path)), chunk_size));
+}
+
+}
+
+}
+
+#endif
+
+#endif
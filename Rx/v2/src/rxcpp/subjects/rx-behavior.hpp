@@ -19,33 +19,67 @@ class behavior_observer : public detail::multicast_observer<T>
     using this_type = behavior_observer<T>;
     using base_type = detail::multicast_observer<T>;
 
-    class behavior_observer_state : public std::enable_shared_from_this<behavior_observer_state>
+    // small trivially copyable values are published with a seqlock.
+    // readers copy the value without a lock and retry if a write overlapped.
+    class seqlock_state
     {
+        // serializes writers only
         mutable std::mutex lock;
-        mutable T value;
+        mutable rxu::seqlock<T> value;
 
     public:
-        behavior_observer_state(T first)
+        explicit seqlock_state(T first)
             : value(first)
         {
         }
 
-        void reset(T v) const {
+        void reset(const T& v) const {
             std::unique_lock<std::mutex> guard(lock);
-            value = std::move(v);
+            value.store(v);
         }
         T get() const {
-            std::unique_lock<std::mutex> guard(lock);
-            return value;
+            return value.load();
+        }
+        std::shared_ptr<const T> get_snapshot() const {
+            return std::make_shared<const T>(value.load());
         }
     };
 
+    // other values are published as immutable snapshots. readers copy
+    // the pointer and never copy the value while the writer holds it.
+    class snapshot_state
+    {
+        mutable std::shared_ptr<const T> value;
+
+    public:
+        explicit snapshot_state(T first)
+            : value(rxu::make_shared_state<T>(std::move(first)))
+        {
+        }
+
+        void reset(const T& v) const {
+            std::shared_ptr<const T> next = rxu::make_shared_state<T>(v);
+            std::atomic_store_explicit(&value, std::move(next), std::memory_order_release);
+        }
+        T get() const {
+            return *get_snapshot();
+        }
+        std::shared_ptr<const T> get_snapshot() const {
+            return std::atomic_load_explicit(&value, std::memory_order_acquire);
+        }
+    };
+
+    using behavior_observer_state = std::conditional_t<
+        std::is_trivially_copyable<T>::value && sizeof(T) <= 8 * sizeof(void*),
+        seqlock_state,
+        snapshot_state>;
+
     std::shared_ptr<behavior_observer_state> state;
 
 public:
     behavior_observer(T f, composite_subscription l)
         : base_type(l)
-        , state(std::make_shared<behavior_observer_state>(std::move(f)))
+        , state(rxu::make_shared_state<behavior_observer_state>(std::move(f)))
     {
     }
 
@@ -57,6 +91,10 @@ public:
         return state->get();
     }
 
+    std::shared_ptr<const T> get_snapshot() const {
+        return state->get_snapshot();
+    }
+
     template<class V>
     void on_next(V v) const {
         state->reset(v);
@@ -85,6 +123,11 @@ public:
         return s.get_value();
     }
 
+    /// the current value, shared without a copy when T is not a small trivially copyable type
+    std::shared_ptr<const T> get_snapshot() const {
+        return s.get_snapshot();
+    }
+
     subscriber<T> get_subscriber() const {
         return s.get_subscriber();
     }
@@ -100,7 +100,7 @@ public:
     {
         replayLifetime.add(subscriberLifetime);
         auto coordinator = coordination.create_coordinator(replayLifetime);
-        state = std::make_shared<replay_observer_state>(std::move(count), std::move(period), std::move(coordination), std::move(coordinator), std::move(replayLifetime));
+        state = rxu::make_shared_state<replay_observer_state>(std::move(count), std::move(period), std::move(coordination), std::move(coordinator), std::move(replayLifetime));
     }
 
     subscriber<T> get_subscriber() const {
@@ -119,6 +119,10 @@ public:
         state->add(v);
         base_type::on_next(v);
     }
+    void on_next(T&& v) const {
+        state->add(v);
+        base_type::on_next(std::move(v));
+    }
 };
 
 }
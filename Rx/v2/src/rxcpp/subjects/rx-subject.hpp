@@ -78,14 +78,21 @@ class multicast_observer
 
     // this type prevents a circular ref between state and completer
     struct binder_type
-        : public std::enable_shared_from_this<binder_type>
+        : public rxu::intrusive_ref_counted<>
     {
         explicit binder_type(composite_subscription cs)
-            : state(std::make_shared<state_type>(cs))
+            : state(rxu::make_shared_state<state_type>(cs))
             , id(trace_id::make_next_id_subscriber())
         {
         }
 
+        // the lifetime and the observers keep weak references to the binder
+        virtual void release() {
+            current_completer.reset();
+            completer.reset();
+            state.reset();
+        }
+
         std::shared_ptr<state_type> state;
 
         trace_id id;
@@ -97,15 +104,25 @@ class multicast_observer
         mutable std::shared_ptr<completer_type> completer;
     };
 
-    std::shared_ptr<binder_type> b;
+    rxu::intrusive_ptr<binder_type> b;
+
+    std::shared_ptr<completer_type> get_current_completer() const {
+        auto current_completer = b->current_completer.lock();
+        if (!current_completer) {
+            std::unique_lock<std::mutex> guard(b->state->lock);
+            b->current_completer = b->completer;
+            current_completer = b->current_completer.lock();
+        }
+        return current_completer;
+    }
 
 public:
     using input_subscriber_type = subscriber <T, observer<T, detail::multicast_observer<T>>>;
 
     explicit multicast_observer(composite_subscription cs)
-        : b(std::make_shared<binder_type>(cs))
+        : b(rxu::make_intrusive_state<binder_type>(cs))
     {
-        std::weak_ptr<binder_type> binder = b;
+        rxu::intrusive_weak_ptr<binder_type> binder = b;
         b->state->lifetime.add([binder](){
             auto b = binder.lock();
             if (b && b->state->current == mode::Casting){
@@ -136,15 +153,15 @@ public:
         case mode::Casting:
             {
                 if (o.is_subscribed()) {
-                    std::weak_ptr<binder_type> binder = b;
+                    rxu::intrusive_weak_ptr<binder_type> binder = b;
                     o.add([=](){
                         auto b = binder.lock();
                         if (b) {
                             std::unique_lock<std::mutex> guard(b->state->lock);
-                            b->completer = std::make_shared<completer_type>(b->state, b->completer);
+                            b->completer = rxu::make_shared_state<completer_type>(b->state, b->completer);
                         }
                     });
-                    b->completer = std::make_shared<completer_type>(b->state, b->completer, o);
+                    b->completer = rxu::make_shared_state<completer_type>(b->state, b->completer, o);
                 }
             }
             break;
@@ -175,12 +192,7 @@ public:
         }
     }
     void on_next(const T& v) const {
-        auto current_completer = b->current_completer.lock();
-        if (!current_completer) {
-            std::unique_lock<std::mutex> guard(b->state->lock);
-            b->current_completer = b->completer;
-            current_completer = b->current_completer.lock();
-        }
+        auto current_completer = get_current_completer();
         if (!current_completer || current_completer->observers.empty()) {
             return;
         }
@@ -190,6 +202,23 @@ public:
             }
         }
     }
+    void on_next(T&& v) const {
+        auto current_completer = get_current_completer();
+        if (!current_completer || current_completer->observers.empty()) {
+            return;
+        }
+        // copy to all but the last observer, which takes the value
+        auto& observers = current_completer->observers;
+        auto last = std::prev(observers.end());
+        for (auto o = observers.begin(); o != last; ++o) {
+            if (o->is_subscribed()) {
+                o->on_next(v);
+            }
+        }
+        if (last->is_subscribed()) {
+            last->on_next(std::move(v));
+        }
+    }
     void on_error(rxu::error_ptr e) const {
         std::unique_lock<std::mutex> guard(b->state->lock);
         if (b->state->current == mode::Casting) {
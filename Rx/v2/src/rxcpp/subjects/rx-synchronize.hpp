@@ -23,80 +23,110 @@ class synchronize_observer : public detail::multicast_observer<T>
     using coordinator_type = typename coordination_type::coordinator_type;
     using output_type = typename coordinator_type::template get<subscriber < T>>::type;
 
+    // producers push into a lock-free queue and the first producer to find
+    // the queue idle schedules a drain on the coordination worker. the drain
+    // delivers batches until the queue is empty and then marks it idle again.
     struct synchronize_observer_state : public std::enable_shared_from_this<synchronize_observer_state>
     {
-        using notification_type = rxn::notification<T>;
-        using base_notification_type = typename notification_type::type;
-        using queue_type = std::deque<base_notification_type>;
-
-        struct mode
+        // one queued notification. the value is stored in the queue node
+        struct item
         {
-            enum type {
-                Invalid = 0,
-                Processing,
-                Empty,
-                Disposed
-            };
+            template<class V>
+            static item next(V&& v) {
+                item i;
+                i.value.reset(std::forward<V>(v));
+                return i;
+            }
+            static item error(rxu::error_ptr e) {
+                item i;
+                i.ep = std::move(e);
+                return i;
+            }
+            static item completed() {
+                return item();
+            }
+            void accept(const output_type& o) {
+                if (!value.empty()) {
+                    o.on_next(std::move(value.get()));
+                } else if (ep) {
+                    o.on_error(ep);
+                } else {
+                    o.on_completed();
+                }
+            }
+            rxu::detail::maybe<T> value;
+            rxu::error_ptr ep;
         };
+        using queue_type = rxu::mpsc_queue<item>;
+
+        // the number of items delivered before the drain yields the worker
+        static const std::size_t drain_batch = 64;
 
-        mutable std::mutex lock;
-        mutable std::condition_variable wake;
-        mutable queue_type fill_queue;
+        mutable queue_type queue;
+        // true while a drain is scheduled or running
+        mutable std::atomic<bool> scheduled;
         composite_subscription lifetime;
-        mutable typename mode::type current;
         coordinator_type coordinator;
         output_type destination;
 
-        void ensure_processing(std::unique_lock<std::mutex>& guard) const {
-            if (!guard.owns_lock()) {
-                std::terminate();
-            }
-            if (current == mode::Empty) {
-                current = mode::Processing;
-                auto keepAlive = this->shared_from_this();
-
-                auto drain_queue = [keepAlive, this](const rxsc::schedulable& self){
-                    RXCPP_TRY {
-                        std::unique_lock<std::mutex> guard(lock);
-                        if (!destination.is_subscribed()) {
-                            current = mode::Disposed;
-                            fill_queue.clear();
-                            guard.unlock();
-                            lifetime.unsubscribe();
-                            return;
+        void drain(const rxsc::schedulable& self) const {
+            RXCPP_TRY {
+                for (std::size_t delivered = 0;; ++delivered) {
+                    if (!destination.is_subscribed()) {
+                        // stays scheduled so that no further drain is started
+                        while (!queue.pop().empty()) {
                         }
-                        if (fill_queue.empty()) {
-                            current = mode::Empty;
+                        lifetime.unsubscribe();
+                        return;
+                    }
+                    if (delivered == drain_batch) {
+                        self();
+                        return;
+                    }
+                    auto next = queue.pop();
+                    if (next.empty()) {
+                        scheduled.store(false);
+                        // a producer may have pushed after the pop and
+                        // found the drain still scheduled
+                        if (queue.empty() || scheduled.exchange(true)) {
                             return;
                         }
-                        auto notification = std::move(fill_queue.front());
-                        fill_queue.pop_front();
-                        guard.unlock();
-                        std::move(*notification).accept(destination);
-                        self();
-                    } RXCPP_CATCH(...) {
-                        destination.on_error(rxu::current_exception());
-                        std::unique_lock<std::mutex> guard(lock);
-                        current = mode::Empty;
+                        continue;
                     }
-                };
-
-                auto selectedDrain = on_exception(
-                    [&](){return coordinator.act(drain_queue);},
-                    destination);
-                if (selectedDrain.empty()) {
-                    return;
+                    next.get().accept(destination);
                 }
+            } RXCPP_CATCH(...) {
+                destination.on_error(rxu::current_exception());
+                scheduled.store(false);
+            }
+        }
 
-                auto processor = coordinator.get_worker();
-                guard.unlock();
-                processor.schedule(lifetime, selectedDrain.get());
+        void ensure_processing() const {
+            if (scheduled.exchange(true)) {
+                return;
             }
+            auto keepAlive = this->shared_from_this();
+
+            auto drain_queue = [keepAlive, this](const rxsc::schedulable& self){
+                drain(self);
+            };
+
+            auto selectedDrain = on_exception(
+                [&](){return coordinator.act(drain_queue);},
+                destination);
+            if (selectedDrain.empty()) {
+                return;
+            }
+
+            // the input lifetime ends with on_completed, which is still
+            // queued, so the drain is bound to the worker lifetime instead
+            auto processor = coordinator.get_worker();
+            processor.schedule(selectedDrain.get());
         }
 
         synchronize_observer_state(coordinator_type coor, composite_subscription cs, output_type scbr)
-            : lifetime(std::move(cs))
-            , current(mode::Empty)
+            : scheduled(false)
+            , lifetime(std::move(cs))
             , coordinator(std::move(coor))
             , destination(std::move(scbr))
         {
@@ -105,27 +135,21 @@ class synchronize_observer : public detail::multicast_observer<T>
         template<class V>
         void on_next(V v) const {
             if (lifetime.is_subscribed()) {
-                std::unique_lock<std::mutex> guard(lock);
-                fill_queue.push_back(notification_type::on_next(std::move(v)));
-                ensure_processing(guard);
+                queue.push(item::next(std::move(v)));
+                ensure_processing();
             }
-            wake.notify_one();
         }
         void on_error(rxu::error_ptr e) const {
             if (lifetime.is_subscribed()) {
-                std::unique_lock<std::mutex> guard(lock);
-                fill_queue.push_back(notification_type::on_error(e));
-                ensure_processing(guard);
+                queue.push(item::error(e));
+                ensure_processing();
             }
-            wake.notify_one();
         }
         void on_completed() const {
             if (lifetime.is_subscribed()) {
-                std::unique_lock<std::mutex> guard(lock);
-                fill_queue.push_back(notification_type::on_completed());
-                ensure_processing(guard);
+                queue.push(item::completed());
+                ensure_processing();
             }
-            wake.notify_one();
         }
     };
 
@@ -140,7 +164,7 @@ public:
         // creates a worker whose lifetime is the same as the destination subscription
         auto coordinator = cn.create_coordinator(dl);
 
-        state = std::make_shared<synchronize_observer_state>(std::move(coordinator), std::move(il), std::move(o));
+        state = rxu::make_shared_state<synchronize_observer_state>(std::move(coordinator), std::move(il), std::move(o));
     }
 
     subscriber<T> get_subscriber() const {
@@ -0,0 +1,282 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_RX_UNICAST_HPP)
+#define RXCPP_RX_UNICAST_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace subjects {
+
+namespace detail {
+
+// a subject that is cheap to create and to call when it has one subscriber.
+// the first subscriber is stored once and then read without a lock in on_next.
+// later subscribers are kept in a list that on_next copies under the lock.
+template<class T>
+class unicast_observer
+{
+    using observer_type = subscriber<T>;
+    using list_type = std::vector<observer_type>;
+
+    struct mode
+    {
+        enum type {
+            Invalid = 0,
+            Casting,
+            Disposed,
+            Completed,
+            Errored
+        };
+    };
+
+    struct state_type
+    {
+        explicit state_type(composite_subscription cs)
+            : current(mode::Casting)
+            , lifetime(cs)
+            , has_consumer(false)
+            , has_others(false)
+            , id(trace_id::make_next_id_subscriber())
+        {
+        }
+        std::mutex lock;
+        typename mode::type current;
+        rxu::error_ptr error;
+        composite_subscription lifetime;
+        // written once under lock, before has_consumer is set
+        rxu::maybe<observer_type> consumer;
+        std::atomic<bool> has_consumer;
+        // must only be accessed under lock
+        list_type others;
+        std::atomic<bool> has_others;
+        trace_id id;
+    };
+
+    std::shared_ptr<state_type> state;
+
+    template<class F>
+    void for_each_other(F f) const {
+        if (!state->has_others.load(std::memory_order_acquire)) {
+            return;
+        }
+        list_type others;
+        {
+            std::unique_lock<std::mutex> guard(state->lock);
+            others = state->others;
+        }
+        for (auto& o : others) {
+            if (o.is_subscribed()) {
+                f(o);
+            }
+        }
+    }
+
+public:
+    using input_subscriber_type = subscriber<T, observer<T, detail::unicast_observer<T>>>;
+
+    explicit unicast_observer(composite_subscription cs)
+        : state(rxu::make_shared_state<state_type>(cs))
+    {
+        std::weak_ptr<state_type> weak = state;
+        state->lifetime.add([weak](){
+            auto state = weak.lock();
+            if (state) {
+                std::unique_lock<std::mutex> guard(state->lock);
+                if (state->current == mode::Casting) {
+                    state->current = mode::Disposed;
+                    state->has_others = false;
+                    state->others.clear();
+                }
+            }
+        });
+    }
+    trace_id get_id() const {
+        return state->id;
+    }
+    composite_subscription get_subscription() const {
+        return state->lifetime;
+    }
+    input_subscriber_type get_subscriber() const {
+        return make_subscriber<T>(get_id(), get_subscription(), observer<T, detail::unicast_observer<T>>(*this));
+    }
+    bool has_observers() const {
+        std::unique_lock<std::mutex> guard(state->lock);
+        if (state->current != mode::Casting) {
+            return false;
+        }
+        if (!state->consumer.empty() && state->consumer->is_subscribed()) {
+            return true;
+        }
+        return std::any_of(state->others.begin(), state->others.end(),
+            [](const observer_type& o){
+                return o.is_subscribed();
+            });
+    }
+    template<class SubscriberFrom>
+    void add(const SubscriberFrom& sf, observer_type o) const {
+        trace_activity().connect(sf, o);
+        std::unique_lock<std::mutex> guard(state->lock);
+        switch (state->current) {
+        case mode::Casting:
+            {
+                if (!o.is_subscribed()) {
+                    return;
+                }
+                if (state->consumer.empty()) {
+                    state->consumer.reset(std::move(o));
+                    state->has_consumer.store(true, std::memory_order_release);
+                    return;
+                }
+                auto& others = state->others;
+                others.erase(
+                    std::remove_if(others.begin(), others.end(),
+                        [](const observer_type& other){
+                            return !other.is_subscribed();
+                        }),
+                    others.end());
+                others.push_back(std::move(o));
+                state->has_others.store(true, std::memory_order_release);
+            }
+            break;
+        case mode::Completed:
+            {
+                guard.unlock();
+                o.on_completed();
+                return;
+            }
+            break;
+        case mode::Errored:
+            {
+                auto e = state->error;
+                guard.unlock();
+                o.on_error(e);
+                return;
+            }
+            break;
+        case mode::Disposed:
+            {
+                guard.unlock();
+                o.unsubscribe();
+                return;
+            }
+            break;
+        default:
+            std::terminate();
+        }
+    }
+    void on_next(const T& v) const {
+        if (state->has_consumer.load(std::memory_order_acquire)) {
+            state->consumer->on_next(v);
+        }
+        for_each_other([&](const observer_type& o){
+            o.on_next(v);
+        });
+    }
+    // the value is moved to the consumer when there are no other subscribers
+    void on_next(T&& v) const {
+        if (state->has_others.load(std::memory_order_acquire)) {
+            on_next(static_cast<const T&>(v));
+            return;
+        }
+        if (state->has_consumer.load(std::memory_order_acquire)) {
+            state->consumer->on_next(std::move(v));
+        }
+    }
+    void on_error(rxu::error_ptr e) const {
+        std::unique_lock<std::mutex> guard(state->lock);
+        if (state->current == mode::Casting) {
+            state->error = e;
+            state->current = mode::Errored;
+            auto s = state->lifetime;
+            auto others = std::move(state->others);
+            state->others.clear();
+            state->has_others = false;
+            guard.unlock();
+            if (state->has_consumer.load(std::memory_order_acquire)) {
+                state->consumer->on_error(e);
+            }
+            for (auto& o : others) {
+                if (o.is_subscribed()) {
+                    o.on_error(e);
+                }
+            }
+            s.unsubscribe();
+        }
+    }
+    void on_completed() const {
+        std::unique_lock<std::mutex> guard(state->lock);
+        if (state->current == mode::Casting) {
+            state->current = mode::Completed;
+            auto s = state->lifetime;
+            auto others = std::move(state->others);
+            state->others.clear();
+            state->has_others = false;
+            guard.unlock();
+            if (state->has_consumer.load(std::memory_order_acquire)) {
+                state->consumer->on_completed();
+            }
+            for (auto& o : others) {
+                if (o.is_subscribed()) {
+                    o.on_completed();
+                }
+            }
+            s.unsubscribe();
+        }
+    }
+};
+
+}
+
+/*! \brief A subject for a single subscriber.
+
+    unicast has the same hot semantics as subject, but it is built for the case where the
+    observable is subscribed once, such as each window emitted by the window operators.
+    It is one allocation and on_next to the first subscriber does not take a lock or
+    touch a reference count. Further subscribers are supported on a slower path.
+*/
+template<class T>
+class unicast
+{
+    detail::unicast_observer<T> s;
+
+public:
+    using subscriber_type = typename detail::unicast_observer<T>::input_subscriber_type;
+    using observable_type = observable<T>;
+    unicast()
+        : s(composite_subscription())
+    {
+    }
+    explicit unicast(composite_subscription cs)
+        : s(cs)
+    {
+    }
+
+    bool has_observers() const {
+        return s.has_observers();
+    }
+
+    composite_subscription get_subscription() const {
+        return s.get_subscription();
+    }
+
+    subscriber_type get_subscriber() const {
+        return s.get_subscriber();
+    }
+
+    observable<T> get_observable() const {
+        auto keepAlive = s;
+        return make_observable_dynamic<T>([=](subscriber<T> o){
+            keepAlive.add(keepAlive.get_subscriber(), std::move(o));
+        });
+    }
+};
+
+}
+
+}
+
+#endif
@@ -3,6 +3,7 @@
 #include <rxcpp/operators/rx-buffer_count.hpp>
 #include <rxcpp/operators/rx-buffer_time.hpp>
 #include <rxcpp/operators/rx-buffer_time_count.hpp>
+#include <rxcpp/operators/rx-map.hpp>
 #include <rxcpp/operators/rx-take.hpp>
 
 SCENARIO("buffer count partial window", "[buffer][operators]"){
@@ -455,6 +456,90 @@ SCENARIO("buffer count error 2", "[buffer][operators]"){
     }
 }
 
+SCENARIO("buffer pooled full and partial windows", "[buffer_pooled][buffer][operators]"){
+    GIVEN("1 hot observable of ints."){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+        const rxsc::test::messages<std::vector<int>> v_on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(210, 2),
+            on.next(220, 3),
+            on.next(230, 4),
+            on.next(240, 5),
+            on.next(250, 6),
+            on.completed(260)
+        });
+
+        WHEN("group each int with the next 1 int"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        | rxo::buffer_pooled(2)
+                        | rxo::map([](const rxu::pooled_buffer<int>& b){
+                            return b.get();
+                        })
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        | rxo::as_dynamic();
+                }
+            );
+
+            THEN("the output contains groups of ints"){
+                auto required = rxu::to_vector({
+                    v_on.next(220, rxu::to_vector({ 2, 3 })),
+                    v_on.next(240, rxu::to_vector({ 4, 5 })),
+                    v_on.next(260, rxu::to_vector({ 6 })),
+                    v_on.completed(260)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was one subscription and one unsubscription to the xs"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 260)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("buffer pooled recycles storage", "[buffer_pooled][buffer][operators]"){
+    GIVEN("a range of ints."){
+        WHEN("group each int with the next 2 ints"){
+
+            std::vector<const int*> storage;
+            std::vector<std::vector<int>> values;
+            rxs::range(1, 9)
+                .buffer_pooled(3)
+                .subscribe([&](const rxu::pooled_buffer<int>& b){
+                    storage.push_back(b.data());
+                    values.push_back(b.get());
+                });
+
+            THEN("each buffer contains the next ints"){
+                auto required = rxu::to_vector({
+                    rxu::to_vector({ 1, 2, 3 }),
+                    rxu::to_vector({ 4, 5, 6 }),
+                    rxu::to_vector({ 7, 8, 9 })
+                });
+                REQUIRE(required == values);
+            }
+
+            THEN("each buffer reuses the storage of the released buffer"){
+                REQUIRE(storage.size() == 3);
+                REQUIRE(storage[0] == storage[1]);
+                REQUIRE(storage[1] == storage[2]);
+            }
+        }
+    }
+}
+
 SCENARIO("buffer with time on intervals", "[buffer_with_time][operators][long][!hide]"){
     GIVEN("7 intervals of 2 seconds"){
         WHEN("the period is 2sec and the initial is 5sec"){
@@ -1180,6 +1265,54 @@ SCENARIO("buffer with time or count, only time triggered", "[buffer_with_time_or
     }
 }
 
+SCENARIO("buffer with time or count, large count", "[buffer_with_time_or_count][operators]"){
+    GIVEN("1 hot observable of ints."){
+        auto sc = rxsc::make_test();
+        auto so = rx::synchronize_in_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(205, 1),
+            on.next(305, 2),
+            on.next(505, 3),
+            on.next(605, 4),
+            on.next(610, 5),
+            on.completed(850)
+        });
+        WHEN("the count is much larger than the groups"){
+            using namespace std::chrono;
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .buffer_with_time_or_count(milliseconds(100), 1000000, so)
+                        .map([](const std::vector<int>& v){
+                            return static_cast<int>(v.capacity());
+                        })
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("only groups with items are allocated and they are not allocated for count items"){
+                auto required = rxu::to_vector({
+                    on.next(301, 1024),
+                    on.next(401, 1024),
+                    on.next(501, 0),
+                    on.next(601, 1024),
+                    on.next(701, 1024),
+                    on.next(801, 0),
+                    on.next(851, 0),
+                    on.completed(851)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
 SCENARIO("buffer with time or count, only count triggered", "[buffer_with_time_or_count][operators]"){
     GIVEN("1 hot observable of ints."){
         auto sc = rxsc::make_test();
@@ -1250,7 +1383,7 @@ SCENARIO("buffer do 1 copy to place object in vector", "[buffer][operators][copi
     }
 }
 
-SCENARIO("buffer do 1 copy to place object in vector for move", "[buffer][operators][copies]")
+SCENARIO("buffer moves object into vector for move", "[buffer][operators][copies]")
 {
     GIVEN("observable and subscriber")
     {
@@ -1261,10 +1394,38 @@ SCENARIO("buffer do 1 copy to place object in vector for move", "[buffer][operat
         WHEN("subscribe")
         {
             obs.subscribe(sub);
-            THEN("only one copy")
+            THEN("no copies")
             {
-                REQUIRE(verifier.get_copy_count() == 1);
-                REQUIRE(verifier.get_move_count() == 0);
+                REQUIRE(verifier.get_copy_count() == 0);
+                REQUIRE(verifier.get_move_count() == 1);
+            }
+        }
+    }
+}
+
+SCENARIO("buffer_with_time does not copy values through the scheduler", "[buffer_with_time][operators][copies]")
+{
+    GIVEN("a source")
+    {
+        auto                                      sc = rxsc::make_test();
+        auto                                      so = rx::synchronize_in_one_worker(sc);
+        auto                                      w  = sc.create_worker();
+        const rxsc::test::messages<copy_verifier> on;
+        copy_verifier                             verifier{};
+
+        auto   xs    = sc.make_cold_observable({on.next(150, verifier), on.completed(300)});
+        size_t count = verifier.get_copy_count();
+
+        WHEN("start")
+        {
+            auto res = w.start([so, xs]() { return xs.buffer_with_time(std::chrono::milliseconds(100), so); });
+
+            THEN("no extra copies")
+            {
+                // at most the copy of the value out of the recorded message
+                REQUIRE(verifier.get_copy_count() - count <= 1);
+                // the value is moved through the scheduled action, the number of moves is not fixed
+                REQUIRE(verifier.get_move_count() <= 16);
             }
         }
     }
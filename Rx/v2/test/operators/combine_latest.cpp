@@ -1720,3 +1720,121 @@ SCENARIO("combine_latest provide 1 move to store in tuple, 1 copy to send value
         }
     }
 }
+
+SCENARIO("combine_latest passes references to a selector for move", "[combine_latest][join][operators][copies]")
+{
+    GIVEN("observable and subscriber")
+    {
+        auto          empty_on_next = [](const int&) {};
+        auto          sub           = rx::make_observer<int>(empty_on_next);
+        copy_verifier verifier{};
+        auto          root = verifier.get_observable_for_move();
+        auto          obs  = root.combine_latest(rxu::by_reference([](const copy_verifier&, int v) { return v; }),
+                                                 rxcpp::observable<>::just(1));
+        WHEN("subscribe")
+        {
+            obs.subscribe(sub);
+            THEN("no copies")
+            {
+                REQUIRE(verifier.get_copy_count() == 0);
+                // 1 move to tuple with cache
+                REQUIRE(verifier.get_move_count() == 1);
+            }
+        }
+    }
+}
+
+SCENARIO("combine_latest passes rvalues to a selector", "[combine_latest][join][operators]")
+{
+    GIVEN("two sources of strings")
+    {
+        auto a = rxcpp::observable<>::just(std::string("a"));
+        auto b = rxcpp::observable<>::just(std::string("b"));
+        WHEN("combined by a selector that takes rvalue references")
+        {
+            std::string result;
+            a.combine_latest([](std::string&& x, std::string&& y) { return std::move(x) + y; }, b)
+                .subscribe([&](std::string v) { result = v; });
+            THEN("the selector is passed the latest values")
+            {
+                REQUIRE(result == "ab");
+            }
+        }
+    }
+}
+
+SCENARIO("combine_latest_changed reports the source that emitted", "[combine_latest_changed][combine_latest][join][operators]"){
+    GIVEN("2 hot observables of ints."){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto o1 = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(215, 2),
+            on.next(225, 4),
+            on.completed(230)
+        });
+
+        auto o2 = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(220, 3),
+            on.next(230, 5),
+            on.completed(250)
+        });
+
+        WHEN("each int is combined with the latest from the other source"){
+
+            auto res = w.start(
+                [&]() {
+                    return o2
+                        .combine_latest_changed(
+                            [](std::size_t changed, int v2, int v1){
+                                return int(changed) * 100 + v2 + v1;
+                            },
+                            o1
+                        )
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains the index of the source that emitted"){
+                auto required = rxu::to_vector({
+                    on.next(220, 0 * 100 + 2 + 3),
+                    on.next(225, 1 * 100 + 4 + 3),
+                    on.next(230, 0 * 100 + 4 + 5),
+                    on.completed(250)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+
+        WHEN("the selector is omitted"){
+
+            using tuple_type = std::tuple<std::size_t, int, int>;
+            const rxsc::test::messages<tuple_type> ton;
+
+            auto res = w.start(
+                [&]() {
+                    return o2
+                        .combine_latest_changed(o1)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains tuples led by the index of the source that emitted"){
+                auto required = rxu::to_vector({
+                    ton.next(220, tuple_type(0, 3, 2)),
+                    ton.next(225, tuple_type(1, 3, 4)),
+                    ton.next(230, tuple_type(0, 5, 4)),
+                    ton.completed(250)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
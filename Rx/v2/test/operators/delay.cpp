@@ -1,8 +1,34 @@
 #include "../test.h"
 #include <rxcpp/operators/rx-delay.hpp>
+#include <rxcpp/operators/rx-reduce.hpp>
 
 using namespace std::chrono;
 
+const int static_onnextcalls = 1000000;
+
+SCENARIO("delay range", "[!hide][range][delay][perf]"){
+    const int& onnextcalls = static_onnextcalls;
+    GIVEN("a range"){
+        WHEN("delaying ints"){
+            typedef steady_clock clock;
+
+            auto so = rx::serialize_event_loop();
+
+            int n = 1;
+            auto start = clock::now();
+            int c = rxs::range(1, onnextcalls)
+                .delay(milliseconds(1), so)
+                .as_blocking()
+                .count();
+
+            auto finish = clock::now();
+            auto msElapsed = duration_cast<milliseconds>(finish.time_since_epoch()) -
+                   duration_cast<milliseconds>(start.time_since_epoch());
+            std::cout << "delay range       : " << n << " subscribed, " << c << " emitted, " << msElapsed.count() << "ms elapsed " << std::endl;
+        }
+    }
+}
+
 SCENARIO("delay - never", "[delay][operators]"){
     GIVEN("a source"){
         auto sc = rxsc::make_test();
@@ -312,6 +312,60 @@ SCENARIO("distinct - some changes", "[distinct][operators]"){
     }
 }
 
+SCENARIO("distinct - capacity", "[distinct][operators]"){
+    GIVEN("a source"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(210, 2), //*
+            on.next(215, 3), //*
+            on.next(220, 2),
+            on.next(225, 4), //* forgets 3
+            on.next(230, 3), //* forgets 2
+            on.next(235, 4),
+            on.next(240, 2), //* forgets 3
+            on.next(245, 4),
+            on.completed(250)
+        });
+
+        WHEN("distinct values are taken with a capacity of 2"){
+
+            auto res = w.start(
+                [xs]() {
+                    return xs.distinct(2)
+                    // forget type to workaround lambda deduction bug on msvc 2013
+                    .as_dynamic();
+                }
+            );
+
+            THEN("the output contains the items that are not among the 2 most recently seen"){
+                auto required = rxu::to_vector({
+                    on.next(210, 2), //*
+                    on.next(215, 3), //*
+                    on.next(225, 4), //*
+                    on.next(230, 3), //*
+                    on.next(240, 2), //*
+                    on.completed(250)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was 1 subscription/unsubscription to the source"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 250)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+
+        }
+    }
+}
+
 SCENARIO("distinct - strings", "[distinct][operators]"){
     GIVEN("a source"){
         auto sc = rxsc::make_test();
@@ -0,0 +1,77 @@
+#include "../test.h"
+#include <rxcpp/operators/rx-concat.hpp>
+#include <rxcpp/operators/rx-distinct_bloom.hpp>
+
+SCENARIO("distinct_bloom - some changes", "[distinct_bloom][operators]"){
+    GIVEN("a source"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(210, 2), //*
+            on.next(215, 3), //*
+            on.next(220, 3),
+            on.next(225, 2),
+            on.next(230, 2),
+            on.next(230, 1), //*
+            on.next(240, 2),
+            on.completed(250)
+        });
+
+        WHEN("distinct values are taken"){
+
+            auto res = w.start(
+                [xs]() {
+                    return xs.distinct_bloom(100, 0.001)
+                    // forget type to workaround lambda deduction bug on msvc 2013
+                    .as_dynamic();
+                }
+            );
+
+            THEN("the output only contains distinct items sent while subscribed"){
+                auto required = rxu::to_vector({
+                    on.next(210, 2), //*
+                    on.next(215, 3), //*
+                    on.next(230, 1), //*
+                    on.completed(250)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was 1 subscription/unsubscription to the source"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 250)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("distinct_bloom - expected count", "[distinct_bloom][operators]"){
+    GIVEN("a range that repeats 10000 distinct values"){
+        const int count = 10000;
+
+        WHEN("distinct values are taken with a false positive rate of 1%"){
+
+            std::vector<int> emitted;
+            rxs::range(0, count - 1)
+                .concat(rxs::range(0, count - 1))
+                .distinct_bloom(count, 0.01)
+                .subscribe([&](int v){emitted.push_back(v);});
+
+            THEN("no value is emitted twice"){
+                std::set<int> unique(emitted.begin(), emitted.end());
+                REQUIRE(unique.size() == emitted.size());
+            }
+
+            THEN("about 1% of the values are filtered out by mistake"){
+                REQUIRE(emitted.size() > count * 0.98);
+            }
+        }
+    }
+}
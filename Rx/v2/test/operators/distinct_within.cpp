@@ -0,0 +1,106 @@
+#include "../test.h"
+#include <rxcpp/operators/rx-distinct_within.hpp>
+
+using namespace std::chrono;
+
+SCENARIO("distinct_within - some changes", "[distinct_within][operators]"){
+    GIVEN("a source"){
+        auto sc = rxsc::make_test();
+        auto so = rx::identity_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(210, 2), //*
+            on.next(215, 3), //*
+            on.next(220, 2),
+            on.next(225, 3),
+            on.next(230, 2), //* 2 was emitted 20 ago
+            on.next(240, 3), //* 3 was emitted 25 ago
+            on.next(245, 2),
+            on.next(250, 2), //*
+            on.completed(260)
+        });
+
+        WHEN("distinct values are taken within 20 ticks"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .distinct_within(milliseconds(20), so)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains the items that were not emitted in the last 20 ticks"){
+                auto required = rxu::to_vector({
+                    on.next(210, 2),
+                    on.next(215, 3),
+                    on.next(230, 2),
+                    on.next(240, 3),
+                    on.next(250, 2),
+                    on.completed(260)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was 1 subscription/unsubscription to the source"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 260)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("distinct_within - throw", "[distinct_within][operators]"){
+    GIVEN("a source"){
+        auto sc = rxsc::make_test();
+        auto so = rx::identity_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        std::runtime_error ex("distinct_within on_error from source");
+
+        auto xs = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(210, 2),
+            on.next(220, 2),
+            on.error(250, ex)
+        });
+
+        WHEN("distinct values are taken within 20 ticks"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .distinct_within(milliseconds(20), so)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains the first item and the error"){
+                auto required = rxu::to_vector({
+                    on.next(210, 2),
+                    on.error(250, ex)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was 1 subscription/unsubscription to the source"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 250)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
@@ -446,9 +446,9 @@ SCENARIO("group_by do 1 copy from lambda", "[group_by][operators][copies]")
             obs.subscribe(sub);
             THEN("no extra copies")
             {
-                // 1 copy from marble lambda + 1 copy to final result (due to subject)
-                REQUIRE(verifier.get_copy_count() == 2);
-                REQUIRE(verifier.get_move_count() == 0);
+                // 1 copy from marble lambda, the subject moves to the final result
+                REQUIRE(verifier.get_copy_count() == 1);
+                REQUIRE(verifier.get_move_count() == 1);
             }
         }
     }
@@ -469,10 +469,9 @@ SCENARIO("group_by do 1 move from lambda and 1 move to internal state for move",
             obs.subscribe(sub);
             THEN("no extra copies")
             {
-                // 1 copy to final result (due to subject)
-                REQUIRE(verifier.get_copy_count() == 1);
-                // 1 move from lambda
-                REQUIRE(verifier.get_move_count() == 1);
+                REQUIRE(verifier.get_copy_count() == 0);
+                // 1 move from lambda + 1 move to final result (due to subject)
+                REQUIRE(verifier.get_move_count() == 2);
             }
         }
     }
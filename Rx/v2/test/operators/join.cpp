@@ -0,0 +1,216 @@
+#include "../test.h"
+#include <rxcpp/operators/rx-join.hpp>
+
+using namespace std::chrono;
+
+const int static_onnextcalls = 1000000;
+
+SCENARIO("join ranges", "[!hide][range][join][perf]"){
+    const int& onnextcalls = static_onnextcalls;
+    GIVEN("two ranges with the same keys"){
+        WHEN("joining them within a window that keeps every item"){
+            typedef steady_clock clock;
+
+            auto ls = rxs::range(1, onnextcalls / 2);
+            auto rs = rxs::range(1, onnextcalls / 2);
+
+            int c = 0;
+            auto start = clock::now();
+            ls.join(rs,
+                    [](int l){return l;},
+                    [](int r){return r;},
+                    hours(1),
+                    [](int l, int r){return l + r;})
+                .subscribe([&](int){++c;});
+            auto finish = clock::now();
+            auto msElapsed = duration_cast<milliseconds>(finish-start);
+            std::cout << "join ranges : " << onnextcalls << " arrived, " << c << " matched, " << msElapsed.count() << "ms elapsed " << std::endl;
+        }
+    }
+}
+
+SCENARIO("join - matches within the window", "[join][operators]"){
+    GIVEN("two sources"){
+        auto sc = rxsc::make_test();
+        auto so = rx::identity_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto ls = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(210, 1),
+            on.next(230, 2),
+            on.next(260, 1),
+            on.completed(270)
+        });
+
+        auto rs = sc.make_hot_observable({
+            on.next(150, 11),
+            on.next(215, 11), // matches 1 from 210
+            on.next(225, 12),
+            on.next(235, 21), // 1 from 210 has expired
+            on.next(250, 22), // 2 from 230 has expired
+            on.next(265, 31), // matches 1 from 260
+            on.completed(280)
+        });
+
+        WHEN("the sources are joined by the last digit within 20 ticks"){
+
+            auto res = w.start(
+                [&]() {
+                    return ls
+                        .join(rs,
+                            [](int l){return l;},
+                            [](int r){return r % 10;},
+                            milliseconds(20),
+                            [](int l, int r){return l * 100 + r;},
+                            so)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains a result for each pair that arrived within 20 ticks"){
+                auto required = rxu::to_vector({
+                    on.next(215, 111),
+                    on.next(230, 212),
+                    on.next(265, 131),
+                    on.completed(280)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was 1 subscription/unsubscription to the left source"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 270)
+                });
+                auto actual = ls.subscriptions();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was 1 subscription/unsubscription to the right source"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 280)
+                });
+                auto actual = rs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("join - every live item with the key matches", "[join][operators]"){
+    GIVEN("two sources"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+        const rxsc::test::messages<std::tuple<int, int>> out;
+
+        auto ls = sc.make_hot_observable({
+            on.next(210, 1),
+            on.next(215, 1),
+            on.next(220, 2),
+            on.completed(300)
+        });
+
+        auto rs = sc.make_hot_observable({
+            on.next(225, 1),
+            on.next(230, 2),
+            on.next(235, 1),
+            on.completed(240)
+        });
+
+        WHEN("the sources are joined by value within 100 ticks"){
+
+            auto res = w.start(
+                [&]() {
+                    return ls
+                        .join(rs,
+                            [](int l){return l;},
+                            [](int r){return r;},
+                            milliseconds(100))
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains a tuple for each matching pair, oldest first"){
+                auto required = rxu::to_vector({
+                    out.next(225, std::make_tuple(1, 1)),
+                    out.next(225, std::make_tuple(1, 1)),
+                    out.next(230, std::make_tuple(2, 2)),
+                    out.next(235, std::make_tuple(1, 1)),
+                    out.next(235, std::make_tuple(1, 1)),
+                    out.completed(300)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("join - right source throws", "[join][operators]"){
+    GIVEN("two sources"){
+        auto sc = rxsc::make_test();
+        auto so = rx::identity_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        std::runtime_error ex("join on_error from source");
+
+        auto ls = sc.make_hot_observable({
+            on.next(210, 1),
+            on.next(230, 2),
+            on.completed(300)
+        });
+
+        auto rs = sc.make_hot_observable({
+            on.next(220, 1),
+            on.error(240, ex)
+        });
+
+        WHEN("the sources are joined within 50 ticks"){
+
+            auto res = w.start(
+                [&]() {
+                    return ls
+                        .join(rs,
+                            [](int l){return l;},
+                            [](int r){return r;},
+                            milliseconds(50),
+                            [](int l, int r){return l + r;},
+                            so)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains the match and the error"){
+                auto required = rxu::to_vector({
+                    on.next(220, 2),
+                    on.error(240, ex)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was 1 subscription/unsubscription to the left source"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 240)
+                });
+                auto actual = ls.subscriptions();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was 1 subscription/unsubscription to the right source"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 240)
+                });
+                auto actual = rs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
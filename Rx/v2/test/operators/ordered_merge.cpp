@@ -0,0 +1,189 @@
+#include "../test.h"
+#include <rxcpp/operators/rx-ordered_merge.hpp>
+
+const int static_onnextcalls = 1000000;
+
+SCENARIO("ordered_merge sorted ranges", "[!hide][range][ordered_merge][perf]"){
+    const int& onnextcalls = static_onnextcalls;
+    GIVEN("8 sorted ranges"){
+        WHEN("merging them in order"){
+            using namespace std::chrono;
+            typedef steady_clock clock;
+
+            const int k = 8;
+            std::vector<rx::observable<int>> sources;
+            for (int i = 0; i < k; ++i) {
+                sources.push_back(rxs::range(i, onnextcalls - k + i, k).as_dynamic());
+            }
+
+            int c = 0;
+            int last = -1;
+            bool ordered = true;
+            auto start = clock::now();
+            rxs::iterate(sources)
+                .ordered_merge([](int v){return v;})
+                .subscribe([&](int v){
+                    ordered = ordered && last < v;
+                    last = v;
+                    ++c;
+                });
+            auto finish = clock::now();
+            auto msElapsed = duration_cast<milliseconds>(finish-start);
+            std::cout << "ordered_merge 8 ranges : " << c << " emitted, " << (ordered ? "ordered, " : "NOT ordered, ") << msElapsed.count() << "ms elapsed " << std::endl;
+        }
+    }
+}
+
+SCENARIO("ordered_merge two sources", "[ordered_merge][operators]"){
+    GIVEN("two hot sources that are each ordered"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto ys1 = sc.make_hot_observable({
+            on.next(110, 0),
+            on.next(210, 1),
+            on.next(230, 4),
+            on.next(260, 5),
+            on.completed(300)
+        });
+
+        auto ys2 = sc.make_hot_observable({
+            on.next(220, 2),
+            on.next(240, 3),
+            on.next(250, 6),
+            on.completed(280)
+        });
+
+        WHEN("they are merged by key"){
+
+            auto res = w.start(
+                [&]() {
+                    return ys1
+                        .ordered_merge([](int v){return v;}, std::less<int>(), ys2)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("each item is emitted when every source has an item or has completed"){
+                auto required = rxu::to_vector({
+                    on.next(220, 1),
+                    on.next(230, 2),
+                    on.next(240, 3),
+                    on.next(250, 4),
+                    on.next(260, 5),
+                    on.next(300, 6),
+                    on.completed(300)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was one subscription and one unsubscription to ys1"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 300)
+                });
+                auto actual = ys1.subscriptions();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was one subscription and one unsubscription to ys2"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 280)
+                });
+                auto actual = ys2.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("ordered_merge error", "[ordered_merge][operators]"){
+    GIVEN("two hot sources, one with an error"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        std::runtime_error ex("ordered_merge on_error from source");
+
+        auto ys1 = sc.make_hot_observable({
+            on.next(210, 1),
+            on.next(230, 4),
+            on.completed(300)
+        });
+
+        auto ys2 = sc.make_hot_observable({
+            on.next(220, 2),
+            on.error(245, ex)
+        });
+
+        WHEN("they are merged by key"){
+
+            auto res = w.start(
+                [&]() {
+                    return ys1
+                        .ordered_merge([](int v){return v;}, std::less<int>(), ys2)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output stops with the error"){
+                auto required = rxu::to_vector({
+                    on.next(220, 1),
+                    on.next(230, 2),
+                    on.error(245, ex)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("both sources were unsubscribed at the error"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 245)
+                });
+                REQUIRE(required == ys1.subscriptions());
+                REQUIRE(required == ys2.subscriptions());
+            }
+        }
+    }
+}
+
+SCENARIO("ordered_merge nested sources with a comparator", "[ordered_merge][operators]"){
+    GIVEN("an observable of sources that are each in descending order of the key"){
+        using item = std::pair<int, char>;
+        auto sources = rxs::from(
+            rxs::from(item(9, 'a'), item(4, 'a'), item(1, 'a')).as_dynamic(),
+            rxs::from(item(8, 'b'), item(4, 'b'), item(3, 'b'), item(2, 'b')).as_dynamic(),
+            rxs::empty<item>().as_dynamic(),
+            rxs::from(item(10, 'c'), item(5, 'c')).as_dynamic());
+
+        WHEN("they are merged by the descending key"){
+
+            std::vector<item> emitted;
+            bool completed = false;
+            sources
+                .ordered_merge([](const item& v){return v.first;}, std::greater<int>())
+                .subscribe(
+                    [&](const item& v){emitted.push_back(v);},
+                    [&](){completed = true;});
+
+            THEN("the output is in descending order and equal keys keep the order of the sources"){
+                auto required = rxu::to_vector({
+                    item(10, 'c'),
+                    item(9, 'a'),
+                    item(8, 'b'),
+                    item(5, 'c'),
+                    item(4, 'a'),
+                    item(4, 'b'),
+                    item(3, 'b'),
+                    item(2, 'b'),
+                    item(1, 'a')
+                });
+                REQUIRE(required == emitted);
+                REQUIRE(completed);
+            }
+        }
+    }
+}
@@ -0,0 +1,225 @@
+#include "../test.h"
+#include <rxcpp/operators/rx-map.hpp>
+#include <rxcpp/operators/rx-parallel_reduce.hpp>
+#include <rxcpp/operators/rx-reduce.hpp>
+#include <rxcpp/operators/rx-observe_on.hpp>
+
+const int static_onnextcalls = 10000000;
+
+SCENARIO("parallel_reduce range", "[!hide][range][parallel_reduce][reduce][perf]"){
+    const int& onnextcalls = static_onnextcalls;
+    GIVEN("a range of ints"){
+        auto cost = [](long long sum, int x) {
+            for (int i = 0; i < 50; ++i) {
+                x = (x * 31 + 7) % 1000003;
+            }
+            return sum + x;
+        };
+        WHEN("reducing on one thread"){
+            using namespace std::chrono;
+            typedef steady_clock clock;
+
+            long long result = 0;
+            auto start = clock::now();
+            rxs::range<int>(1, onnextcalls).
+                reduce(0LL, cost).
+                subscribe([&](long long r){result = r;});
+            auto finish = clock::now();
+            auto msElapsed = duration_cast<milliseconds>(finish-start);
+            std::cout << "reduce          : " << result << " result, " << msElapsed.count() << "ms elapsed " << std::endl;
+        }
+        WHEN("reducing on the event loop"){
+            using namespace std::chrono;
+            typedef steady_clock clock;
+
+            long long result = 0;
+            auto start = clock::now();
+            rxs::range<int>(1, onnextcalls).
+                parallel_reduce(0LL, cost, std::plus<long long>(), rx::observe_on_event_loop(), 65536).
+                as_blocking().
+                subscribe([&](long long r){result = r;});
+            auto finish = clock::now();
+            auto msElapsed = duration_cast<milliseconds>(finish-start);
+            std::cout << "parallel_reduce : " << result << " result, " << msElapsed.count() << "ms elapsed " << std::endl;
+        }
+    }
+}
+
+SCENARIO("parallel_reduce some data", "[parallel_reduce][operators]"){
+    GIVEN("a test hot observable of ints"){
+        auto sc = rxsc::make_test();
+        auto so = rx::identity_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(210, 1),
+            on.next(220, 2),
+            on.next(230, 3),
+            on.next(240, 4),
+            on.next(250, 5),
+            on.next(260, 6),
+            on.next(270, 7),
+            on.completed(280)
+        });
+
+        WHEN("the ints are summed in chunks of 3"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .parallel_reduce(0,
+                            [](int sum, int x) {
+                                return sum + x;
+                            },
+                            [](int a, int b) {
+                                return a + b;
+                            },
+                            so, 3)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains the sum"){
+                // the last chunk is reduced on the worker one tick after the source completes
+                auto required = rxu::to_vector({
+                    on.next(281, 28),
+                    on.completed(281)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was one subscription and one unsubscription"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 280)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("parallel_reduce empty", "[parallel_reduce][operators]"){
+    GIVEN("a test hot observable of ints"){
+        auto sc = rxsc::make_test();
+        auto so = rx::identity_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(150, 1),
+            on.completed(250)
+        });
+
+        WHEN("the ints are summed"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .parallel_reduce(0, std::plus<int>(), std::plus<int>(), so)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains the seed"){
+                auto required = rxu::to_vector({
+                    on.next(250, 0),
+                    on.completed(250)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("parallel_reduce error from accumulator", "[parallel_reduce][operators]"){
+    GIVEN("a test hot observable of ints"){
+        auto sc = rxsc::make_test();
+        auto so = rx::identity_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        std::runtime_error ex("parallel_reduce on_error from accumulator");
+
+        auto xs = sc.make_hot_observable({
+            on.next(210, 1),
+            on.next(220, 2),
+            on.next(230, 3),
+            on.next(240, 4),
+            on.completed(250)
+        });
+
+        WHEN("the accumulator throws in the second chunk"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .parallel_reduce(0,
+                            [ex](int sum, int x) {
+                                if (x == 3) {
+                                    rxu::throw_exception(ex);
+                                }
+                                return sum + x;
+                            },
+                            std::plus<int>(),
+                            so, 2)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains the error"){
+                auto required = rxu::to_vector({
+                    on.error(241, ex)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was one subscription and one unsubscription"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 241)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("parallel_reduce on the event loop keeps the order of the chunks", "[parallel_reduce][operators]"){
+    GIVEN("a range of ints"){
+        WHEN("the ints are concatenated in chunks on the event loop"){
+
+            std::string expected;
+            for (int i = 0; i < 2000; ++i) {
+                expected += std::to_string(i % 10);
+            }
+
+            std::vector<std::string> results;
+            rxs::range<int>(0, 1999).
+                map([](int i){ return std::to_string(i % 10); }).
+                parallel_reduce(std::string(),
+                    [](std::string s, const std::string& x) {
+                        return s + x;
+                    },
+                    [](const std::string& a, const std::string& b) {
+                        return a + b;
+                    },
+                    rx::observe_on_event_loop(), 7).
+                as_blocking().
+                subscribe([&](const std::string& r){results.push_back(r);});
+
+            THEN("the result is the same as a sequential reduce"){
+                REQUIRE(results.size() == 1);
+                REQUIRE(results[0] == expected);
+            }
+        }
+    }
+}
@@ -0,0 +1,172 @@
+#include "../test.h"
+#include <rxcpp/operators/rx-map.hpp>
+#include <rxcpp/operators/rx-parallel_scan.hpp>
+#include <rxcpp/operators/rx-scan.hpp>
+#include <rxcpp/operators/rx-observe_on.hpp>
+
+const int static_onnextcalls = 10000000;
+
+SCENARIO("parallel_scan range", "[!hide][range][parallel_scan][scan][perf]"){
+    const int& onnextcalls = static_onnextcalls;
+    GIVEN("a range of ints"){
+        auto cost = [](long long sum, int x) {
+            for (int i = 0; i < 50; ++i) {
+                x = (x * 31 + 7) % 1000003;
+            }
+            return sum + x;
+        };
+        WHEN("scanning on one thread"){
+            using namespace std::chrono;
+            typedef steady_clock clock;
+
+            long long result = 0;
+            auto start = clock::now();
+            rxs::range<int>(1, onnextcalls).
+                scan(0LL, cost).
+                subscribe([&](long long r){result = r;});
+            auto finish = clock::now();
+            auto msElapsed = duration_cast<milliseconds>(finish-start);
+            std::cout << "scan          : " << result << " last, " << msElapsed.count() << "ms elapsed " << std::endl;
+        }
+        WHEN("scanning on the event loop"){
+            using namespace std::chrono;
+            typedef steady_clock clock;
+
+            long long result = 0;
+            auto start = clock::now();
+            rxs::range<int>(1, onnextcalls).
+                parallel_scan(0LL, cost, std::plus<long long>(), rx::observe_on_event_loop(), 65536).
+                as_blocking().
+                subscribe([&](long long r){result = r;});
+            auto finish = clock::now();
+            auto msElapsed = duration_cast<milliseconds>(finish-start);
+            std::cout << "parallel_scan : " << result << " last, " << msElapsed.count() << "ms elapsed " << std::endl;
+        }
+    }
+}
+
+SCENARIO("parallel_scan some data", "[parallel_scan][operators]"){
+    GIVEN("a test hot observable of ints"){
+        auto sc = rxsc::make_test();
+        auto so = rx::identity_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(210, 1),
+            on.next(220, 2),
+            on.next(230, 3),
+            on.next(240, 4),
+            on.next(250, 5),
+            on.completed(260)
+        });
+
+        WHEN("the ints are summed in chunks of 2"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .parallel_scan(0, std::plus<int>(), std::plus<int>(), so, 2)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains the running sums when each chunk is done"){
+                // each chunk is scanned on the worker and every chunk after the first is adjusted
+                // by the total before it in a second scheduled action
+                auto required = rxu::to_vector({
+                    on.next(221, 1),
+                    on.next(221, 3),
+                    on.next(242, 6),
+                    on.next(242, 10),
+                    on.next(262, 15),
+                    on.completed(262)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was one subscription and one unsubscription"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 260)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("parallel_scan error", "[parallel_scan][operators]"){
+    GIVEN("a test hot observable of ints"){
+        auto sc = rxsc::make_test();
+        auto so = rx::identity_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        std::runtime_error ex("parallel_scan on_error from source");
+
+        auto xs = sc.make_hot_observable({
+            on.next(210, 1),
+            on.next(220, 2),
+            on.next(230, 3),
+            on.error(240, ex)
+        });
+
+        WHEN("the ints are summed in chunks of 2"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .parallel_scan(0, std::plus<int>(), std::plus<int>(), so, 2)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains the full chunks and the error"){
+                auto required = rxu::to_vector({
+                    on.next(221, 1),
+                    on.next(221, 3),
+                    on.error(240, ex)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("parallel_scan on the event loop keeps the order of the items", "[parallel_scan][operators]"){
+    GIVEN("a range of ints"){
+        WHEN("the ints are concatenated in chunks on the event loop"){
+
+            std::vector<std::string> expected;
+            std::string prefix;
+            for (int i = 0; i < 500; ++i) {
+                prefix += std::to_string(i % 10);
+                expected.push_back(prefix);
+            }
+
+            std::vector<std::string> results;
+            rxs::range<int>(0, 499).
+                map([](int i){ return std::to_string(i % 10); }).
+                parallel_scan(std::string(),
+                    [](std::string s, const std::string& x) {
+                        return s + x;
+                    },
+                    [](const std::string& a, const std::string& b) {
+                        return a + b;
+                    },
+                    rx::observe_on_event_loop(), 7).
+                as_blocking().
+                subscribe([&](const std::string& r){results.push_back(r);});
+
+            THEN("the results are the same as a sequential scan"){
+                REQUIRE(results == expected);
+            }
+        }
+    }
+}
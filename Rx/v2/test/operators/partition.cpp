@@ -0,0 +1,239 @@
+#include "../test.h"
+#include <rxcpp/operators/rx-map.hpp>
+#include <rxcpp/operators/rx-merge.hpp>
+#include <rxcpp/operators/rx-merge_partitions.hpp>
+#include <rxcpp/operators/rx-observe_on.hpp>
+#include <rxcpp/operators/rx-partition.hpp>
+#include <rxcpp/operators/rx-tap.hpp>
+
+const int static_onnextcalls = 1000000;
+
+SCENARIO("partition range", "[!hide][range][partition][perf]"){
+    const int& onnextcalls = static_onnextcalls;
+    GIVEN("a range of ints"){
+        WHEN("routing them to 4 shards on the event loop"){
+            using namespace std::chrono;
+            typedef steady_clock clock;
+
+            int c = 0;
+            auto start = clock::now();
+            rxs::range<int>(1, onnextcalls).
+                partition(4, [](int v){return v;}, rx::observe_on_event_loop()).
+                merge_partitions().
+                as_blocking().
+                subscribe([&](int){++c;});
+            auto finish = clock::now();
+            auto msElapsed = duration_cast<milliseconds>(finish-start);
+            std::cout << "partition 4 shards : " << c << " items, " << msElapsed.count() << "ms elapsed " << std::endl;
+        }
+    }
+}
+
+SCENARIO("partition some data", "[partition][operators]"){
+    GIVEN("a test hot observable of ints"){
+        auto sc = rxsc::make_test();
+        auto so = rx::identity_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(210, 1),
+            on.next(220, 2),
+            on.next(230, 3),
+            on.next(240, 4),
+            on.completed(250)
+        });
+
+        WHEN("the items are routed to 2 shards by value"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .partition(2, [](int v){return v;}, so)
+                        .map([](rx::grouped_observable<std::size_t, int> shard){
+                            auto key = static_cast<int>(shard.get_key());
+                            return shard.map([key](int v){return key * 100 + v;});
+                        })
+                        .merge_partitions(so)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains each item from the worker of its shard"){
+                auto required = rxu::to_vector({
+                    on.next(211, 101),
+                    on.next(221, 2),
+                    on.next(231, 103),
+                    on.next(241, 4),
+                    on.completed(251)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was 1 subscription/unsubscription to the source"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 250)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("partition source throws", "[partition][operators]"){
+    GIVEN("a test hot observable of ints"){
+        auto sc = rxsc::make_test();
+        auto so = rx::identity_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        std::runtime_error ex("partition on_error from source");
+
+        auto xs = sc.make_hot_observable({
+            on.next(210, 1),
+            on.next(220, 2),
+            on.error(230, ex)
+        });
+
+        WHEN("the items are routed to 2 shards by value"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .partition(2, [](int v){return v;}, so)
+                        .merge_partitions(so)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains the items and the error from the shards"){
+                auto required = rxu::to_vector({
+                    on.next(211, 1),
+                    on.next(221, 2),
+                    on.error(231, ex)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was 1 subscription/unsubscription to the source"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 230)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("partition with an invalid count", "[partition][operators]"){
+    GIVEN("a test hot observable of ints"){
+        auto sc = rxsc::make_test();
+        auto so = rx::identity_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        std::invalid_argument ex("partition count must be at least 1");
+
+        auto xs = sc.make_hot_observable({
+            on.next(210, 1),
+            on.next(220, 2),
+            on.completed(230)
+        });
+
+        WHEN("the items are routed to 0 shards"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .partition(0, [](int v){return v;}, so)
+                        .merge_partitions(so)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output only contains an error"){
+                auto required = rxu::to_vector({
+                    on.error(200, ex)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("no item is taken from the source"){
+                auto actual = xs.subscriptions();
+                REQUIRE(actual.size() <= 1);
+                for (auto& s : actual) {
+                    REQUIRE(s.unsubscribe() == 200);
+                }
+            }
+        }
+
+        WHEN("the items are routed to -1 shards"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .partition(-1, [](int v){return v;}, so)
+                        .merge_partitions(so)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output only contains an error"){
+                auto required = rxu::to_vector({
+                    on.error(200, ex)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("partition keeps the order of each key", "[partition][operators]"){
+    GIVEN("a range of ints"){
+        WHEN("the items are routed to 4 shards on the event loop"){
+
+            const int count = 100000;
+            // each shard only touches its own entries
+            std::vector<int> last(8, -1);
+            std::vector<std::thread::id> shard_thread(4);
+            std::vector<char> ordered(4, 1);
+            std::vector<char> one_thread(4, 1);
+            int c = 0;
+
+            rxs::range<int>(0, count - 1).
+                partition(4, [](int v){return v % 8;}, rx::observe_on_event_loop()).
+                map([&](rx::grouped_observable<std::size_t, int> shard){
+                    auto key = shard.get_key();
+                    return shard.tap([&, key](int v){
+                        auto id = std::this_thread::get_id();
+                        if (shard_thread[key] == std::thread::id()) {
+                            shard_thread[key] = id;
+                        }
+                        one_thread[key] = one_thread[key] && shard_thread[key] == id;
+                        ordered[key] = ordered[key] && last[v % 8] < v && static_cast<std::size_t>(v % 4) == key;
+                        last[v % 8] = v;
+                    });
+                }).
+                merge_partitions().
+                as_blocking().
+                subscribe([&](int){++c;});
+
+            THEN("every item arrives in order on the worker of its shard"){
+                REQUIRE(c == count);
+                REQUIRE(std::count(ordered.begin(), ordered.end(), 1) == 4);
+                REQUIRE(std::count(one_thread.begin(), one_thread.end(), 1) == 4);
+            }
+        }
+    }
+}
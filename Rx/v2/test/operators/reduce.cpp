@@ -1,5 +1,6 @@
 #include "../test.h"
 #include "rxcpp/operators/rx-reduce.hpp"
+#include "rxcpp/operators/rx-buffer_count.hpp"
 
 SCENARIO("reduce some data with seed", "[reduce][operators]"){
     GIVEN("a test hot observable of ints"){
@@ -496,3 +497,248 @@ SCENARIO("reduce doesn't provide copies for move", "[reduce][operators][copies]"
         }
     }
 }
+
+SCENARIO("min and max of vectors", "[reduce][min][max][operators]"){
+    GIVEN("an observable of vectors of ints"){
+        auto xs = rxs::iterate(std::vector<std::vector<int>>{{1, 9}, {2, 0}});
+
+        WHEN("min and max are calculated"){
+
+            auto max = xs.max().as_blocking().last();
+            auto min = xs.min().as_blocking().last();
+
+            THEN("the vectors are compared and not the values in them"){
+                REQUIRE(max == rxu::to_vector({2, 0}));
+                REQUIRE(min == rxu::to_vector({1, 9}));
+                REQUIRE(xs.as_blocking().max() == rxu::to_vector({2, 0}));
+                REQUIRE(xs.as_blocking().min() == rxu::to_vector({1, 9}));
+            }
+        }
+    }
+}
+
+SCENARIO("sum_all, average_all, min_all and max_all of batches", "[reduce][sum_all][average_all][min_all][max_all][operators]"){
+    GIVEN("a test hot observable of vectors of ints"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<std::vector<int>> on;
+        const rxsc::test::messages<int> d_on;
+        const rxsc::test::messages<double> avg_on;
+
+        auto xs = sc.make_hot_observable({
+             on.next(150, rxu::to_vector({ 100 })),
+             on.next(210, rxu::to_vector({ 3, 4, 2, 9, 1, 5, 6, 8, 7, 10, 12 })),
+             on.next(220, std::vector<int>()),
+             on.next(230, rxu::to_vector({ -1, 11 })),
+             on.completed(250)
+         });
+
+        WHEN("sum_all is calculated"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs.sum_all();
+                }
+            );
+
+            THEN("the output contains the sum of all the values"){
+                auto required = rxu::to_vector({
+                    d_on.next(250, 77),
+                    d_on.completed(250)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+
+        WHEN("average_all is calculated"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs.average_all();
+                }
+            );
+
+            THEN("the output contains the average of all the values"){
+                auto required = rxu::to_vector({
+                    avg_on.next(250, 77.0 / 13),
+                    avg_on.completed(250)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+
+        WHEN("min_all is calculated"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs.min_all();
+                }
+            );
+
+            THEN("the output contains the min of all the values"){
+                auto required = rxu::to_vector({
+                    d_on.next(250, -1),
+                    d_on.completed(250)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+
+        WHEN("max_all is calculated"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs.max_all();
+                }
+            );
+
+            THEN("the output contains the max of all the values"){
+                auto required = rxu::to_vector({
+                    d_on.next(250, 12),
+                    d_on.completed(250)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("batches of bool are not arithmetic batches", "[reduce][sum_all][operators]"){
+    GIVEN("batch types"){
+        THEN("bool is excluded for every container"){
+            REQUIRE(rxo::detail::is_arithmetic_batch<std::vector<int>>::value);
+            REQUIRE(rxo::detail::is_arithmetic_batch<std::array<int, 4>>::value);
+            REQUIRE(rxo::detail::is_arithmetic_batch<rxu::pooled_buffer<int>>::value);
+            REQUIRE(!rxo::detail::is_arithmetic_batch<std::vector<bool>>::value);
+            REQUIRE(!rxo::detail::is_arithmetic_batch<std::array<bool, 4>>::value);
+            REQUIRE(!rxo::detail::is_arithmetic_batch<rxu::pooled_buffer<bool>>::value);
+        }
+    }
+}
+
+SCENARIO("sum_all of empty batches", "[reduce][sum_all][operators][!throws]"){
+    GIVEN("a test hot observable of empty vectors"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<std::vector<int>> on;
+        const rxsc::test::messages<int> d_on;
+
+        rxcpp::empty_error ex("sum_all() requires a stream with at least one value");
+
+        auto xs = sc.make_hot_observable({
+             on.next(210, std::vector<int>()),
+             on.completed(250)
+         });
+
+        WHEN("sum_all is calculated"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs.sum_all();
+                }
+            );
+
+            THEN("the output contains an error"){
+                auto required = rxu::to_vector({
+                    d_on.error(250, ex)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("blocking reductions of a contiguous source", "[reduce][sum][average][min][max][count][operators]"){
+    GIVEN("a vector of doubles"){
+        std::vector<double> values;
+        for (int i = 0; i < 1000; ++i) {
+            values.push_back((i * 37) % 101 - 50.5);
+        }
+        double sum = 0;
+        for (auto v : values) {
+            sum += v;
+        }
+
+        WHEN("the values are reduced by a blocking observable"){
+            auto blocking = rxs::iterate(values).as_blocking();
+
+            THEN("the results are the same as the subscription"){
+                REQUIRE(blocking.count() == 1000);
+                REQUIRE(std::abs(blocking.sum() - sum) < 1e-6);
+                REQUIRE(std::abs(blocking.average() - sum / 1000) < 1e-9);
+                REQUIRE(blocking.min() == *std::min_element(values.begin(), values.end()));
+                REQUIRE(blocking.max() == *std::max_element(values.begin(), values.end()));
+                REQUIRE(blocking.min() == rxs::iterate(values).as_dynamic().as_blocking().min());
+                REQUIRE(blocking.max() == rxs::iterate(values).as_dynamic().as_blocking().max());
+            }
+        }
+
+        WHEN("the values are sent by from"){
+            auto blocking = rxs::from(3, 1, 2).as_blocking();
+
+            THEN("the results are exact"){
+                REQUIRE(blocking.count() == 3);
+                REQUIRE(blocking.sum() == 6);
+                REQUIRE(blocking.average() == 2.0);
+                REQUIRE(blocking.min() == 1);
+                REQUIRE(blocking.max() == 3);
+            }
+        }
+    }
+}
+
+SCENARIO("blocking sum of an empty contiguous source", "[reduce][sum][operators][!throws]"){
+    GIVEN("an empty vector"){
+        auto blocking = rxs::iterate(std::vector<int>()).as_blocking();
+
+        WHEN("the values are reduced by a blocking observable"){
+
+            THEN("count is zero and the others throw"){
+                REQUIRE(blocking.count() == 0);
+                REQUIRE_THROWS_AS(blocking.sum(), rxcpp::empty_error);
+                REQUIRE_THROWS_AS(blocking.average(), rxcpp::empty_error);
+                REQUIRE_THROWS_AS(blocking.min(), rxcpp::empty_error);
+                REQUIRE_THROWS_AS(blocking.max(), rxcpp::empty_error);
+            }
+        }
+    }
+}
+
+SCENARIO("blocking sum of 10 million doubles", "[!hide][reduce][sum][perf]"){
+    const int onnextcalls = 10000000;
+    GIVEN("a vector of doubles"){
+        std::vector<double> values(onnextcalls);
+        for (int i = 0; i < onnextcalls; ++i) {
+            values[i] = i % 1000;
+        }
+        WHEN("the sum is calculated"){
+            using namespace std::chrono;
+            typedef steady_clock clock;
+
+            auto dynamic = rxs::iterate(values).as_dynamic().as_blocking();
+            auto start = clock::now();
+            double subscribed = dynamic.sum();
+            auto finish = clock::now();
+            auto msElapsed = duration_cast<milliseconds>(finish-start);
+            std::cout << "subscribed sum    : " << subscribed << " result, " << msElapsed.count() << "ms elapsed " << std::endl;
+
+            auto blocking = rxs::iterate(values).as_blocking();
+            start = clock::now();
+            double contiguous = blocking.sum();
+            finish = clock::now();
+            msElapsed = duration_cast<milliseconds>(finish-start);
+            std::cout << "contiguous sum    : " << contiguous << " result, " << msElapsed.count() << "ms elapsed " << std::endl;
+
+            start = clock::now();
+            double batched = rxs::iterate(values).buffer(4096).sum_all().as_blocking().last();
+            finish = clock::now();
+            msElapsed = duration_cast<milliseconds>(finish-start);
+            std::cout << "buffer(4096) sum_all : " << batched << " result, " << msElapsed.count() << "ms elapsed " << std::endl;
+        }
+    }
+}
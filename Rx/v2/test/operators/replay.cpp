@@ -732,9 +732,9 @@ SCENARIO("replay doesn't provide copies for move", "[replay][multicast][subject]
             obs.subscribe(sub);
             THEN("no extra copies")
             {
-                // 1 copy to final lambda + 1 copy to internal state
-                REQUIRE(verifier.get_copy_count() == 2);
-                REQUIRE(verifier.get_move_count() == 0);
+                // 1 copy to internal state + 1 move to final lambda
+                REQUIRE(verifier.get_copy_count() == 1);
+                REQUIRE(verifier.get_move_count() == 1);
             }
         }
     }
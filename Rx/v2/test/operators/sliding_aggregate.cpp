@@ -0,0 +1,383 @@
+#include "../test.h"
+#include <rxcpp/operators/rx-buffer_count.hpp>
+#include <rxcpp/operators/rx-map.hpp>
+#include <rxcpp/operators/rx-sliding_aggregate.hpp>
+
+SCENARIO("sliding_aggregate count sum", "[sliding_aggregate][operators]"){
+    GIVEN("1 hot observable of ints."){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(210, 2),
+            on.next(220, 3),
+            on.next(230, 4),
+            on.next(240, 5),
+            on.completed(250)
+        });
+
+        WHEN("each int is summed with the next 2 ints"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .sliding_aggregate(3, 1, rxcpp::sum_monoid<int>())
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains the sums of the windows of buffer(3, 1)"){
+                auto required = rxu::to_vector({
+                    on.next(230, 9),
+                    on.next(240, 12),
+                    on.next(250, 9),
+                    on.next(250, 5),
+                    on.completed(250)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was one subscription and one unsubscription to the xs"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 250)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("sliding_aggregate count min and max", "[sliding_aggregate][operators]"){
+    GIVEN("1 hot observable of ints."){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(210, 5),
+            on.next(220, 3),
+            on.next(230, 8),
+            on.next(240, 1),
+            on.next(250, 7),
+            on.next(260, 6),
+            on.next(270, 2),
+            on.completed(280)
+        });
+
+        WHEN("the min of each 4 ints is taken every 2 ints"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .sliding_aggregate(4, 2, rxcpp::min_monoid<int>())
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains the min of each window"){
+                auto required = rxu::to_vector({
+                    on.next(240, 1),
+                    on.next(260, 1),
+                    on.next(280, 2),
+                    on.next(280, 2),
+                    on.completed(280)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+
+        WHEN("the max of each 2 ints is taken every 3 ints"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .sliding_aggregate(2, 3, rxcpp::max_monoid<int>())
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains the max of each window and skips the ints between windows"){
+                auto required = rxu::to_vector({
+                    on.next(220, 5),
+                    on.next(250, 7),
+                    on.next(280, 2),
+                    on.completed(280)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("sliding_aggregate count with a non-commutative monoid", "[sliding_aggregate][operators]"){
+    GIVEN("1 hot observable of strings."){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<std::string> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(210, std::string("a")),
+            on.next(220, std::string("b")),
+            on.next(230, std::string("c")),
+            on.next(240, std::string("d")),
+            on.next(250, std::string("e")),
+            on.completed(260)
+        });
+
+        WHEN("each 3 strings are concatenated"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .sliding_aggregate(3, 1, rxcpp::make_monoid(std::string(), [](const std::string& a, const std::string& b){ return a + b; }))
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the order of the items is kept"){
+                auto required = rxu::to_vector({
+                    on.next(230, std::string("abc")),
+                    on.next(240, std::string("bcd")),
+                    on.next(250, std::string("cde")),
+                    on.next(260, std::string("de")),
+                    on.next(260, std::string("e")),
+                    on.completed(260)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("sliding_aggregate count error", "[sliding_aggregate][operators]"){
+    GIVEN("1 hot observable of ints."){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        std::runtime_error ex("sliding_aggregate on_error from source");
+
+        auto xs = sc.make_hot_observable({
+            on.next(210, 1),
+            on.next(220, 2),
+            on.next(230, 3),
+            on.error(240, ex)
+        });
+
+        WHEN("each 2 ints are summed"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .sliding_aggregate(2, 1, rxcpp::sum_monoid<int>())
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains the full windows and the error"){
+                auto required = rxu::to_vector({
+                    on.next(220, 3),
+                    on.next(230, 5),
+                    on.error(240, ex)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("sliding_aggregate with time, overlapping intervals", "[sliding_aggregate][operators]"){
+    GIVEN("1 hot observable of ints."){
+        auto sc = rxsc::make_test();
+        auto so = rx::synchronize_in_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(100, 1),
+            on.next(210, 2),
+            on.next(240, 3),
+            on.next(280, 4),
+            on.next(320, 5),
+            on.next(350, 6),
+            on.next(380, 7),
+            on.next(420, 8),
+            on.next(470, 9),
+            on.completed(600)
+        });
+        WHEN("ints on intersecting intervals are summed"){
+            using namespace std::chrono;
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .sliding_aggregate(milliseconds(100), milliseconds(70), rxcpp::sum_monoid<int>(), so)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains the sums of the windows of buffer_with_time(100, 70)"){
+                auto required = rxu::to_vector({
+                    on.next(301, 9),
+                    on.next(371, 15),
+                    on.next(441, 21),
+                    on.next(511, 17),
+                    on.next(581, 0),
+                    on.next(601, 0),
+                    on.completed(601)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was one subscription and one unsubscription to the xs"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 600)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("sliding_aggregate with time, intervals with skips", "[sliding_aggregate][operators]"){
+    GIVEN("1 hot observable of ints."){
+        auto sc = rxsc::make_test();
+        auto so = rx::synchronize_in_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(100, 1),
+            on.next(210, 2),
+            on.next(240, 3),
+            on.next(280, 4),
+            on.next(320, 5),
+            on.next(350, 6),
+            on.next(380, 7),
+            on.next(420, 8),
+            on.next(470, 9),
+            on.completed(600)
+        });
+        WHEN("the max of ints on intervals with skips is taken"){
+            using namespace std::chrono;
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .sliding_aggregate(milliseconds(70), milliseconds(100), rxcpp::max_monoid<int>(), so)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains the max of each window"){
+                auto required = rxu::to_vector({
+                    on.next(271, 3),
+                    on.next(371, 6),
+                    on.next(471, 9),
+                    on.next(571, std::numeric_limits<int>::lowest()),
+                    on.completed(601)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("sliding_aggregate with time, error", "[sliding_aggregate][operators]"){
+    GIVEN("1 hot observable of ints."){
+        auto sc = rxsc::make_test();
+        auto so = rx::synchronize_in_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        std::runtime_error ex("sliding_aggregate on_error from source");
+
+        auto xs = sc.make_hot_observable({
+            on.next(210, 2),
+            on.next(240, 3),
+            on.next(280, 4),
+            on.error(320, ex)
+        });
+        WHEN("ints on intervals are summed"){
+            using namespace std::chrono;
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .sliding_aggregate(milliseconds(100), milliseconds(100), rxcpp::sum_monoid<int>(), so)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains the closed windows and the error"){
+                auto required = rxu::to_vector({
+                    on.next(301, 9),
+                    on.error(321, ex)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was one subscription and one unsubscription to the xs"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 320)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+const int static_onnextcalls = 1000000;
+
+SCENARIO("sliding_aggregate min", "[!hide][sliding_aggregate][operators][perf]"){
+    GIVEN("a range of ints"){
+        WHEN("the min of each window of 1000 ints is taken every int"){
+            using namespace std::chrono;
+            typedef steady_clock clock;
+
+            int c = 0;
+            auto start = clock::now();
+            rxs::range<int>(0, static_onnextcalls).
+                sliding_aggregate(1000, 1, rxcpp::min_monoid<int>()).
+                subscribe([&c](int){++c;});
+            auto finish = clock::now();
+            auto msElapsed = duration_cast<milliseconds>(finish-start);
+            std::cout << "sliding_aggregate min : " << c << " windows, " << msElapsed.count() << "ms elapsed " << std::endl;
+        }
+        WHEN("the min of each buffer of 1000 ints is taken every int"){
+            using namespace std::chrono;
+            typedef steady_clock clock;
+
+            int c = 0;
+            auto start = clock::now();
+            rxs::range<int>(0, static_onnextcalls / 100).
+                buffer(1000, 1).
+                map([](const std::vector<int>& b){ return *std::min_element(b.begin(), b.end()); }).
+                subscribe([&c](int){++c;});
+            auto finish = clock::now();
+            auto msElapsed = duration_cast<milliseconds>(finish-start);
+            std::cout << "buffer then min (1/100 of the items) : " << c << " windows, " << msElapsed.count() << "ms elapsed " << std::endl;
+        }
+    }
+}
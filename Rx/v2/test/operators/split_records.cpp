@@ -0,0 +1,165 @@
+#include "../test.h"
+#include <rxcpp/operators/rx-map.hpp>
+#include <rxcpp/operators/rx-reduce.hpp>
+#include <rxcpp/operators/rx-split_lines.hpp>
+#include <rxcpp/operators/rx-split_records.hpp>
+
+SCENARIO("split_records - records that span chunks", "[split_records][operators]"){
+    GIVEN("a source of string chunks"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<std::string> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(150, "x;"),
+            on.next(210, "ab;cd"),
+            on.next(220, "ef;;g"),
+            on.next(230, ""),
+            on.next(240, "h"),
+            on.completed(250)
+        });
+
+        WHEN("the chunks are split on ';'"){
+
+            auto res = w.start(
+                [xs]() {
+                    return xs
+                        .split_records(';')
+                        .map([](const rxu::shared_view& r){return r.str();})
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains each record and the bytes after the last delimiter"){
+                auto required = rxu::to_vector({
+                    on.next(210, "ab"),
+                    on.next(220, "cdef"),
+                    on.next(220, ""),
+                    on.next(250, "gh"),
+                    on.completed(250)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was 1 subscription/unsubscription to the source"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 250)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("split_lines - removes the line endings", "[split_lines][split_records][operators]"){
+    GIVEN("a source of byte chunks with \\n and \\r\\n"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        using bytes = std::vector<std::uint8_t>;
+        auto to_bytes = [](const char* s){return bytes(s, s + std::strlen(s));};
+        const rxsc::test::messages<bytes> on;
+        const rxsc::test::messages<std::string> out;
+
+        auto xs = sc.make_hot_observable({
+            on.next(210, to_bytes("one\r\ntw")),
+            on.next(220, to_bytes("o\r")),
+            on.next(230, to_bytes("\nthree\n")),
+            on.completed(250)
+        });
+
+        WHEN("the bytes are split into lines"){
+
+            auto res = w.start(
+                [xs]() {
+                    return xs
+                        .split_lines()
+                        .map([](const rxu::shared_view& r){return r.str();})
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains the lines without line endings"){
+                auto required = rxu::to_vector({
+                    out.next(210, "one"),
+                    out.next(230, "two"),
+                    out.next(230, "three"),
+                    out.completed(250)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("split_records - adjacent chunks are not copied", "[split_records][operators]"){
+    GIVEN("views of consecutive parts of one string"){
+        auto text = rxu::make_shared_view(std::string("alpha,beta,gamma"));
+        std::vector<rxu::shared_view> chunks = {text.substr(0, 3), text.substr(3, 5), text.substr(8)};
+
+        WHEN("the views are split on ','"){
+            std::vector<rxu::shared_view> records;
+            rxs::iterate(chunks)
+                .split_records(',')
+                .subscribe([&](const rxu::shared_view& r){records.push_back(r);});
+
+            THEN("each record is a view into the original string"){
+                REQUIRE(records.size() == 3);
+                REQUIRE(records[0] == std::string("alpha"));
+                REQUIRE(records[1] == std::string("beta"));
+                REQUIRE(records[2] == std::string("gamma"));
+                REQUIRE(records[0].data() == text.data());
+                REQUIRE(records[1].data() == text.data() + 6);
+                REQUIRE(records[2].data() == text.data() + 11);
+            }
+        }
+        WHEN("the views are from different strings"){
+            std::vector<rxu::shared_view> separate = {
+                rxu::make_shared_view(std::string("al")),
+                rxu::make_shared_view(std::string("ph")),
+                rxu::make_shared_view(std::string("a,b"))};
+            std::vector<std::string> records;
+            rxs::iterate(separate)
+                .split_records(',')
+                .subscribe([&](const rxu::shared_view& r){records.push_back(r.str());});
+
+            THEN("the record that spans the views is copied"){
+                REQUIRE(records == std::vector<std::string>({"alpha", "b"}));
+            }
+        }
+    }
+}
+
+SCENARIO("split_lines pooled buffers", "[!hide][split_lines][split_records][operators][perf]"){
+    const int static onnextcalls = 10000;
+    GIVEN("chunks of 4096 bytes with 64 byte lines"){
+        WHEN("the chunks are split into lines"){
+            using namespace std::chrono;
+            typedef steady_clock clock;
+
+            std::string line(63, 'x');
+            line += '\n';
+            std::string chunk;
+            while (chunk.size() < 4096) {
+                chunk += line;
+            }
+            // shift the chunk so that lines span chunks
+            chunk = chunk.substr(0, 4096 - 17);
+
+            auto start = clock::now();
+            auto lines = rxs::range(1, onnextcalls)
+                .map([&](int){return chunk;})
+                .split_lines()
+                .count()
+                .as_blocking()
+                .last();
+            auto finish = clock::now();
+            auto msElapsed = duration_cast<milliseconds>(finish-start);
+            std::cout << "split_lines  : " << onnextcalls << " chunks, " << lines << " lines, " << msElapsed.count() << "ms elapsed " << std::endl;
+        }
+    }
+}
@@ -216,3 +216,31 @@ SCENARIO("should not timeout if there is an error", "[timeout][operators]"){
         }
     }
 }
+
+SCENARIO("timeout does not copy values through the scheduler", "[timeout][operators][copies]")
+{
+    GIVEN("a source")
+    {
+        auto                                      sc = rxsc::make_test();
+        auto                                      so = rx::synchronize_in_one_worker(sc);
+        auto                                      w  = sc.create_worker();
+        const rxsc::test::messages<copy_verifier> on;
+        copy_verifier                             verifier{};
+
+        auto   xs    = sc.make_cold_observable({on.next(150, verifier), on.completed(300)});
+        size_t count = verifier.get_copy_count();
+
+        WHEN("start")
+        {
+            auto res = w.start([so, xs]() { return xs.timeout(milliseconds(500), so); });
+
+            THEN("no extra copies")
+            {
+                // at most the copy of the value out of the recorded message
+                REQUIRE(verifier.get_copy_count() - count <= 1);
+                // the value is moved through the scheduled action, the number of moves is not fixed
+                REQUIRE(verifier.get_move_count() <= 16);
+            }
+        }
+    }
+}
@@ -1076,9 +1076,9 @@ SCENARIO("window doesn't provide copies for move", "[window][operators][copies]"
             obs.subscribe(sub);
             THEN("no extra copies")
             {
-                // 1 copy to final lambda
-                REQUIRE(verifier.get_copy_count() == 1);
-                REQUIRE(verifier.get_move_count() == 0);
+                // 1 move to final lambda
+                REQUIRE(verifier.get_copy_count() == 0);
+                REQUIRE(verifier.get_move_count() == 1);
             }
         }
     }
@@ -318,3 +318,37 @@ SCENARIO("window toggle, disposed", "[window_toggle][operators]"){
         }
     }
 }
+
+SCENARIO("window_toggle does not copy values through the scheduler", "[window_toggle][operators][copies]")
+{
+    GIVEN("a source")
+    {
+        auto                                      sc = rxsc::make_test();
+        auto                                      so = rx::synchronize_in_one_worker(sc);
+        auto                                      w  = sc.create_worker();
+        const rxsc::test::messages<copy_verifier> on;
+        const rxsc::test::messages<int>           o_on;
+        copy_verifier                             verifier{};
+
+        auto   xs    = sc.make_cold_observable({on.next(150, verifier), on.completed(300)});
+        auto   ys    = sc.make_cold_observable({o_on.next(100, 1)});
+        size_t count = verifier.get_copy_count();
+
+        WHEN("start")
+        {
+            auto res = w.start([so, xs, ys]() {
+                return xs
+                    .window_toggle(ys, [](int){ return rx::observable<>::never<int>(); }, so)
+                    .merge();
+            });
+
+            THEN("no extra copies")
+            {
+                // at most the copy of the value out of the recorded message
+                REQUIRE(verifier.get_copy_count() - count <= 1);
+                // the value is moved through the scheduled action, the number of moves is not fixed
+                REQUIRE(verifier.get_move_count() <= 16);
+            }
+        }
+    }
+}
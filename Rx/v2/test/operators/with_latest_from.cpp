@@ -1687,3 +1687,44 @@ SCENARIO("with_latest_from provide doesn't provide copies for move", "[with_late
         }
     }
 }
+
+SCENARIO("with_latest_from passes references to a selector for move", "[with_latest_from][join][operators][copies]")
+{
+    GIVEN("observable and subscriber")
+    {
+        auto          empty_on_next = [](const int&) {};
+        auto          sub           = rx::make_observer<int>(empty_on_next);
+        copy_verifier verifier{};
+        auto          obs = verifier.get_observable_for_move().with_latest_from(rxu::by_reference([](const copy_verifier&, int v) { return v; }),
+                                                                                    rxcpp::observable<>::just(1));
+        WHEN("subscribe")
+        {
+            obs.subscribe(sub);
+            THEN("no copies")
+            {
+                REQUIRE(verifier.get_copy_count() == 0);
+                // 1 move to tuple with cache
+                REQUIRE(verifier.get_move_count() == 1);
+            }
+        }
+    }
+}
+
+SCENARIO("with_latest_from passes rvalues to a selector", "[with_latest_from][join][operators]")
+{
+    GIVEN("two sources of strings")
+    {
+        auto a = rxcpp::observable<>::just(std::string("a"));
+        auto b = rxcpp::observable<>::just(std::string("b"));
+        WHEN("combined by a selector that takes rvalue references")
+        {
+            std::string result;
+            a.with_latest_from([](std::string&& x, std::string&& y) { return std::move(x) + y; }, b)
+                .subscribe([&](std::string v) { result = v; });
+            THEN("the selector is passed the latest values")
+            {
+                REQUIRE(result == "ab");
+            }
+        }
+    }
+}
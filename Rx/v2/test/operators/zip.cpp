@@ -1880,6 +1880,132 @@ SCENARIO("zip error after completed right", "[zip][join][operators]"){
     }
 }
 
+SCENARIO("zip bounded drops oldest", "[zip][join][operators]"){
+    GIVEN("2 hot observables of ints."){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto o1 = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(210, 2),
+            on.next(220, 3),
+            on.next(230, 4),
+            on.completed(260)
+        });
+
+        auto o2 = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(240, 10),
+            on.next(250, 20),
+            on.completed(270)
+        });
+
+        WHEN("the fast source is bounded to 2 values"){
+
+            auto res = w.start(
+                [&]() {
+                    return o1
+                        .zip(
+                            rx::zip_limit(2, rx::zip_overflow::drop_oldest),
+                            [](int v1, int v2){
+                                return v1 + v2;
+                            },
+                            o2
+                        )
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains the newest values of the fast source"){
+                auto required = rxu::to_vector({
+                    on.next(240, 3 + 10),
+                    on.next(250, 4 + 20),
+                    on.completed(270)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was one subscription and one unsubscription to the o1"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 260)
+                });
+                auto actual = o1.subscriptions();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was one subscription and one unsubscription to the o2"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 270)
+                });
+                auto actual = o2.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("zip bounded overflow", "[zip][join][operators]"){
+    GIVEN("2 hot observables of ints."){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto o1 = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(210, 2),
+            on.next(220, 3),
+            on.next(230, 4),
+            on.completed(260)
+        });
+
+        auto o2 = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(240, 10),
+            on.completed(270)
+        });
+
+        WHEN("the fast source is bounded to 2 values"){
+
+            auto res = w.start(
+                [&]() {
+                    return o1
+                        | rxo::zip(
+                            rx::zip_limit(2),
+                            o2
+                        );
+                }
+            );
+
+            THEN("the output contains an overflow error"){
+                auto required = rxu::to_vector({
+                    rxsc::test::messages<std::tuple<int, int>>().error(230, rx::zip_overflow_error("zip source exceeded its capacity"))
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was one subscription and one unsubscription to the o1"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 230)
+                });
+                auto actual = o1.subscriptions();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was one subscription and one unsubscription to the o2"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 230)
+                });
+                auto actual = o2.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
 SCENARIO("zip doesn't provide copies", "[zip][join][operators][copies]")
 {
     GIVEN("observable and subscriber")
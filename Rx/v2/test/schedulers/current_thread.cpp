@@ -0,0 +1,95 @@
+#include "../test.h"
+
+using namespace std::chrono;
+
+SCENARIO("current_thread - immediate and timed items run in order", "[current_thread][schedulers]"){
+    GIVEN("a current_thread worker that schedules from inside an action"){
+        auto sc = rxsc::make_current_thread();
+        auto w = sc.create_worker();
+
+        std::vector<int> ran;
+        WHEN("immediate items and items due in the past and the future are scheduled"){
+            w.schedule([&](const rxsc::schedulable&){
+                auto past = w.now() - milliseconds(10);
+                w.schedule([&](const rxsc::schedulable&){
+                    ran.push_back(1);
+                });
+                w.schedule(w.now() + milliseconds(10), [&](const rxsc::schedulable&){
+                    ran.push_back(4);
+                });
+                w.schedule(past, [&](const rxsc::schedulable&){
+                    ran.push_back(0);
+                });
+                w.schedule([&](const rxsc::schedulable&){
+                    ran.push_back(2);
+                    w.schedule([&](const rxsc::schedulable&){
+                        ran.push_back(3);
+                    });
+                });
+                ran.push_back(-1);
+            });
+
+            THEN("the items run by time and then by the order they were scheduled"){
+                auto required = rxu::to_vector({-1, 0, 1, 2, 3, 4});
+                REQUIRE(required == ran);
+            }
+        }
+    }
+}
+
+SCENARIO("current_thread - tail recursion is allowed only when the queue is empty", "[current_thread][schedulers]"){
+    GIVEN("a current_thread worker"){
+        auto sc = rxsc::make_current_thread();
+        auto w = sc.create_worker();
+
+        std::vector<int> ran;
+        WHEN("an item reschedules itself while another item is queued"){
+            w.schedule([&](const rxsc::schedulable&){
+                int count = 0;
+                w.schedule([&, count](const rxsc::schedulable& self) mutable {
+                    ran.push_back(++count);
+                    if (count < 3) {
+                        self();
+                    }
+                });
+                w.schedule([&](const rxsc::schedulable&){
+                    ran.push_back(0);
+                });
+            });
+
+            THEN("the queued item runs before the item recurses"){
+                auto required = rxu::to_vector({1, 0, 2, 3});
+                REQUIRE(required == ran);
+            }
+        }
+    }
+}
+
+SCENARIO("current_thread - trampoline", "[!hide][current_thread][schedulers][perf]"){
+    const int count = 1000000;
+    GIVEN("a current_thread worker"){
+        WHEN("1 million items are scheduled from inside an action"){
+            typedef steady_clock clock;
+
+            auto sc = rxsc::make_current_thread();
+            auto w = sc.create_worker();
+
+            int ran = 0;
+            auto start = clock::now();
+            w.schedule([&](const rxsc::schedulable&){
+                for (int i = 0; i < count; ++i) {
+                    w.schedule([&](const rxsc::schedulable&){
+                        ++ran;
+                    });
+                }
+            });
+            auto finish = clock::now();
+            auto msElapsed = duration_cast<milliseconds>(finish-start);
+            std::cout << "current_thread      : " << ran << " scheduled, " << msElapsed.count() << "ms elapsed " << ran / (msElapsed.count() / 1000.0) << " ops/sec" << std::endl;
+
+            THEN("every item is run"){
+                REQUIRE(ran == count);
+            }
+        }
+    }
+}
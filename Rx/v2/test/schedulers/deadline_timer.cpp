@@ -0,0 +1,119 @@
+#include "../test.h"
+
+using namespace std::chrono;
+
+SCENARIO("deadline_timer - moved later", "[deadline_timer][schedulers]"){
+    GIVEN("a timer on a test worker"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+
+        std::vector<long> fired;
+        auto timer = rxsc::make_deadline_timer(w, [&](const rxsc::schedulable&){
+            fired.push_back(w.clock());
+        });
+
+        WHEN("the deadline is moved later before it expires"){
+
+            w.schedule_absolute(100, [&](const rxsc::schedulable&){
+                timer.arm(sc.to_time_point(300));
+            });
+            w.schedule_absolute(200, [&](const rxsc::schedulable&){
+                timer.arm(sc.to_time_point(400));
+            });
+            w.schedule_absolute(350, [&](const rxsc::schedulable&){
+                timer.arm(sc.to_time_point(500));
+            });
+            w.start();
+
+            THEN("the function is called once at the last deadline"){
+                auto required = rxu::to_vector({500L});
+                REQUIRE(required == fired);
+                REQUIRE(!timer.is_armed());
+            }
+        }
+    }
+}
+
+SCENARIO("deadline_timer - moved earlier", "[deadline_timer][schedulers]"){
+    GIVEN("a timer on a test worker"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+
+        std::vector<long> fired;
+        auto timer = rxsc::make_deadline_timer(w, [&](const rxsc::schedulable&){
+            fired.push_back(w.clock());
+        });
+
+        WHEN("the deadline is moved earlier before it expires"){
+
+            w.schedule_absolute(100, [&](const rxsc::schedulable&){
+                timer.arm(sc.to_time_point(500));
+            });
+            w.schedule_absolute(200, [&](const rxsc::schedulable&){
+                timer.arm(sc.to_time_point(300));
+            });
+            w.start();
+
+            THEN("the function is called once at the earlier deadline"){
+                auto required = rxu::to_vector({300L});
+                REQUIRE(required == fired);
+            }
+        }
+    }
+}
+
+SCENARIO("deadline_timer - rearmed after firing", "[deadline_timer][schedulers]"){
+    GIVEN("a timer on a test worker"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+
+        std::vector<long> fired;
+        auto timer = rxsc::make_deadline_timer(w, [&](const rxsc::schedulable&){
+            fired.push_back(w.clock());
+        });
+
+        WHEN("the timer is armed, fires and is armed again"){
+
+            w.schedule_absolute(100, [&](const rxsc::schedulable&){
+                timer.arm(milliseconds(100));
+            });
+            w.schedule_absolute(250, [&](const rxsc::schedulable&){
+                timer.arm(milliseconds(100));
+            });
+            w.start();
+
+            THEN("the function is called for each deadline"){
+                auto required = rxu::to_vector({200L, 350L});
+                REQUIRE(required == fired);
+            }
+        }
+    }
+}
+
+SCENARIO("deadline_timer - cancel", "[deadline_timer][schedulers]"){
+    GIVEN("a timer on a test worker"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+
+        std::vector<long> fired;
+        auto timer = rxsc::make_deadline_timer(w, [&](const rxsc::schedulable&){
+            fired.push_back(w.clock());
+        });
+
+        WHEN("the timer is cancelled before the deadline"){
+
+            w.schedule_absolute(100, [&](const rxsc::schedulable&){
+                timer.arm(sc.to_time_point(300));
+            });
+            w.schedule_absolute(200, [&](const rxsc::schedulable&){
+                timer.cancel();
+            });
+            w.start();
+
+            THEN("the function is not called"){
+                REQUIRE(fired.empty());
+                REQUIRE(!timer.is_armed());
+            }
+        }
+    }
+}
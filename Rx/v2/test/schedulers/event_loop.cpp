@@ -0,0 +1,253 @@
+#include "../test.h"
+
+#include <future>
+
+using namespace std::chrono;
+
+namespace {
+std::size_t total_workers(const std::vector<rxsc::event_loop::loop_load>& load) {
+    std::size_t result = 0;
+    for (auto& l : load) {
+        result += l.workers;
+    }
+    return result;
+}
+std::size_t total_actions(const std::vector<rxsc::event_loop::loop_load>& load) {
+    std::size_t result = 0;
+    for (auto& l : load) {
+        result += l.actions;
+    }
+    return result;
+}
+// the loop that a worker was placed on
+std::size_t placed_on(const std::vector<rxsc::event_loop::loop_load>& before, const std::vector<rxsc::event_loop::loop_load>& after) {
+    for (std::size_t i = 0; i < before.size(); ++i) {
+        if (after[i].workers > before[i].workers) {
+            return i;
+        }
+    }
+    return before.size();
+}
+}
+
+SCENARIO("event_loop - load is tracked per loop", "[event_loop][schedulers]"){
+    GIVEN("an event_loop"){
+        auto el = std::make_shared<rxsc::event_loop>();
+        auto sc = rxsc::make_scheduler(el);
+
+        WHEN("a worker runs some actions"){
+            const int count = 100;
+            std::promise<void> ran;
+            auto done = ran.get_future();
+            {
+                auto w = sc.create_worker();
+                REQUIRE(total_workers(el->get_load()) == 1);
+                for (int i = 1; i <= count; ++i) {
+                    w.schedule([&, i](const rxsc::schedulable&){
+                        if (i == count) {
+                            ran.set_value();
+                        }
+                    });
+                }
+                done.wait();
+                w.unsubscribe();
+            }
+
+            THEN("the actions are counted and nothing is left queued"){
+                // the last action is counted when it returns
+                auto load = el->get_load();
+                for (int i = 0; i < 1000 && total_actions(load) != count; ++i) {
+                    std::this_thread::sleep_for(milliseconds(1));
+                    load = el->get_load();
+                }
+                REQUIRE(total_actions(load) == count);
+                for (auto& l : load) {
+                    REQUIRE(l.queued == 0);
+                }
+                REQUIRE(total_workers(load) == 0);
+            }
+        }
+    }
+}
+
+SCENARIO("event_loop - new workers avoid a busy loop", "[event_loop][schedulers]"){
+    GIVEN("an event_loop with one blocked loop"){
+        auto el = std::make_shared<rxsc::event_loop>();
+        auto sc = rxsc::make_scheduler(el);
+
+        auto before = el->get_load();
+        auto blocked = sc.create_worker();
+        auto busy = placed_on(before, el->get_load());
+        REQUIRE(busy < before.size());
+
+        std::promise<void> release;
+        auto wait = release.get_future().share();
+        blocked.schedule([wait](const rxsc::schedulable&){
+            wait.wait();
+        });
+        for (int i = 0; i < 20; ++i) {
+            blocked.schedule([](const rxsc::schedulable&){});
+        }
+
+        WHEN("more workers are created"){
+            std::vector<rxsc::worker> workers;
+            for (std::size_t i = 0; i < 2 * before.size(); ++i) {
+                workers.push_back(sc.create_worker());
+            }
+            auto load = el->get_load();
+            release.set_value();
+
+            THEN("none of them are placed on the blocked loop"){
+                REQUIRE(load[busy].workers == 1);
+                REQUIRE(load[busy].queued == 21);
+                REQUIRE(total_workers(load) == 2 * before.size() + 1);
+            }
+            for (auto& w : workers) {
+                w.unsubscribe();
+            }
+        }
+        blocked.unsubscribe();
+    }
+}
+
+SCENARIO("event_loop - rebalance moves an idle worker", "[event_loop][schedulers]"){
+    GIVEN("an event_loop that rebalances and two workers on the same loop"){
+        auto el = std::make_shared<rxsc::event_loop>(
+            [](std::function<void()> start){
+                return std::thread(std::move(start));
+            },
+            true);
+        auto sc = rxsc::make_scheduler(el);
+
+        auto before = el->get_load();
+        auto idle = sc.create_worker();
+        auto shared = placed_on(before, el->get_load());
+        REQUIRE(shared < before.size());
+
+        std::vector<rxsc::worker> others;
+        std::unique_ptr<rxsc::worker> blocked;
+        for (int i = 0; i < 1000 && !blocked; ++i) {
+            auto previous = el->get_load();
+            auto w = sc.create_worker();
+            if (placed_on(previous, el->get_load()) == shared) {
+                blocked.reset(new rxsc::worker(w));
+            } else {
+                others.push_back(w);
+            }
+        }
+        REQUIRE(!!blocked);
+
+        std::promise<void> release;
+        auto wait = release.get_future().share();
+        blocked->schedule([wait](const rxsc::schedulable&){
+            wait.wait();
+        });
+        for (int i = 0; i < 20; ++i) {
+            blocked->schedule([](const rxsc::schedulable&){});
+        }
+
+        WHEN("the idle worker schedules while its loop is blocked"){
+            std::promise<void> ran;
+            auto done = ran.get_future();
+            idle.schedule([&](const rxsc::schedulable&){
+                ran.set_value();
+            });
+            auto status = done.wait_for(seconds(5));
+            auto load = el->get_load();
+            release.set_value();
+
+            THEN("the action runs on another loop"){
+                REQUIRE(status == std::future_status::ready);
+                REQUIRE(load[shared].workers == 1);
+            }
+        }
+        for (auto& w : others) {
+            w.unsubscribe();
+        }
+        blocked->unsubscribe();
+        idle.unsubscribe();
+    }
+}
+
+SCENARIO("event_loop - busy time is only sampled on request", "[event_loop][schedulers]"){
+    auto run_sleep = [](std::shared_ptr<rxsc::event_loop> el){
+        auto sc = rxsc::make_scheduler(el);
+        auto w = sc.create_worker();
+        std::promise<void> ran;
+        auto done = ran.get_future();
+        w.schedule([&](const rxsc::schedulable&){
+            std::this_thread::sleep_for(milliseconds(10));
+        });
+        w.schedule([&](const rxsc::schedulable&){
+            ran.set_value();
+        });
+        done.wait();
+        w.unsubscribe();
+        auto load = el->get_load();
+        for (int i = 0; i < 1000 && total_actions(load) != 2; ++i) {
+            std::this_thread::sleep_for(milliseconds(1));
+            load = el->get_load();
+        }
+        REQUIRE(total_actions(load) == 2);
+        rxsc::scheduler_base::clock_type::duration busy(0);
+        for (auto& l : load) {
+            busy += l.busy;
+        }
+        return busy;
+    };
+    GIVEN("an event_loop"){
+        WHEN("an action sleeps"){
+            auto busy = run_sleep(std::make_shared<rxsc::event_loop>());
+            THEN("no busy time is reported"){
+                REQUIRE(busy.count() == 0);
+            }
+        }
+    }
+    GIVEN("an event_loop that samples busy time"){
+        WHEN("an action sleeps"){
+            auto busy = run_sleep(std::make_shared<rxsc::event_loop>(
+                [](std::function<void()> start){
+                    return std::thread(std::move(start));
+                },
+                false,
+                true));
+            THEN("the time is reported"){
+                REQUIRE(busy >= milliseconds(10));
+            }
+        }
+    }
+}
+
+SCENARIO("event_loop - schedule", "[!hide][event_loop][schedulers][perf]"){
+    const int count = 100000;
+    GIVEN("an event_loop worker"){
+        WHEN("100 thousand actions are scheduled"){
+            typedef steady_clock clock;
+
+            auto el = std::make_shared<rxsc::event_loop>();
+            auto sc = rxsc::make_scheduler(el);
+            auto w = sc.create_worker();
+
+            std::promise<void> ran;
+            auto done = ran.get_future();
+            int runs = 0;
+            auto start = clock::now();
+            for (int i = 1; i <= count; ++i) {
+                w.schedule([&](const rxsc::schedulable&){
+                    if (++runs == count) {
+                        ran.set_value();
+                    }
+                });
+            }
+            done.wait();
+            auto finish = clock::now();
+            auto msElapsed = duration_cast<milliseconds>(finish-start);
+            std::cout << "event_loop          : " << runs << " scheduled, " << msElapsed.count() << "ms elapsed " << runs / (msElapsed.count() / 1000.0) << " ops/sec" << std::endl;
+            w.unsubscribe();
+
+            THEN("every action is run"){
+                REQUIRE(runs == count);
+            }
+        }
+    }
+}
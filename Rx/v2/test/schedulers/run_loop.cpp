@@ -0,0 +1,134 @@
+#include "../test.h"
+
+#if defined(RXCPP_ON_LINUX)
+#include <sys/epoll.h>
+#endif
+
+using namespace std::chrono;
+
+SCENARIO("run_loop - dispatch in batches", "[run_loop][schedulers]"){
+    GIVEN("a run_loop with items that are due and an item that is not"){
+        rxsc::run_loop rl;
+        auto w = rl.get_scheduler().create_worker();
+
+        std::vector<int> ran;
+        for (int i = 0; i < 5; ++i) {
+            w.schedule([&, i](const rxsc::schedulable&){
+                ran.push_back(i);
+            });
+        }
+        auto later = rl.now() + hours(1);
+        w.schedule(later, [&](const rxsc::schedulable&){
+            ran.push_back(-1);
+        });
+
+        WHEN("dispatch_n and then dispatch_all are called"){
+
+            auto first = rl.dispatch_n(2);
+            auto rest = rl.dispatch_all();
+
+            THEN("the due items are run in order and the later item is left"){
+                REQUIRE(first == 2);
+                REQUIRE(rest == 3);
+                auto required = rxu::to_vector({0, 1, 2, 3, 4});
+                REQUIRE(required == ran);
+                REQUIRE(!rl.empty());
+                REQUIRE(rl.next_due() == later);
+            }
+        }
+    }
+}
+
+SCENARIO("run_loop - dispatch_all runs items that are scheduled while it runs", "[run_loop][schedulers]"){
+    GIVEN("a run_loop with an item that schedules another"){
+        rxsc::run_loop rl;
+        auto w = rl.get_scheduler().create_worker();
+
+        std::vector<int> ran;
+        w.schedule([&](const rxsc::schedulable&){
+            ran.push_back(1);
+            w.schedule([&](const rxsc::schedulable&){
+                ran.push_back(2);
+            });
+        });
+
+        WHEN("dispatch_all is called"){
+
+            auto count = rl.dispatch_all();
+
+            THEN("both items are run and the queue is empty"){
+                REQUIRE(count == 2);
+                auto required = rxu::to_vector({1, 2});
+                REQUIRE(required == ran);
+                REQUIRE(rl.empty());
+                REQUIRE(rl.next_due() == rxsc::run_loop::clock_type::time_point::max());
+            }
+        }
+    }
+}
+
+#if defined(RXCPP_ON_LINUX)
+SCENARIO("run_loop_fd - wakes an epoll reactor", "[run_loop][schedulers]"){
+    GIVEN("a run_loop connected to epoll"){
+        rxsc::run_loop rl;
+        rxsc::run_loop_fd fds(rl);
+        auto w = rl.get_scheduler().create_worker();
+
+        int reactor = epoll_create1(EPOLL_CLOEXEC);
+        REQUIRE(reactor >= 0);
+        for (auto fd : {fds.wake_fd(), fds.timer_fd()}) {
+            epoll_event ev = {};
+            ev.events = EPOLLIN;
+            ev.data.fd = fd;
+            REQUIRE(epoll_ctl(reactor, EPOLL_CTL_ADD, fd, &ev) == 0);
+        }
+        auto wait = [&](int timeout) {
+            epoll_event ev = {};
+            return epoll_wait(reactor, &ev, 1, timeout) == 1 ? ev.data.fd : -1;
+        };
+
+        WHEN("nothing is scheduled"){
+            THEN("the reactor is not woken"){
+                REQUIRE(wait(20) == -1);
+            }
+        }
+
+        WHEN("an item is scheduled from another thread"){
+            int ran = 0;
+            std::thread([&](){
+                w.schedule([&](const rxsc::schedulable&){
+                    ++ran;
+                });
+            }).join();
+
+            THEN("the wake descriptor is readable and dispatch runs the item"){
+                REQUIRE(wait(1000) == fds.wake_fd());
+                REQUIRE(fds.dispatch() == 1);
+                REQUIRE(ran == 1);
+                REQUIRE(wait(20) == -1);
+            }
+        }
+
+        WHEN("an item is scheduled for later"){
+            int ran = 0;
+            auto start = rl.now();
+            w.schedule(start + milliseconds(30), [&](const rxsc::schedulable&){
+                ++ran;
+            });
+            // arm the timer for the new item
+            REQUIRE(wait(1000) == fds.wake_fd());
+            REQUIRE(fds.dispatch() == 0);
+
+            THEN("the timer descriptor is readable when the item is due"){
+                REQUIRE(wait(1000) == fds.timer_fd());
+                REQUIRE(rl.now() >= start + milliseconds(30));
+                REQUIRE(fds.dispatch() == 1);
+                REQUIRE(ran == 1);
+                REQUIRE(wait(20) == -1);
+            }
+        }
+
+        ::close(reactor);
+    }
+}
+#endif
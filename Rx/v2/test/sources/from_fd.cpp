@@ -0,0 +1,191 @@
+#include "../test.h"
+
+#if defined(RXCPP_ON_LINUX)
+
+#include "rxcpp/operators/rx-map.hpp"
+#include "rxcpp/operators/rx-merge.hpp"
+#include "rxcpp/operators/rx-reduce.hpp"
+#include "rxcpp/operators/rx-take.hpp"
+
+#include <sys/socket.h>
+
+namespace {
+
+std::string to_string(const rxu::pooled_buffer<std::uint8_t>& b) {
+    return std::string(b.begin(), b.end());
+}
+
+void write_all(int fd, const std::string& s) {
+    auto written = ::write(fd, s.data(), s.size());
+    REQUIRE(written == static_cast<ssize_t>(s.size()));
+}
+
+}
+
+SCENARIO("from_fd reads a pipe until it is closed", "[from_fd][sources]"){
+    GIVEN("a pipe and a reactor"){
+        auto reactor = rxsc::make_epoll_reactor();
+        int fds[2] = {};
+        REQUIRE(::pipe(fds) == 0);
+
+        WHEN("the bytes are written and the pipe is closed"){
+            std::thread writer([&](){
+                write_all(fds[1], "hello");
+                write_all(fds[1], "world");
+                ::close(fds[1]);
+            });
+
+            std::vector<std::size_t> sizes;
+            std::string text;
+            bool completed = false;
+            rxs::from_fd(fds[0], 4, reactor)
+                .as_blocking()
+                .subscribe(
+                    [&](const rxu::pooled_buffer<std::uint8_t>& b){
+                        sizes.push_back(b.size());
+                        text += to_string(b);
+                    },
+                    [&](){completed = true;});
+            writer.join();
+
+            THEN("all the bytes were emitted in order"){
+                REQUIRE(text == "helloworld");
+            }
+            THEN("no buffer was larger than the buffer size"){
+                for (auto s : sizes) {
+                    REQUIRE(s <= 4);
+                }
+            }
+            THEN("the observable completed"){
+                REQUIRE(completed);
+            }
+        }
+        ::close(fds[0]);
+    }
+}
+
+SCENARIO("from_fd removes the descriptor from the reactor when unsubscribed", "[from_fd][sources]"){
+    GIVEN("a socketpair and a reactor"){
+        auto reactor = rxsc::make_epoll_reactor();
+        int sv[2] = {};
+        REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0);
+
+        auto read_one = [&](){
+            return rxs::from_fd(sv[0], 16, reactor)
+                .map([](const rxu::pooled_buffer<std::uint8_t>& b){return to_string(b);})
+                .take(1)
+                .as_blocking()
+                .first();
+        };
+
+        WHEN("the same descriptor is subscribed again after take(1)"){
+            write_all(sv[1], "first");
+            auto first = read_one();
+            write_all(sv[1], "second");
+            auto second = read_one();
+
+            THEN("both subscriptions read their bytes"){
+                REQUIRE(first == "first");
+                REQUIRE(second == "second");
+            }
+        }
+        ::close(sv[0]);
+        ::close(sv[1]);
+    }
+}
+
+SCENARIO("from_fd watches many descriptors on one reactor", "[from_fd][sources]"){
+    GIVEN("256 socketpairs and a reactor"){
+        const int count = 256;
+        auto reactor = rxsc::make_epoll_reactor();
+        std::vector<std::array<int, 2>> pairs(count);
+        for (auto& p : pairs) {
+            REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, p.data()) == 0);
+        }
+
+        WHEN("each pair is written and closed"){
+            std::vector<rx::observable<std::size_t>> sources;
+            for (auto& p : pairs) {
+                sources.push_back(
+                    rxs::from_fd(p[0], 64, reactor)
+                        .map([](const rxu::pooled_buffer<std::uint8_t>& b){return b.size();})
+                        .as_dynamic());
+            }
+            std::thread writer([&](){
+                for (auto& p : pairs) {
+                    write_all(p[1], "0123456789");
+                    ::shutdown(p[1], SHUT_WR);
+                }
+            });
+            // subscribe on the reactor thread so that merge sees one thread
+            auto total = rxs::iterate(sources, rx::identity_same_worker(reactor.get_scheduler().create_worker()))
+                .merge()
+                .sum()
+                .as_blocking()
+                .last();
+            writer.join();
+
+            THEN("the bytes of every descriptor were emitted"){
+                REQUIRE(total == std::size_t(10 * count));
+            }
+        }
+        for (auto& p : pairs) {
+            ::close(p[0]);
+            ::close(p[1]);
+        }
+    }
+}
+
+SCENARIO("from_fd socketpair throughput", "[!hide][from_fd][sources][perf]"){
+    const int static pairCount = 1000;
+    const int static bufferCount = 1000;
+    GIVEN("1000 socketpairs on one reactor"){
+        WHEN("each pair carries 1000 buffers"){
+            using namespace std::chrono;
+            typedef steady_clock clock;
+
+            auto reactor = rxsc::make_epoll_reactor();
+            std::vector<std::array<int, 2>> pairs(pairCount);
+            for (auto& p : pairs) {
+                REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, p.data()) == 0);
+            }
+            std::vector<rx::observable<std::size_t>> sources;
+            for (auto& p : pairs) {
+                sources.push_back(
+                    rxs::from_fd(p[0], 4096, reactor)
+                        .map([](const rxu::pooled_buffer<std::uint8_t>& b){return b.size();})
+                        .as_dynamic());
+            }
+
+            auto start = clock::now();
+            std::thread writer([&](){
+                std::string block(64, 'x');
+                for (int i = 0; i != bufferCount; ++i) {
+                    for (auto& p : pairs) {
+                        write_all(p[1], block);
+                    }
+                }
+                for (auto& p : pairs) {
+                    ::shutdown(p[1], SHUT_WR);
+                }
+            });
+            // subscribe on the reactor thread so that merge sees one thread
+            auto total = rxs::iterate(sources, rx::identity_same_worker(reactor.get_scheduler().create_worker()))
+                .merge()
+                .sum()
+                .as_blocking()
+                .last();
+            writer.join();
+            auto finish = clock::now();
+            auto msElapsed = duration_cast<milliseconds>(finish-start);
+            std::cout << "from_fd socketpairs : " << pairCount << " descriptors, " << total << " bytes, " << msElapsed.count() << "ms elapsed " << std::endl;
+
+            for (auto& p : pairs) {
+                ::close(p[0]);
+                ::close(p[1]);
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,137 @@
+#include "../test.h"
+
+#if defined(RXCPP_ON_LINUX)
+
+#include "rxcpp/operators/rx-map.hpp"
+#include "rxcpp/operators/rx-reduce.hpp"
+#include "rxcpp/operators/rx-split_lines.hpp"
+
+#include <cstdio>
+
+namespace {
+
+// a file that is removed when the test ends
+struct temp_file
+{
+    explicit temp_file(const std::string& content)
+    {
+        char name[] = "/tmp/rxcpp-mmap_file-XXXXXX";
+        int fd = ::mkstemp(name);
+        REQUIRE(fd >= 0);
+        path = name;
+        auto written = ::write(fd, content.data(), content.size());
+        REQUIRE(written == static_cast<ssize_t>(content.size()));
+        ::close(fd);
+    }
+    ~temp_file()
+    {
+        std::remove(path.c_str());
+    }
+    std::string path;
+};
+
+}
+
+SCENARIO("mmap_file emits the file in chunks", "[mmap_file][sources]"){
+    GIVEN("a file with 3 lines"){
+        temp_file file("first line\nsecond line\r\nthird");
+
+        WHEN("the file is read in chunks of 7 bytes"){
+            std::vector<std::string> chunks;
+            const char* previous = nullptr;
+            bool adjacent = true;
+            bool completed = false;
+            rxs::mmap_file(file.path, 7)
+                .subscribe(
+                    [&](const rxu::shared_view& c){
+                        adjacent = adjacent && (!previous || previous == c.data());
+                        previous = c.end();
+                        chunks.push_back(c.str());
+                    },
+                    [&](){completed = true;});
+
+            THEN("the chunks cover the file"){
+                REQUIRE(chunks.size() == 5);
+                REQUIRE(chunks[0] == "first l");
+                REQUIRE(chunks[4] == "d");
+                REQUIRE(adjacent);
+                REQUIRE(completed);
+            }
+        }
+        WHEN("the file is split into lines"){
+            std::vector<std::string> lines;
+            rxs::mmap_file(file.path, 7)
+                .split_lines()
+                .subscribe([&](const rxu::shared_view& l){lines.push_back(l.str());});
+
+            THEN("each line was emitted"){
+                REQUIRE(lines == std::vector<std::string>({"first line", "second line", "third"}));
+            }
+        }
+    }
+    GIVEN("an empty file"){
+        temp_file file("");
+
+        WHEN("the file is read"){
+            int count = 0;
+            bool completed = false;
+            rxs::mmap_file(file.path)
+                .subscribe(
+                    [&](const rxu::shared_view&){++count;},
+                    [&](){completed = true;});
+
+            THEN("the observable completes without values"){
+                REQUIRE(count == 0);
+                REQUIRE(completed);
+            }
+        }
+    }
+    GIVEN("a path that does not exist"){
+        WHEN("the file is read"){
+            int error = 0;
+            rxs::mmap_file("/tmp/rxcpp-mmap_file-missing")
+                .subscribe(
+                    [&](const rxu::shared_view&){},
+                    [&](rxu::error_ptr ep){
+                        RXCPP_TRY {
+                            rxu::rethrow_exception(ep);
+                        } RXCPP_CATCH(const std::system_error& e) {
+                            error = e.code().value();
+                        }
+                    });
+
+            THEN("the error is reported"){
+                REQUIRE(error == ENOENT);
+            }
+        }
+    }
+}
+
+SCENARIO("mmap_file split_lines", "[!hide][mmap_file][sources][perf]"){
+    const int static linecount = 1000000;
+    GIVEN("a file with 1000000 lines"){
+        std::string content;
+        for (int i = 0; i != linecount; ++i) {
+            content += "2024-01-01T00:00:00Z INFO request " + std::to_string(i) + " completed\n";
+        }
+        temp_file file(content);
+
+        WHEN("the lines are counted"){
+            using namespace std::chrono;
+            typedef steady_clock clock;
+
+            auto start = clock::now();
+            auto lines = rxs::mmap_file(file.path)
+                .split_lines()
+                .count()
+                .as_blocking()
+                .last();
+            auto finish = clock::now();
+            auto msElapsed = duration_cast<milliseconds>(finish-start);
+            std::cout << "mmap_file split_lines : " << content.size() << " bytes, " << lines << " lines, " << msElapsed.count() << "ms elapsed " << std::endl;
+            REQUIRE(lines == linecount);
+        }
+    }
+}
+
+#endif
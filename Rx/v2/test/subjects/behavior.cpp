@@ -0,0 +1,131 @@
+#include "../test.h"
+
+#include <future>
+
+namespace {
+// the two halves must always be read together
+struct price
+{
+    long bid;
+    long ask;
+};
+}
+
+SCENARIO("behavior - get_value", "[behavior][subjects]"){
+    GIVEN("behavior subjects of a small and a large value"){
+        rxsub::behavior<int> small(1);
+        rxsub::behavior<std::string> large("first");
+
+        WHEN("values are pushed"){
+            std::vector<int> smallValues;
+            std::vector<std::string> largeValues;
+            small.get_observable().subscribe([&](int v){smallValues.push_back(v);});
+            large.get_observable().subscribe([&](const std::string& v){largeValues.push_back(v);});
+
+            small.get_subscriber().on_next(2);
+            large.get_subscriber().on_next(std::string("second"));
+
+            THEN("get_value and get_snapshot return the latest value"){
+                REQUIRE(small.get_value() == 2);
+                REQUIRE(*small.get_snapshot() == 2);
+                REQUIRE(large.get_value() == "second");
+                REQUIRE(*large.get_snapshot() == "second");
+            }
+            THEN("the subscribers saw the initial and the latest value"){
+                REQUIRE(smallValues == std::vector<int>({1, 2}));
+                REQUIRE(largeValues == std::vector<std::string>({"first", "second"}));
+            }
+        }
+        WHEN("a snapshot is taken before a push"){
+            auto before = large.get_snapshot();
+            large.get_subscriber().on_next(std::string("second"));
+
+            THEN("the snapshot is unchanged"){
+                REQUIRE(*before == "first");
+                REQUIRE(*large.get_snapshot() == "second");
+            }
+        }
+    }
+}
+
+SCENARIO("behavior - concurrent readers", "[behavior][subjects]"){
+    GIVEN("a behavior subject of a two word value"){
+        const int readers = 4;
+        const long count = 100000;
+
+        rxsub::behavior<price> sub(price{0, 0});
+
+        WHEN("one thread writes while others read"){
+            std::atomic<bool> writing{true};
+            std::vector<std::future<bool>> f;
+            for (int r = 0; r < readers; ++r) {
+                f.push_back(std::async(std::launch::async, [sub, &writing](){
+                    bool consistent = true;
+                    long last = 0;
+                    while (writing) {
+                        auto p = sub.get_value();
+                        consistent = consistent && p.ask == -p.bid && p.bid >= last;
+                        last = p.bid;
+                    }
+                    return consistent;
+                }));
+            }
+            auto o = sub.get_subscriber();
+            for (long i = 1; i <= count; ++i) {
+                o.on_next(price{i, -i});
+            }
+            writing = false;
+
+            THEN("readers never see a torn value"){
+                for (auto& r : f) {
+                    REQUIRE(r.get());
+                }
+                REQUIRE(sub.get_value().bid == count);
+            }
+        }
+    }
+}
+
+SCENARIO("behavior - readers of a small value", "[!hide][behavior][subjects][perf]"){
+    const int readers = 8;
+    const long count = 1000000;
+    GIVEN("a behavior subject of a two word value"){
+        WHEN("8 threads poll get_value while 1 million values are pushed"){
+            using namespace std::chrono;
+            typedef steady_clock clock;
+
+            rxsub::behavior<price> sub(price{0, 0});
+
+            std::atomic<bool> writing{true};
+            std::vector<std::future<long>> f;
+            for (int r = 0; r < readers; ++r) {
+                f.push_back(std::async(std::launch::async, [sub, &writing](){
+                    long reads = 0;
+                    while (writing) {
+                        reads += sub.get_value().bid >= 0 ? 1 : 0;
+                    }
+                    return reads;
+                }));
+            }
+
+            auto o = sub.get_subscriber();
+            auto start = clock::now();
+            for (long i = 1; i <= count; ++i) {
+                o.on_next(price{i, -i});
+            }
+            auto finish = clock::now();
+            writing = false;
+
+            long reads = 0;
+            for (auto& r : f) {
+                reads += r.get();
+            }
+            auto msElapsed = duration_cast<milliseconds>(finish-start);
+            std::cout << "behavior get_value  : " << readers << " readers, " << reads << " reads, " << count << " on_next calls, " << msElapsed.count() << "ms elapsed " << count / (msElapsed.count() / 1000.0) << " ops/sec" << std::endl;
+
+            THEN("the last value is visible"){
+                REQUIRE(sub.get_value().bid == count);
+            }
+        }
+    }
+}
@@ -0,0 +1,137 @@
+#include "../test.h"
+
+#include <future>
+
+SCENARIO("synchronize - ordered notifications", "[synchronize][subjects]"){
+    GIVEN("a synchronize subject on a new thread"){
+        rxsub::synchronize<int, rx::synchronize_in_one_worker> sub(rx::synchronize_new_thread());
+
+        std::vector<int> values;
+        std::promise<void> completed;
+        auto done = completed.get_future();
+        sub.get_observable().subscribe(
+            [&values](int v){
+                values.push_back(v);
+            },
+            [](rxu::error_ptr){abort();},
+            [&completed](){
+                completed.set_value();
+            });
+
+        WHEN("values are pushed from one thread"){
+            auto o = sub.get_subscriber();
+            for (int i = 0; i < 1000; ++i) {
+                o.on_next(i);
+            }
+            o.on_completed();
+            done.wait();
+
+            THEN("the values are delivered in order"){
+                REQUIRE(values.size() == 1000);
+                for (int i = 0; i < 1000; ++i) {
+                    REQUIRE(values[i] == i);
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("synchronize - concurrent producers", "[synchronize][subjects]"){
+    GIVEN("a synchronize subject on a new thread"){
+        const int producers = 4;
+        const int count = 10000;
+
+        rxsub::synchronize<int, rx::synchronize_in_one_worker> sub(rx::synchronize_new_thread());
+
+        std::atomic<int> inside{0};
+        bool overlapped = false;
+        long long sum = 0;
+        int received = 0;
+        std::promise<void> completed;
+        auto done = completed.get_future();
+        sub.get_observable().subscribe(
+            [&](int v){
+                if (++inside != 1) {
+                    overlapped = true;
+                }
+                sum += v;
+                ++received;
+                --inside;
+            },
+            [](rxu::error_ptr){abort();},
+            [&completed](){
+                completed.set_value();
+            });
+
+        WHEN("values are pushed from several threads"){
+            auto o = sub.get_subscriber();
+            std::vector<std::future<void>> f;
+            for (int p = 0; p < producers; ++p) {
+                f.push_back(std::async(std::launch::async, [o, count](){
+                    for (int i = 1; i <= count; ++i) {
+                        o.on_next(i);
+                    }
+                }));
+            }
+            for (auto& p : f) {
+                p.get();
+            }
+            o.on_completed();
+            done.wait();
+
+            THEN("every value is delivered once and calls do not overlap"){
+                REQUIRE(!overlapped);
+                REQUIRE(received == producers * count);
+                REQUIRE(sum == producers * (static_cast<long long>(count) * (count + 1) / 2));
+            }
+        }
+    }
+}
+
+SCENARIO("synchronize - many producers", "[!hide][synchronize][subjects][perf]"){
+    const int producers = 16;
+    const int count = 1000000;
+    GIVEN("a synchronize subject on a new thread"){
+        WHEN("16 threads push 1 million ints each"){
+            using namespace std::chrono;
+            typedef steady_clock clock;
+
+            rxsub::synchronize<int, rx::synchronize_in_one_worker> sub(rx::synchronize_new_thread());
+
+            int received = 0;
+            std::promise<void> completed;
+            auto done = completed.get_future();
+            sub.get_observable().subscribe(
+                [&received](int){
+                    ++received;
+                },
+                [](rxu::error_ptr){abort();},
+                [&completed](){
+                    completed.set_value();
+                });
+
+            auto o = sub.get_subscriber();
+            auto start = clock::now();
+            std::vector<std::future<void>> f;
+            for (int p = 0; p < producers; ++p) {
+                f.push_back(std::async(std::launch::async, [o, count](){
+                    for (int i = 0; i < count; ++i) {
+                        o.on_next(i);
+                    }
+                }));
+            }
+            for (auto& p : f) {
+                p.get();
+            }
+            o.on_completed();
+            done.wait();
+            auto finish = clock::now();
+            auto msElapsed = duration_cast<milliseconds>(finish-start);
+            std::cout << "synchronize         : " << producers << " producers, " << received << " on_next calls, " << msElapsed.count() << "ms elapsed " << received / (msElapsed.count() / 1000.0) << " ops/sec" << std::endl;
+
+            THEN("every value is delivered"){
+                REQUIRE(received == producers * count);
+            }
+        }
+    }
+}
@@ -0,0 +1,316 @@
+#include "../test.h"
+
+#include <rxcpp/operators/rx-merge.hpp>
+#include <rxcpp/operators/rx-window.hpp>
+
+const int static_onnextcalls = 1000000;
+
+SCENARIO("subject and unicast per window", "[!hide][unicast][subject][subjects][perf]"){
+    const int& onnextcalls = static_onnextcalls;
+    GIVEN("a window that is subscribed once"){
+        WHEN("creating, subscribing and completing 1 million subjects"){
+            using namespace std::chrono;
+            typedef steady_clock clock;
+
+            int c = 0;
+            auto start = clock::now();
+            for (int i = 0; i < onnextcalls; i++) {
+                rxsub::subject<int> s;
+                s.get_observable().subscribe([&c](int){++c;});
+                auto o = s.get_subscriber();
+                o.on_next(i);
+                o.on_completed();
+            }
+            auto finish = clock::now();
+            auto msElapsed = duration_cast<milliseconds>(finish-start);
+            std::cout << "subject per window  : " << c << " windows, " << msElapsed.count() << "ms elapsed " << c / (msElapsed.count() / 1000.0) << " ops/sec" << std::endl;
+        }
+        WHEN("creating, subscribing and completing 1 million unicasts"){
+            using namespace std::chrono;
+            typedef steady_clock clock;
+
+            int c = 0;
+            auto start = clock::now();
+            for (int i = 0; i < onnextcalls; i++) {
+                rxsub::unicast<int> s;
+                s.get_observable().subscribe([&c](int){++c;});
+                auto o = s.get_subscriber();
+                o.on_next(i);
+                o.on_completed();
+            }
+            auto finish = clock::now();
+            auto msElapsed = duration_cast<milliseconds>(finish-start);
+            std::cout << "unicast per window  : " << c << " windows, " << msElapsed.count() << "ms elapsed " << c / (msElapsed.count() / 1000.0) << " ops/sec" << std::endl;
+        }
+    }
+}
+
+SCENARIO("subject and unicast per item", "[!hide][unicast][subject][subjects][perf]"){
+    const int& onnextcalls = static_onnextcalls;
+    GIVEN("a window that is subscribed once"){
+        WHEN("calling on_next 1 million times on a subject"){
+            using namespace std::chrono;
+            typedef steady_clock clock;
+
+            int c = 0;
+            rxsub::subject<int> s;
+            s.get_observable().subscribe([&c](int){++c;});
+            auto start = clock::now();
+            for (int i = 0; i < onnextcalls; i++) {
+                s.get_subscriber().on_next(i);
+            }
+            auto finish = clock::now();
+            auto msElapsed = duration_cast<milliseconds>(finish-start);
+            std::cout << "subject per item    : " << c << " on_next calls, " << msElapsed.count() << "ms elapsed " << c / (msElapsed.count() / 1000.0) << " ops/sec" << std::endl;
+        }
+        WHEN("calling on_next 1 million times on a unicast"){
+            using namespace std::chrono;
+            typedef steady_clock clock;
+
+            int c = 0;
+            rxsub::unicast<int> s;
+            s.get_observable().subscribe([&c](int){++c;});
+            auto o = s.get_subscriber();
+            auto start = clock::now();
+            for (int i = 0; i < onnextcalls; i++) {
+                o.on_next(i);
+            }
+            auto finish = clock::now();
+            auto msElapsed = duration_cast<milliseconds>(finish-start);
+            std::cout << "unicast per item    : " << c << " on_next calls, " << msElapsed.count() << "ms elapsed " << c / (msElapsed.count() / 1000.0) << " ops/sec" << std::endl;
+        }
+    }
+}
+
+SCENARIO("range window", "[!hide][range][window][unicast][subjects][perf]"){
+    const int& onnextcalls = static_onnextcalls;
+    GIVEN("a range"){
+        WHEN("each item is sent to 10 overlapping windows"){
+            using namespace std::chrono;
+            typedef steady_clock clock;
+
+            int c = 0;
+            auto start = clock::now();
+            rxs::range<int>(1, onnextcalls).
+                window(10, 1).
+                merge().
+                subscribe([&c](int){++c;});
+            auto finish = clock::now();
+            auto msElapsed = duration_cast<milliseconds>(finish-start);
+            std::cout << "range window(10, 1) : " << c << " on_next calls, " << msElapsed.count() << "ms elapsed " << c / (msElapsed.count() / 1000.0) << " ops/sec" << std::endl;
+        }
+    }
+}
+
+SCENARIO("unicast - single subscriber", "[unicast][subjects]"){
+    GIVEN("a unicast and a finite source"){
+
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(110, 1),
+            on.next(220, 2),
+            on.next(340, 3),
+            on.next(410, 4),
+            on.completed(520)
+        });
+
+        rxsub::unicast<int> s;
+
+        auto results1 = w.make_subscriber<int>();
+
+        auto results2 = w.make_subscriber<int>();
+
+        WHEN("the unicast is subscribed once before it completes and once after"){
+
+            w.schedule_absolute(200, [&xs, &s](const rxsc::schedulable&){
+                xs.subscribe(s.get_subscriber());});
+            w.schedule_absolute(300, [&s, &results1](const rxsc::schedulable&){
+                s.get_observable().subscribe(results1);});
+            w.schedule_absolute(600, [&s, &results2](const rxsc::schedulable&){
+                s.get_observable().subscribe(results2);});
+
+            w.start();
+
+            THEN("the first subscriber gets the items after it subscribed"){
+                auto required = rxu::to_vector({
+                    on.next(340, 3),
+                    on.next(410, 4),
+                    on.completed(520)
+                });
+                auto actual = results1.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("the late subscriber gets the completion"){
+                auto required = rxu::to_vector({
+                    on.completed(600)
+                });
+                auto actual = results2.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("unicast - more than one subscriber", "[unicast][subjects]"){
+    GIVEN("a unicast and an infinite source"){
+
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+        const rxsc::test::messages<bool> check;
+
+        auto xs = sc.make_hot_observable({
+            on.next(220, 3),
+            on.next(270, 4),
+            on.next(340, 5),
+            on.next(410, 6),
+            on.next(520, 7),
+            on.next(630, 8),
+            on.next(710, 9),
+            on.next(870, 10),
+            on.next(940, 11),
+            on.next(1020, 12)
+        });
+
+        rxsub::unicast<int> s;
+
+        auto results1 = w.make_subscriber<int>();
+
+        auto results2 = w.make_subscriber<int>();
+
+        auto results3 = w.make_subscriber<int>();
+
+        WHEN("the unicast is subscribed by three observers"){
+
+            auto checks = rxu::to_vector({
+                check.next(0, false)
+            });
+            checks.clear();
+
+            auto record = [&s, &check, &checks](long at) -> void {
+                checks.push_back(check.next(at, s.has_observers()));
+            };
+
+            auto o = s.get_subscriber();
+
+            w.schedule_absolute(200, [&xs, &o, &record](const rxsc::schedulable&){
+                xs.subscribe(o); record(200);});
+            w.schedule_absolute(1000, [&o, &record](const rxsc::schedulable&){
+                o.unsubscribe(); record(1000);});
+
+            w.schedule_absolute(300, [&s, &results1, &record](const rxsc::schedulable&){
+                s.get_observable().subscribe(results1); record(300);});
+            w.schedule_absolute(400, [&s, &results2, &record](const rxsc::schedulable&){
+                s.get_observable().subscribe(results2); record(400);});
+            w.schedule_absolute(900, [&s, &results3, &record](const rxsc::schedulable&){
+                s.get_observable().subscribe(results3); record(900);});
+
+            w.schedule_absolute(600, [&results1, &record](const rxsc::schedulable&){
+                results1.unsubscribe(); record(600);});
+            w.schedule_absolute(700, [&results2, &record](const rxsc::schedulable&){
+                results2.unsubscribe(); record(700);});
+            w.schedule_absolute(950, [&results3, &record](const rxsc::schedulable&){
+                results3.unsubscribe(); record(950);});
+
+            w.start();
+
+            THEN("result1 contains expected messages"){
+                auto required = rxu::to_vector({
+                    on.next(340, 5),
+                    on.next(410, 6),
+                    on.next(520, 7)
+                });
+                auto actual = results1.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("result2 contains expected messages"){
+                auto required = rxu::to_vector({
+                    on.next(410, 6),
+                    on.next(520, 7),
+                    on.next(630, 8)
+                });
+                auto actual = results2.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("result3 contains expected messages"){
+                auto required = rxu::to_vector({
+                    on.next(940, 11)
+                });
+                auto actual = results3.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("checks contains expected messages"){
+                auto required = rxu::to_vector({
+                    check.next(200, false),
+                    check.next(300, true),
+                    check.next(400, true),
+                    check.next(600, true),
+                    check.next(700, false),
+                    check.next(900, true),
+                    check.next(950, false),
+                    check.next(1000, false)
+                });
+                REQUIRE(required == checks);
+            }
+        }
+    }
+}
+
+SCENARIO("unicast - on_error in source", "[unicast][subjects]"){
+    GIVEN("a unicast and a source with an error"){
+
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        std::runtime_error ex("unicast on_error in stream");
+
+        auto xs = sc.make_hot_observable({
+            on.next(220, 3),
+            on.next(340, 5),
+            on.error(410, ex)
+        });
+
+        rxsub::unicast<int> s;
+
+        auto results1 = w.make_subscriber<int>();
+
+        auto results2 = w.make_subscriber<int>();
+
+        WHEN("the unicast is subscribed before and after the error"){
+
+            w.schedule_absolute(200, [&xs, &s](const rxsc::schedulable&){
+                xs.subscribe(s.get_subscriber());});
+            w.schedule_absolute(300, [&s, &results1](const rxsc::schedulable&){
+                s.get_observable().subscribe(results1);});
+            w.schedule_absolute(500, [&s, &results2](const rxsc::schedulable&){
+                s.get_observable().subscribe(results2);});
+
+            w.start();
+
+            THEN("result1 contains expected messages"){
+                auto required = rxu::to_vector({
+                    on.next(340, 5),
+                    on.error(410, ex)
+                });
+                auto actual = results1.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("result2 contains expected messages"){
+                auto required = rxu::to_vector({
+                    on.error(500, ex)
+                });
+                auto actual = results2.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
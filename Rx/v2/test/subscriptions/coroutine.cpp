@@ -1,8 +1,12 @@
 #include "../test.h"
 
+#include <rxcpp/operators/rx-take.hpp>
+#include <rxcpp/operators/rx-reduce.hpp>
 #include <rxcpp/rx-coroutine.hpp>
 
-#ifdef _RESUMABLE_FUNCTIONS_SUPPORTED
+#if RXCPP_USE_COROUTINES
+
+namespace rxcr = rxcpp::coroutine;
 
 SCENARIO("coroutine completes", "[coroutine]"){
     GIVEN("a source") {
@@ -17,30 +21,34 @@ SCENARIO("coroutine completes", "[coroutine]"){
             on.completed(350)
         });
 
-        WHEN("for co_await"){
+        WHEN("each value is awaited"){
 
             std::vector<typename rxsc::test::messages<int>::recorded_type> messages;
 
             w.advance_to(rxsc::test::subscribed_time);
 
-            auto d = [&]() -> std::future<void> {
+            auto d = rxcr::from_task([&]() -> rxcr::task<bool> {
+                auto values = rxcr::values(xs | rxo::as_dynamic());
                 RXCPP_TRY {
-                    for co_await (auto n : xs | rxo::as_dynamic()) {
-                        messages.push_back(on.next(w.clock(), n));
+                    for (auto n = co_await values.next(); !n.empty(); n = co_await values.next()) {
+                        messages.push_back(on.next(w.clock(), n.get()));
                     }
                     messages.push_back(on.completed(w.clock()));
                 } RXCPP_CATCH(...) {
                     messages.push_back(on.error(w.clock(), rxu::current_exception()));
                 }
-            }();
+                co_return true;
+            });
+            bool finished = false;
+            d.subscribe([&](bool){finished = true;});
 
             w.advance_to(rxsc::test::unsubscribed_time);
 
             THEN("the function completed"){
-                REQUIRE(d.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+                REQUIRE(finished);
             }
 
-            THEN("the output only contains true"){
+            THEN("the output contains the values and the completion"){
                 auto required = rxu::to_vector({
                     on.next(210, 2),
                     on.next(310, 10),
@@ -78,30 +86,34 @@ SCENARIO("coroutine errors", "[coroutine]"){
             on.completed(350)
         });
 
-        WHEN("for co_await"){
+        WHEN("each value is awaited"){
 
             std::vector<typename rxsc::test::messages<int>::recorded_type> messages;
 
             w.advance_to(rxsc::test::subscribed_time);
 
-            auto d = [&]() -> std::future<void> {
+            auto d = rxcr::from_task([&]() -> rxcr::task<bool> {
+                auto values = rxcr::values(xs | rxo::as_dynamic());
                 RXCPP_TRY {
-                    for co_await (auto n : xs | rxo::as_dynamic()) {
-                        messages.push_back(on.next(w.clock(), n));
+                    for (auto n = co_await values.next(); !n.empty(); n = co_await values.next()) {
+                        messages.push_back(on.next(w.clock(), n.get()));
                     }
                     messages.push_back(on.completed(w.clock()));
                 } RXCPP_CATCH(...) {
                     messages.push_back(on.error(w.clock(), rxu::current_exception()));
                 }
-            }();
+                co_return true;
+            });
+            bool finished = false;
+            d.subscribe([&](bool){finished = true;});
 
             w.advance_to(rxsc::test::unsubscribed_time);
 
             THEN("the function completed"){
-                REQUIRE(d.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+                REQUIRE(finished);
             }
 
-            THEN("the output only contains true"){
+            THEN("the output contains the value and the error"){
                 auto required = rxu::to_vector({
                     on.next(210, 2),
                     on.error(310, ex)
@@ -122,4 +134,173 @@ SCENARIO("coroutine errors", "[coroutine]"){
     }
 }
 
+SCENARIO("coroutine task awaits a task and a completion", "[coroutine]"){
+    GIVEN("a task that sums a range"){
+        auto sum = []() -> rxcr::task<int> {
+            auto last = co_await rxcr::completion(rxs::range(1, 4).sum());
+            co_return last.get();
+        };
+
+        WHEN("the task is awaited by another task"){
+            auto outer = rxcr::from_task([=]() -> rxcr::task<int> {
+                auto inner = co_await sum();
+                co_return inner * 10;
+            });
+            int result = 0;
+            bool completed = false;
+            outer.subscribe(
+                [&](int v){result = v;},
+                [&](){completed = true;});
+
+            THEN("the result of both tasks was emitted"){
+                REQUIRE(result == 100);
+                REQUIRE(completed);
+            }
+        }
+    }
+    GIVEN("a task that throws"){
+        auto failed = rxcr::from_task([]() -> rxcr::task<int> {
+            co_await rxcr::completion(rxs::range(1, 2));
+            rxu::throw_exception(std::runtime_error("stopped by error"));
+            co_return 0;
+        });
+
+        WHEN("the observable is subscribed"){
+            bool errored = false;
+            failed.subscribe(
+                [](int){},
+                [&](rxu::error_ptr){errored = true;});
+
+            THEN("the error was emitted"){
+                REQUIRE(errored);
+            }
+        }
+    }
+}
+
+SCENARIO("coroutine generator stops when unsubscribed", "[coroutine]"){
+    GIVEN("an infinite generator"){
+        struct destroyed_flag
+        {
+            explicit destroyed_flag(bool* f) : flag(f) {}
+            ~destroyed_flag() {*flag = true;}
+            bool* flag;
+        };
+        bool destroyed = false;
+        auto naturals = rxcr::from_generator([&]() -> rxcr::generator<int> {
+            destroyed_flag guard(&destroyed);
+            for (int i = 0;; ++i) {
+                co_yield i;
+            }
+        });
+
+        WHEN("3 values are taken"){
+            std::vector<int> values;
+            naturals.take(3).subscribe([&](int v){values.push_back(v);});
+
+            THEN("the values were emitted"){
+                REQUIRE(values == std::vector<int>({0, 1, 2}));
+            }
+            THEN("the generator frame was destroyed"){
+                REQUIRE(destroyed);
+            }
+        }
+    }
+}
+
+SCENARIO("coroutine generator hops to a worker", "[coroutine]"){
+    GIVEN("a generator that awaits a new thread"){
+        auto worker = rxsc::make_new_thread().create_worker();
+        auto caller = std::this_thread::get_id();
+        auto ids = rxcr::from_generator([=]() -> rxcr::generator<std::thread::id> {
+            co_yield std::this_thread::get_id();
+            co_await worker;
+            co_yield std::this_thread::get_id();
+        });
+
+        WHEN("the values are collected"){
+            std::vector<std::thread::id> values;
+            ids.as_blocking().subscribe([&](std::thread::id id){values.push_back(id);});
+            worker.unsubscribe();
+
+            THEN("the second value was emitted from the worker thread"){
+                REQUIRE(values.size() == 2);
+                REQUIRE(values[0] == caller);
+                REQUIRE(values[1] != caller);
+            }
+        }
+    }
+}
+
+namespace {
+
+struct counting_resource : public std::pmr::memory_resource
+{
+    int allocations = 0;
+    int deallocations = 0;
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        ++deallocations;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& o) const noexcept override {
+        return this == &o;
+    }
+};
+
+}
+
+SCENARIO("coroutine frames use the frame_resource", "[coroutine]"){
+    GIVEN("a task that awaits another task"){
+        auto doubled = [](int v) -> rxcr::task<int> {
+            co_return v * 2;
+        };
+        auto outer = rxcr::from_task([=]() -> rxcr::task<int> {
+            auto v = co_await doubled(21);
+            co_return v;
+        });
+
+        WHEN("the task is run with a frame_resource"){
+            counting_resource resource;
+            int result = 0;
+            {
+                rxcr::frame_resource scope(&resource);
+                outer.subscribe([&](int v){result = v;});
+            }
+
+            THEN("the frames were allocated and freed by the resource"){
+                REQUIRE(result == 42);
+                // the outer task, the inner task and the frame that runs the outer task
+                REQUIRE(resource.allocations == 3);
+                REQUIRE(resource.deallocations == 3);
+            }
+        }
+    }
+}
+
+SCENARIO("coroutine generator", "[!hide][coroutine][perf]"){
+    const int static onnextcalls = 10000000;
+    GIVEN("a generator of ints"){
+        WHEN("the values are counted"){
+            using namespace std::chrono;
+            typedef steady_clock clock;
+
+            auto start = clock::now();
+            int count = 0;
+            rxcr::from_generator([]() -> rxcr::generator<int> {
+                for (int i = 0; i != onnextcalls; ++i) {
+                    co_yield i;
+                }
+            }).subscribe([&](int){++count;});
+            auto finish = clock::now();
+            auto msElapsed = duration_cast<milliseconds>(finish-start);
+            std::cout << "coroutine generator : " << count << " values, " << msElapsed.count() << "ms elapsed " << std::endl;
+        }
+    }
+}
+
 #endif
@@ -229,3 +229,104 @@ SCENARIO("subscriber does only 1 move", "[observer][copies]"){
         }
     }
 }
+
+SCENARIO("dynamic observer storage", "[observer][dynamic]"){
+    GIVEN("a dynamic observer of a small observer"){
+        int result = 0;
+        auto obs = rx::make_observer_dynamic<int>([&result](int i){result += i;});
+        WHEN("copied and called"){
+            auto copy = obs;
+            rx::observer<int> moved(std::move(copy));
+            obs.on_next(1);
+            moved.on_next(2);
+            THEN("both copies call the observer"){
+                REQUIRE(result == 3);
+            }
+        }
+    }
+    GIVEN("a dynamic observer of an observer that does not fit inline"){
+        std::array<int, 64> values;
+        values.fill(1);
+        int result = 0;
+        auto obs = rx::make_observer_dynamic<int>([values, &result](int i){result += i * values[63];});
+        WHEN("copied and called"){
+            auto copy = obs;
+            obs.on_next(1);
+            copy.on_next(2);
+            THEN("both copies call the observer"){
+                REQUIRE(result == 3);
+            }
+        }
+    }
+    GIVEN("an empty dynamic observer"){
+        rx::observer<int> obs;
+        WHEN("called"){
+            obs.on_next(1);
+            obs.on_completed();
+            THEN("nothing happens"){
+                REQUIRE(true);
+            }
+        }
+    }
+}
+
+SCENARIO("dynamic observable equality", "[observer][dynamic]"){
+    GIVEN("a small source that is erased by as_dynamic"){
+        auto source = rxs::just(1).as_dynamic();
+        WHEN("copied and moved"){
+            auto copy = source;
+            auto moved = std::move(copy);
+            THEN("the copies compare equal"){
+                REQUIRE(source == moved);
+                REQUIRE(!(source != moved));
+            }
+        }
+        WHEN("erased again"){
+            auto other = rxs::just(1).as_dynamic();
+            THEN("the sources compare unequal"){
+                REQUIRE(source != other);
+            }
+        }
+    }
+}
+
+SCENARIO("as_dynamic range", "[!hide][observer][dynamic][perf]"){
+    const int values = 10000000;
+    GIVEN("a range that is erased by as_dynamic"){
+        WHEN("the values are counted"){
+            using namespace std::chrono;
+            typedef steady_clock clock;
+
+            long long c = 0;
+            auto start = clock::now();
+            rxs::range(1, values)
+                .as_dynamic()
+                .subscribe([&](int){++c;});
+            auto msElapsed = duration_cast<milliseconds>(clock::now() - start);
+            std::cout << "as_dynamic range : " << values << " values, " << msElapsed.count() << "ms elapsed, "
+                      << (values * 1000.0 / std::max<long long>(msElapsed.count(), 1)) << " values/s" << std::endl;
+            REQUIRE(c == values);
+        }
+    }
+}
+
+SCENARIO("as_dynamic subscribe", "[!hide][observer][dynamic][perf]"){
+    const int subscriptions = 1000000;
+    GIVEN("a source that is erased by as_dynamic"){
+        WHEN("subscribed many times"){
+            using namespace std::chrono;
+            typedef steady_clock clock;
+
+            long long c = 0;
+            auto source = rxs::just(1).as_dynamic();
+            auto start = clock::now();
+            for (int i = 0; i != subscriptions; ++i) {
+                source.subscribe([&](int){++c;});
+            }
+            auto msElapsed = duration_cast<milliseconds>(clock::now() - start);
+            std::cout << "as_dynamic subscribe : " << subscriptions << " subscriptions, " << msElapsed.count() << "ms elapsed, "
+                      << (subscriptions * 1000.0 / std::max<long long>(msElapsed.count(), 1)) << " subscriptions/s" << std::endl;
+            REQUIRE(c == subscriptions);
+        }
+    }
+}
@@ -1,5 +1,7 @@
 #include "../test.h"
 #include "rxcpp/operators/rx-combine_latest.hpp"
+#include "rxcpp/operators/rx-filter.hpp"
+#include "rxcpp/operators/rx-flat_map.hpp"
 #include "rxcpp/operators/rx-map.hpp"
 #include "rxcpp/operators/rx-take.hpp"
 #include "rxcpp/operators/rx-observe_on.hpp"
@@ -8,6 +10,8 @@
 
 #include <sstream>
 
+#include "subscription_churn.h"
+
 SCENARIO("observe subscription", "[!hide]"){
     GIVEN("observable of ints"){
         WHEN("subscribe"){
@@ -459,3 +463,216 @@ SCENARIO("subscription composite", "[subscription]"){
     }
 }
 
+
+SCENARIO("thread_cache_allocator reuses blocks", "[subscription][allocator]"){
+    GIVEN("a thread_cache_allocator"){
+        rxu::thread_cache_allocator<std::array<char, 40>> a;
+        WHEN("a block is freed and another of the same size is allocated"){
+            auto first = a.allocate(1);
+            a.deallocate(first, 1);
+            auto second = a.allocate(1);
+            THEN("the freed block was reused"){
+                REQUIRE(first == second);
+            }
+            a.deallocate(second, 1);
+        }
+        WHEN("a block of another size class is allocated after a free"){
+            auto first = a.allocate(1);
+            a.deallocate(first, 1);
+            rxu::thread_cache_allocator<std::array<char, 100>> other(a);
+            auto second = other.allocate(1);
+            THEN("the freed block was not reused"){
+                REQUIRE(static_cast<void*>(first) != static_cast<void*>(second));
+            }
+            other.deallocate(second, 1);
+        }
+        WHEN("a block larger than the cached sizes is allocated"){
+            rxu::thread_cache_allocator<std::array<char, 4096>> large(a);
+            auto block = large.allocate(1);
+            (*block)[4095] = 'x';
+            THEN("the block is usable"){
+                REQUIRE((*block)[4095] == 'x');
+            }
+            large.deallocate(block, 1);
+        }
+        WHEN("a block is freed on another thread"){
+            auto block = a.allocate(1);
+            std::thread([=]() mutable {
+                rxu::thread_cache_allocator<std::array<char, 40>> b;
+                b.deallocate(block, 1);
+            }).join();
+            THEN("the block was released by the other thread"){
+                auto next = a.allocate(1);
+                REQUIRE(next != nullptr);
+                a.deallocate(next, 1);
+            }
+        }
+    }
+    GIVEN("a shared_ptr allocated with a thread_cache_allocator"){
+        auto p = std::allocate_shared<std::string>(rxu::thread_cache_allocator<std::string>(), "state");
+        WHEN("the value is read"){
+            THEN("the value was constructed"){
+                REQUIRE(*p == "state");
+            }
+        }
+    }
+}
+
+namespace {
+
+template<class Allocator>
+long long allocate_shared_churn(int threads, int iterations) {
+    using namespace std::chrono;
+    auto start = steady_clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t != threads; ++t) {
+        workers.emplace_back([=](){
+            std::vector<std::shared_ptr<rx::composite_subscription>> live(16);
+            for (int i = 0; i != iterations; ++i) {
+                live[i % live.size()] = std::allocate_shared<rx::composite_subscription>(Allocator());
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    return duration_cast<milliseconds>(steady_clock::now() - start).count();
+}
+
+}
+
+SCENARIO("allocate_shared churn", "[!hide][subscription][allocator][perf]"){
+    const int threads = 4;
+    const int iterations = 2000000;
+    GIVEN("threads that allocate and free shared state"){
+        WHEN("std::allocator is used"){
+            auto msElapsed = allocate_shared_churn<std::allocator<rx::composite_subscription>>(threads, iterations);
+            std::cout << "allocate_shared churn std::allocator : " << threads << " threads, " << iterations << " allocations each, " << msElapsed << "ms elapsed " << std::endl;
+        }
+        WHEN("thread_cache_allocator is used"){
+            auto msElapsed = allocate_shared_churn<rxu::thread_cache_allocator<rx::composite_subscription>>(threads, iterations);
+            std::cout << "allocate_shared churn thread_cache_allocator : " << threads << " threads, " << iterations << " allocations each, " << msElapsed << "ms elapsed " << std::endl;
+        }
+    }
+}
+
+SCENARIO("subscribe and unsubscribe churn", "[!hide][subscription][allocator][perf]"){
+    const int threads = 4;
+    const int subscriptions = 200000;
+    GIVEN("threads that each subscribe to a short pipeline"){
+        WHEN("the pipelines are subscribed and unsubscribed"){
+            subscribe_unsubscribe_churn("std::allocator", threads, subscriptions);
+        }
+    }
+}
+
+namespace {
+
+template<class RefCount>
+struct counted_state : public rxu::intrusive_ref_counted<RefCount>
+{
+    counted_state(int& released, int& destroyed)
+        : released(released)
+        , destroyed(destroyed)
+    {
+    }
+    ~counted_state()
+    {
+        ++destroyed;
+    }
+    virtual void release() {
+        ++released;
+    }
+    int& released;
+    int& destroyed;
+};
+
+}
+
+SCENARIO("intrusive_ptr shares state", "[subscription][intrusive_ptr]"){
+    GIVEN("an intrusive_ptr and an intrusive_weak_ptr"){
+        int released = 0;
+        int destroyed = 0;
+        auto strong = rxu::make_intrusive_state<counted_state<rxu::atomic_ref_count>>(released, destroyed);
+        rxu::intrusive_weak_ptr<counted_state<rxu::atomic_ref_count>> weak = strong;
+        WHEN("the strong reference is copied"){
+            auto copy = strong;
+            strong.reset();
+            THEN("the state is kept by the copy"){
+                REQUIRE(released == 0);
+                REQUIRE(!weak.expired());
+                REQUIRE(weak.lock() == copy);
+            }
+        }
+        WHEN("the last strong reference is released"){
+            strong.reset();
+            THEN("the state is released but not destroyed"){
+                REQUIRE(released == 1);
+                REQUIRE(destroyed == 0);
+                REQUIRE(weak.expired());
+                REQUIRE(!weak.lock());
+            }
+            weak.reset();
+            THEN("the state is destroyed with the last weak reference"){
+                REQUIRE(released == 1);
+                REQUIRE(destroyed == 1);
+            }
+        }
+    }
+    GIVEN("state with local reference counts"){
+        int released = 0;
+        int destroyed = 0;
+        auto strong = rxu::make_intrusive_state<counted_state<rxu::local_ref_count>>(released, destroyed);
+        rxu::intrusive_weak_ptr<counted_state<rxu::local_ref_count>> weak = strong;
+        WHEN("the strong and weak references are released"){
+            auto copy = strong;
+            strong.reset();
+            REQUIRE(released == 0);
+            copy.reset();
+            REQUIRE(released == 1);
+            REQUIRE(weak.expired());
+            weak.reset();
+            THEN("the state is destroyed once"){
+                REQUIRE(released == 1);
+                REQUIRE(destroyed == 1);
+            }
+        }
+    }
+    GIVEN("a subscription that is only weakly referenced"){
+        rx::composite_subscription cs;
+        auto w = cs.add(rx::make_subscription([](){}));
+        WHEN("the composite_subscription is cleared"){
+            cs.clear();
+            THEN("the weak subscription has expired"){
+                REQUIRE(rx::subscription::maybe_lock(w).empty());
+            }
+        }
+    }
+}
+
+SCENARIO("five operator chain", "[!hide][subscription][intrusive_ptr][perf]"){
+    const int values = 1000000;
+    GIVEN("a range through five operators"){
+        WHEN("the values are counted"){
+            using namespace std::chrono;
+            typedef steady_clock clock;
+
+            // libstdc++ uses plain counts for std::shared_ptr until a thread is started
+            std::thread([](){}).join();
+
+            long long c = 0;
+            auto start = clock::now();
+            rxs::range(1, values)
+                .map([](int v){return v + 1;})
+                .filter([](int v){return v % 2 == 0;})
+                .map([](int v){return v / 2;})
+                .flat_map([](int v){return rxs::just(v);})
+                .map([](int v){return v * 3;})
+                .subscribe([&](int){++c;});
+            auto msElapsed = duration_cast<milliseconds>(clock::now() - start);
+            std::cout << "five operator chain : " << values << " values, " << msElapsed.count() << "ms elapsed, "
+                      << (values * 1000.0 / std::max<long long>(msElapsed.count(), 1)) << " values/s" << std::endl;
+            REQUIRE(c == values / 2);
+        }
+    }
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+// subscribes and unsubscribes a short pipeline on several threads and reports
+// subscriptions/s. included by subscription.cpp, which uses the default state
+// allocator, and by subscription_thread_cache.cpp, which builds with
+// RXCPP_STATE_ALLOCATOR defined to rxcpp::util::thread_cache_allocator.
+
+inline void subscribe_unsubscribe_churn(const char* allocator, int threads, int subscriptions)
+{
+    using namespace std::chrono;
+    typedef steady_clock clock;
+
+    std::atomic<long> values(0);
+    auto start = clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t != threads; ++t) {
+        workers.emplace_back([&](){
+            for (int i = 0; i != subscriptions; ++i) {
+                rx::composite_subscription cs;
+                rxs::just(i)
+                    .map([](int v){return v + 1;})
+                    .take(1)
+                    .subscribe(cs, [&](int){++values;});
+                cs.unsubscribe();
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    auto msElapsed = duration_cast<milliseconds>(clock::now() - start);
+    auto total = threads * subscriptions;
+    std::cout << "subscribe and unsubscribe churn " << allocator << " : " << total << " subscriptions, " << msElapsed.count() << "ms elapsed, "
+              << (total * 1000.0 / std::max<long long>(msElapsed.count(), 1)) << " subscriptions/s" << std::endl;
+    REQUIRE(values == total);
+}
@@ -0,0 +1,37 @@
+// the state allocator must be the same in every translation unit of a program,
+// so this file is built as its own test program and not into rxcppv2_test.
+#define RXCPP_STATE_ALLOCATOR rxcpp::util::thread_cache_allocator
+
+#include "../test.h"
+#include "rxcpp/operators/rx-map.hpp"
+#include "rxcpp/operators/rx-take.hpp"
+
+#include "subscription_churn.h"
+
+SCENARIO("state is allocated with the thread_cache_allocator", "[subscription][allocator]"){
+    GIVEN("RXCPP_STATE_ALLOCATOR defined to thread_cache_allocator"){
+        WHEN("a pipeline is subscribed"){
+            int value = 0;
+            rx::composite_subscription cs;
+            rxs::just(1)
+                .map([](int v){return v + 1;})
+                .subscribe(cs, [&](int v){value = v;});
+            THEN("the state allocator is the thread_cache_allocator"){
+                static_assert(std::is_same<rxu::state_allocator<int>, rxu::thread_cache_allocator<int>>::value,
+                    "RXCPP_STATE_ALLOCATOR was not applied");
+                REQUIRE(value == 2);
+                REQUIRE(!cs.is_subscribed());
+            }
+        }
+    }
+}
+
+SCENARIO("subscribe and unsubscribe churn with thread_cache_allocator", "[!hide][subscription][allocator][perf]"){
+    const int threads = 4;
+    const int subscriptions = 200000;
+    GIVEN("threads that each subscribe to a short pipeline"){
+        WHEN("the pipelines are subscribed and unsubscribed"){
+            subscribe_unsubscribe_churn("thread_cache_allocator", threads, subscriptions);
+        }
+    }
+}
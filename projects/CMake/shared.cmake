@@ -43,12 +43,6 @@ elseif (CMAKE_CXX_COMPILER_ID MATCHES "GNU")
         MESSAGE( STATUS "no exceptions" )
         list(APPEND RX_COMPILE_OPTIONS /EHs-c-)
     endif()
-    if (NOT CMAKE_CXX_COMPILER_VERSION VERSION_LESS "19.0.23506.0")
-        MESSAGE( STATUS "with coroutines" )
-        list(APPEND RX_COMPILE_OPTIONS
-            /await # enable coroutines
-            )
-    endif()
 endif()
 
 set(RX_COMPILE_FEATURES cxx_std_14)